@@ -0,0 +1,175 @@
+/***************************************************************************
+ * @file    Clock.c
+ * @brief   Quản lý clock ngoại vi (RCC) dùng chung cho Port, Pwm, Dio
+ * @details Bảng vị trí bit RCC của từng clock, đếm tham chiếu, gom thay đổi
+ *          theo pha và tắt các clock không dùng.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Clock.h"
+#include "stm32f10x.h"
+#include "stm32f10x_rcc.h"
+
+/// @name Các thanh ghi ENR của RCC
+/// @{
+#define CLOCK_BUS_AHB       0u
+#define CLOCK_BUS_APB1      1u
+#define CLOCK_BUS_APB2      2u
+#define CLOCK_NUM_BUSES     3u
+/// @}
+
+// Vị trí bit của một clock và cho phép Clock_GateUnused tắt hay không
+typedef struct
+{
+    uint32 bit;
+    uint8 bus;
+    uint8 gateable;
+} Clock_EntryType;
+
+static const Clock_EntryType Clock_Table[CLOCK_NUM_IDS] = {
+    [CLOCK_GPIOA] = { RCC_APB2Periph_GPIOA, CLOCK_BUS_APB2, 1u },
+    [CLOCK_GPIOB] = { RCC_APB2Periph_GPIOB, CLOCK_BUS_APB2, 1u },
+    [CLOCK_GPIOC] = { RCC_APB2Periph_GPIOC, CLOCK_BUS_APB2, 1u },
+    [CLOCK_GPIOD] = { RCC_APB2Periph_GPIOD, CLOCK_BUS_APB2, 1u },
+    [CLOCK_AFIO]  = { RCC_APB2Periph_AFIO,  CLOCK_BUS_APB2, 0u },
+    [CLOCK_ADC1]  = { RCC_APB2Periph_ADC1,  CLOCK_BUS_APB2, 0u },   // Driver ADC chưa dùng Clock_Request
+    [CLOCK_TIM1]  = { RCC_APB2Periph_TIM1,  CLOCK_BUS_APB2, 1u },
+    [CLOCK_TIM2]  = { RCC_APB1Periph_TIM2,  CLOCK_BUS_APB1, 1u },
+    [CLOCK_TIM3]  = { RCC_APB1Periph_TIM3,  CLOCK_BUS_APB1, 1u },
+    [CLOCK_TIM4]  = { RCC_APB1Periph_TIM4,  CLOCK_BUS_APB1, 1u },
+    [CLOCK_DMA1]  = { RCC_AHBPeriph_DMA1,   CLOCK_BUS_AHB,  0u },
+};
+
+// Số người dùng của từng clock
+static uint8 Clock_RefCount[CLOCK_NUM_IDS];
+
+// Bit chờ bật/tắt của từng thanh ghi ENR trong pha hiện tại
+static uint32 Clock_PendingOn[CLOCK_NUM_BUSES];
+static uint32 Clock_PendingOff[CLOCK_NUM_BUSES];
+
+// Độ sâu lồng của Clock_BeginPhase
+static uint8 Clock_PhaseDepth = 0;
+
+/**
+ * @brief Địa chỉ thanh ghi ENR của một bus
+ */
+static volatile uint32* Clock_BusReg(uint8 bus)
+{
+    if (bus == CLOCK_BUS_AHB)  return &RCC->AHBENR;
+    if (bus == CLOCK_BUS_APB1) return &RCC->APB1ENR;
+    return &RCC->APB2ENR;
+}
+
+/**
+ * @brief Ghi các thay đổi đang chờ: một lần đọc-sửa-ghi cho mỗi thanh ghi
+ * @note  Gọi trong critical section
+ */
+static void Clock_Flush(void)
+{
+    for (uint8 bus = 0; bus < CLOCK_NUM_BUSES; bus++)
+    {
+        uint32 on = Clock_PendingOn[bus];
+        uint32 off = Clock_PendingOff[bus];
+        volatile uint32 *reg;
+
+        if ((on | off) == 0u) continue;
+
+        reg = Clock_BusReg(bus);
+        *reg = (*reg | on) & ~off;
+        // Đọc lại để lệnh ghi hoàn tất trước khi driver truy cập ngoại vi
+        (void)*reg;
+
+        Clock_PendingOn[bus] = 0u;
+        Clock_PendingOff[bus] = 0u;
+    }
+}
+
+Std_ReturnType Clock_Request(Clock_IdType Id)
+{
+    uint32 primask;
+
+    if ((uint32)Id >= CLOCK_NUM_IDS) return E_NOT_OK;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (Clock_RefCount[Id] == 0xFFu)
+    {
+        __set_PRIMASK(primask);
+        return E_NOT_OK;
+    }
+
+    if (Clock_RefCount[Id]++ == 0u)
+    {
+        Clock_PendingOn[Clock_Table[Id].bus]  |= Clock_Table[Id].bit;
+        Clock_PendingOff[Clock_Table[Id].bus] &= ~Clock_Table[Id].bit;
+        if (Clock_PhaseDepth == 0u) Clock_Flush();
+    }
+
+    __set_PRIMASK(primask);
+    return E_OK;
+}
+
+Std_ReturnType Clock_Release(Clock_IdType Id)
+{
+    uint32 primask;
+
+    if ((uint32)Id >= CLOCK_NUM_IDS) return E_NOT_OK;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (Clock_RefCount[Id] == 0u)
+    {
+        __set_PRIMASK(primask);
+        return E_NOT_OK;
+    }
+
+    if (--Clock_RefCount[Id] == 0u)
+    {
+        Clock_PendingOff[Clock_Table[Id].bus] |= Clock_Table[Id].bit;
+        Clock_PendingOn[Clock_Table[Id].bus]  &= ~Clock_Table[Id].bit;
+        if (Clock_PhaseDepth == 0u) Clock_Flush();
+    }
+
+    __set_PRIMASK(primask);
+    return E_OK;
+}
+
+void Clock_BeginPhase(void)
+{
+    uint32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    Clock_PhaseDepth++;
+    __set_PRIMASK(primask);
+}
+
+void Clock_EndPhase(void)
+{
+    uint32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (Clock_PhaseDepth != 0u && --Clock_PhaseDepth == 0u) Clock_Flush();
+    __set_PRIMASK(primask);
+}
+
+void Clock_GateUnused(uint32 Ids)
+{
+    uint32 primask = __get_PRIMASK();
+
+    __disable_irq();
+    for (uint8 id = 0; id < CLOCK_NUM_IDS; id++)
+    {
+        if (Clock_Table[id].gateable && (Ids & CLOCK_MASK(id)) && Clock_RefCount[id] == 0u)
+            Clock_PendingOff[Clock_Table[id].bus] |= Clock_Table[id].bit;
+    }
+    if (Clock_PhaseDepth == 0u) Clock_Flush();
+    __set_PRIMASK(primask);
+}
+
+uint8 Clock_GetRefCount(Clock_IdType Id)
+{
+    if ((uint32)Id >= CLOCK_NUM_IDS) return 0u;
+    return Clock_RefCount[Id];
+}
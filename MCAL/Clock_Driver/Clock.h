@@ -0,0 +1,100 @@
+/***************************************************************************
+ * @file    Clock.h
+ * @brief   Quản lý clock ngoại vi (RCC) dùng chung cho Port, Pwm, Dio
+ * @details Mỗi driver xin/trả clock qua Clock_Request/Clock_Release, module
+ *          đếm số tham chiếu cho từng clock: clock chỉ bật khi có người dùng
+ *          đầu tiên và chỉ tắt khi người dùng cuối cùng trả lại.
+ *          Trong một pha khởi tạo (Clock_BeginPhase ... Clock_EndPhase) các
+ *          thay đổi được gom lại và ghi một lần cho mỗi thanh ghi
+ *          AHBENR/APB1ENR/APB2ENR.
+ *
+ *          Các lưu ý về thứ tự:
+ *          - Sau khi bật clock, module đọc lại thanh ghi ENR trước khi trả về
+ *            (đảm bảo lệnh ghi đã qua bus) nên driver có thể truy cập thanh
+ *            ghi ngoại vi ngay sau Clock_Request/Clock_EndPhase. Trong một pha
+ *            chưa kết thúc, clock CHƯA được bật: không truy cập ngoại vi
+ *            trước Clock_EndPhase.
+ *          - Dừng ngoại vi (tắt timer, kênh DMA, xóa cờ) trước khi
+ *            Clock_Release: khi mất clock, thanh ghi không ghi được nữa và
+ *            output của timer bị giữ nguyên ở mức hiện tại.
+ *          - AFIO phải có clock trước khi ghi AFIO->EXTICR/MAPR.
+ *          - Clock của GPIO bị tắt thì chân vẫn giữ cấu hình và mức output,
+ *            chỉ không đọc/ghi được thanh ghi; chỉ nên gate port không dùng.
+ *          - Các hàm dùng critical section (PRIMASK) nên gọi được từ ISR.
+ *            Code ngoài module không được ghi trực tiếp các clock do module
+ *            quản lý, nếu không số tham chiếu sẽ sai.
+ * @version 1.0
+ ***************************************************************************/
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "Std_Type.h"
+
+/// @brief Các clock ngoại vi được quản lý (GPIOA..GPIOD liên tiếp theo PortId)
+typedef enum {
+    CLOCK_GPIOA = 0,    ///< APB2 IOPA
+    CLOCK_GPIOB,        ///< APB2 IOPB
+    CLOCK_GPIOC,        ///< APB2 IOPC
+    CLOCK_GPIOD,        ///< APB2 IOPD
+    CLOCK_AFIO,         ///< APB2 AFIO (EXTI, remap)
+    CLOCK_ADC1,         ///< APB2 ADC1
+    CLOCK_TIM1,         ///< APB2 TIM1
+    CLOCK_TIM2,         ///< APB1 TIM2
+    CLOCK_TIM3,         ///< APB1 TIM3
+    CLOCK_TIM4,         ///< APB1 TIM4
+    CLOCK_DMA1,         ///< AHB DMA1
+    CLOCK_NUM_IDS
+} Clock_IdType;
+
+/// @name Tập clock cho Clock_GateUnused
+/// @{
+#define CLOCK_MASK(Id)      (1uL << (Id))   ///< Bit của một Clock_IdType
+#define CLOCK_MASK_GPIO     (CLOCK_MASK(CLOCK_GPIOA) | CLOCK_MASK(CLOCK_GPIOB) | \
+                             CLOCK_MASK(CLOCK_GPIOC) | CLOCK_MASK(CLOCK_GPIOD))
+#define CLOCK_MASK_TIMERS   (CLOCK_MASK(CLOCK_TIM1) | CLOCK_MASK(CLOCK_TIM2) | \
+                             CLOCK_MASK(CLOCK_TIM3) | CLOCK_MASK(CLOCK_TIM4))
+/// @}
+
+/**
+ * @brief Xin một clock; bật clock nếu đây là người dùng đầu tiên
+ * @param Id Clock cần dùng
+ * @return E_NOT_OK nếu Id không hợp lệ hoặc bộ đếm tràn
+ */
+Std_ReturnType Clock_Request(Clock_IdType Id);
+
+/**
+ * @brief Trả một clock; tắt clock khi không còn người dùng
+ * @param Id Clock đã xin trước đó
+ * @return E_NOT_OK nếu Id không hợp lệ hoặc clock chưa được xin
+ */
+Std_ReturnType Clock_Release(Clock_IdType Id);
+
+/**
+ * @brief Bắt đầu một pha: các thay đổi bật/tắt được gom lại (lồng nhau được)
+ */
+void Clock_BeginPhase(void);
+
+/**
+ * @brief Kết thúc pha: ghi mỗi thanh ghi ENR có thay đổi đúng một lần
+ */
+void Clock_EndPhase(void);
+
+/**
+ * @brief Tắt các clock GPIO/timer trong Ids không có người dùng
+ * @details Gọi sau khi các driver đã khởi tạo xong, để tắt các clock do
+ *          bootloader hoặc SystemInit bật sẵn. Clock AFIO, DMA1 và ADC1
+ *          (driver ADC tự bật clock, không qua module này) không bị động tới.
+ *          Chỉ đưa vào Ids các clock mà mọi người dùng đều xin qua
+ *          Clock_Request: module Timer (Delay) tự bật clock timer của nó
+ *          nên chưa được gate CLOCK_MASK_TIMERS khi có dùng Delay.
+ * @param Ids Tập clock được phép tắt (CLOCK_MASK, CLOCK_MASK_GPIO, ...)
+ */
+void Clock_GateUnused(uint32 Ids);
+
+/**
+ * @brief Số người dùng hiện tại của một clock
+ */
+uint8 Clock_GetRefCount(Clock_IdType Id);
+
+#endif /* CLOCK_H */
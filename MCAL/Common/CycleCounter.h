@@ -0,0 +1,42 @@
+/***************************************************************************
+ * @file    CycleCounter.h
+ * @brief   Bộ đếm chu kỳ CPU (DWT CYCCNT) của Cortex-M3
+ * @details Dùng chung cho các driver MCAL để gắn timestamp và đo thời gian
+ *          thực thi (số chu kỳ clock lõi). Thanh ghi DWT được khai báo trực
+ *          tiếp vì core_cm3.h của SPL không định nghĩa khối DWT.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include "Std_Type.h"
+
+#define CYCLECOUNTER_DEMCR          (*(volatile uint32 *)0xE000EDFCu)  // CoreDebug->DEMCR
+#define CYCLECOUNTER_DWT_CTRL       (*(volatile uint32 *)0xE0001000u)  // DWT->CTRL
+#define CYCLECOUNTER_DWT_CYCCNT     (*(volatile uint32 *)0xE0001004u)  // DWT->CYCCNT
+
+#define CYCLECOUNTER_DEMCR_TRCENA   (1uL << 24)
+#define CYCLECOUNTER_CTRL_CYCCNTENA (1uL << 0)
+
+/**
+ * @brief Bật bộ đếm chu kỳ (gọi nhiều lần không ảnh hưởng)
+ */
+static inline void CycleCounter_Init(void)
+{
+    if ((CYCLECOUNTER_DWT_CTRL & CYCLECOUNTER_CTRL_CYCCNTENA) == 0u)
+    {
+        CYCLECOUNTER_DEMCR |= CYCLECOUNTER_DEMCR_TRCENA;
+        CYCLECOUNTER_DWT_CTRL |= CYCLECOUNTER_CTRL_CYCCNTENA;
+    }
+}
+
+/**
+ * @brief Đọc giá trị bộ đếm chu kỳ hiện tại (tràn sau 2^32 chu kỳ)
+ */
+static inline uint32 CycleCounter_Get(void)
+{
+    return CYCLECOUNTER_DWT_CYCCNT;
+}
+
+#endif /* CYCLE_COUNTER_H */
@@ -9,6 +9,206 @@
 #include "Dio.h"
 #include "Det.h"  // Dùng để báo lỗi DET (nếu bật)
 #include "stm32f10x.h"
+#include "CycleCounter.h"
+#include "Clock.h"
+#include "stm32f10x_rcc.h"
+#include "misc.h"
+
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+/* Ảnh shadow của một port: các bit chờ SET và chờ RESET ở lần commit tới */
+typedef struct
+{
+    uint16 setMask;
+    uint16 resetMask;
+} Dio_ShadowPortType;
+
+static Dio_ShadowPortType Dio_Shadow[DIO_NUM_PORTS];
+static Dio_WriteModeType Dio_WriteMode = DIO_WRITE_IMMEDIATE;
+
+/**
+ * @brief      Ghi các bit trong Mask vào ảnh shadow của port (chưa ra chân).
+ * @details    Lần ghi sau cùng cho mỗi bit được giữ lại; bit không nằm trong
+ *             Mask giữ nguyên trạng thái chờ trước đó.
+ */
+static void Dio_StageWrite(Dio_PortType PortId, uint16 Level, uint16 Mask)
+{
+    Dio_ShadowPortType *sh = &Dio_Shadow[PortId];
+
+    sh->setMask   = (uint16)((sh->setMask   & ~Mask) | (Level & Mask));
+    sh->resetMask = (uint16)((sh->resetMask & ~Mask) | (~Level & Mask));
+}
+#endif
+
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+/* Ảnh đầu vào chốt gần nhất và nguồn dữ liệu của các API đọc */
+static Dio_InputSnapshotType Dio_InputSnapshot;
+static Dio_ReadModeType Dio_ReadMode = DIO_READ_LIVE;
+#endif
+
+#if (DIO_STREAM_API == STD_ON)
+/* Cờ của kênh DMA dùng cho stream trong DMA1->ISR/IFCR (4 bit mỗi kênh) */
+#define DIO_STREAM_FLAG_SHIFT   ((DIO_STREAM_DMA_CHANNEL_NUM - 1u) * 4u)
+#define DIO_STREAM_FLAG_GL      (0x1uL << DIO_STREAM_FLAG_SHIFT)
+#define DIO_STREAM_FLAG_TC      (0x2uL << DIO_STREAM_FLAG_SHIFT)
+#define DIO_STREAM_FLAG_HT      (0x4uL << DIO_STREAM_FLAG_SHIFT)
+#define DIO_STREAM_FLAG_TE      (0x8uL << DIO_STREAM_FLAG_SHIFT)
+#define DIO_STREAM_FLAG_ALL     (0xFuL << DIO_STREAM_FLAG_SHIFT)
+
+static Dio_StreamModeType Dio_StreamMode = DIO_STREAM_ONE_SHOT;
+static volatile uint8 Dio_StreamActive = 0;
+static const Dio_StreamNotificationType Dio_StreamHalfCbk = DIO_STREAM_HALF_NOTIFICATION;
+static const Dio_StreamNotificationType Dio_StreamDoneCbk = DIO_STREAM_DONE_NOTIFICATION;
+
+/**
+ * @brief      Tần số clock vào timer stream (timer APB1 chạy x2 khi APB1 có bộ chia).
+ */
+static uint32 Dio_StreamTimerClock(void)
+{
+    RCC_ClocksTypeDef clocks;
+
+    RCC_GetClocksFreq(&clocks);
+    return (clocks.PCLK1_Frequency == clocks.HCLK_Frequency) ?
+           clocks.PCLK1_Frequency : (2u * clocks.PCLK1_Frequency);
+}
+#endif
+
+#if (DIO_DEBOUNCE_API == STD_ON)
+/*
+ * Trạng thái debounce của một port, lưu theo bit-plane: bit n của mỗi word
+ * thuộc chân n. Bộ đếm 3 bit của 16 chân nằm trong cnt0/cnt1/cnt2 nên một
+ * lượt vài phép toán logic xử lý cả port.
+ */
+typedef struct
+{
+    uint16 state;               // Mức đã lọc
+    uint16 cnt0, cnt1, cnt2;    // Bộ đếm mẫu khác trạng thái (bit 0, 1, 2)
+    uint16 thr0, thr1, thr2;    // Ngưỡng theo kênh (bit 0, 1, 2)
+    uint16 changed;             // Các bit đã đổi trạng thái, chưa được đọc
+} Dio_DebouncePortType;
+
+static Dio_DebouncePortType Dio_Debounce[DIO_NUM_PORTS];
+
+/**
+ * @brief      Một bước debounce cho cả 16 chân của port.
+ * @details    Bit khác trạng thái: tăng bộ đếm; bit trùng trạng thái: xóa bộ đếm.
+ *             Bit có bộ đếm bằng ngưỡng thì đổi trạng thái và xóa bộ đếm.
+ */
+static void Dio_DebounceStep(Dio_DebouncePortType *d, uint16 raw)
+{
+    uint16 delta = (uint16)(raw ^ d->state);
+    uint16 c0 = d->cnt0;
+    uint16 c1 = d->cnt1;
+    uint16 hit;
+
+    d->cnt2 = (uint16)((d->cnt2 ^ (c1 & c0)) & delta);
+    d->cnt1 = (uint16)((c1 ^ c0) & delta);
+    d->cnt0 = (uint16)(~c0 & delta);
+
+    hit = (uint16)(delta & ~((d->cnt0 ^ d->thr0) | (d->cnt1 ^ d->thr1) | (d->cnt2 ^ d->thr2)));
+
+    d->state   ^= hit;
+    d->changed |= hit;
+    d->cnt0 &= (uint16)~hit;
+    d->cnt1 &= (uint16)~hit;
+    d->cnt2 &= (uint16)~hit;
+}
+#endif
+
+#if (DIO_NOTIFICATION_API == STD_ON)
+#define DIO_EVENT_QUEUE_MASK    (DIO_EVENT_QUEUE_SIZE - 1u)
+
+/*
+ * Hàng đợi vòng một-producer (ISR EXTI) / một-consumer (vòng lặp chính).
+ * Dio_EventHead chỉ do ISR ghi, Dio_EventTail chỉ do consumer ghi, nên không
+ * cần khóa. Chỉ số chạy tự do (uint8) và được mask khi truy cập mảng.
+ */
+static volatile Dio_EventType Dio_EventQueue[DIO_EVENT_QUEUE_SIZE];
+static volatile uint8 Dio_EventHead = 0;
+static volatile uint8 Dio_EventTail = 0;
+static volatile uint32 Dio_EventDropped = 0;
+static volatile uint32 Dio_NotifIsrMaxCycles = 0;
+
+/* Port và cạnh đang gán cho từng line EXTI (mỗi line chỉ nối được với một port) */
+static Dio_PortType Dio_ExtiPort[16];
+static Dio_EdgeType Dio_ExtiEdge[16];
+
+/**
+ * @brief      Phần chung của các ISR EXTI.
+ * @details    Đọc PR một lần, xóa tất cả line đang chờ bằng một lệnh ghi, rồi
+ *             đẩy một sự kiện cho mỗi line. Khi hàng đợi đầy, sự kiện bị bỏ và
+ *             được đếm trong Dio_EventDropped.
+ *
+ * @param[in]  Lines  Mặt nạ các line EXTI mà vector ngắt này phục vụ.
+ */
+static void Dio_ExtiIsr(uint32 Lines)
+{
+    uint32 start = CycleCounter_Get();
+    uint32 pending = EXTI->PR & EXTI->IMR & Lines;
+    uint8 head = Dio_EventHead;
+    uint32 cycles;
+
+    EXTI->PR = pending;
+
+    while (pending != 0u)
+    {
+        uint8 line = (uint8)(31u - (uint32)__builtin_clz(pending));
+        Dio_PortType port = Dio_ExtiPort[line];
+
+        pending &= ~(1uL << line);
+
+        if ((uint8)(head - Dio_EventTail) >= DIO_EVENT_QUEUE_SIZE)
+        {
+            Dio_EventDropped++;
+            continue;
+        }
+
+        volatile Dio_EventType *ev = &Dio_EventQueue[head & DIO_EVENT_QUEUE_MASK];
+        ev->timestamp = start;
+        ev->channel = (Dio_ChannelType)((port * 16u) + line);
+        // Chỉ cần đọc IDR khi line bắt cả hai cạnh
+        if (Dio_ExtiEdge[line] != DIO_EDGE_BOTH)
+        {
+            ev->edge = Dio_ExtiEdge[line];
+        }
+        else
+        {
+            ev->edge = ((DIO_GET_PORT_BASE(port)->IDR & (1uL << line)) != 0u) ? DIO_EDGE_RISING : DIO_EDGE_FALLING;
+        }
+        head++;
+    }
+
+    // Công bố các phần tử mới sau khi đã ghi xong nội dung
+    Dio_EventHead = head;
+
+    cycles = CycleCounter_Get() - start;
+    if (cycles > Dio_NotifIsrMaxCycles) Dio_NotifIsrMaxCycles = cycles;
+}
+
+/**
+ * @brief      Trả về IRQ của vector EXTI phục vụ line.
+ */
+static IRQn_Type Dio_ExtiIrq(uint8 Line)
+{
+    switch (Line)
+    {
+        case 0: return EXTI0_IRQn;
+        case 1: return EXTI1_IRQn;
+        case 2: return EXTI2_IRQn;
+        case 3: return EXTI3_IRQn;
+        case 4: return EXTI4_IRQn;
+        default: return (Line < 10u) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+    }
+}
+
+/**
+ * @brief      Mặt nạ các line EXTI dùng chung vector ngắt với line.
+ */
+static uint32 Dio_ExtiIrqLines(uint8 Line)
+{
+    if (Line < 5u) return 1uL << Line;
+    return (Line < 10u) ? 0x03E0u : 0xFC00u;
+}
+#endif
 
 /**
  * @brief      Đọc mức logic của kênh DIO được chỉ định.
@@ -19,19 +219,31 @@
  * @return     STD_HIGH hoặc STD_LOW tùy theo trạng thái của chân.
  *
  * @note       Hàm giả định rằng chân đã được cấu hình đúng (input hoặc output).
+ *             Port và mặt nạ chân được lấy từ bảng Dio_ChannelCfg, đọc IDR trực tiếp.
  */
 Dio_LevelType Dio_ReadChannel(Dio_ChannelType ChannelId)
 {
     Dio_LevelType retVal = STD_LOW;
-    GPIO_TypeDef *GET_PORT = NULL_PTR;
-    uint16_t GET_PIN;
+    const Dio_ChannelCfgType *ch;
+
+    if (ChannelId >= DIO_NUM_CHANNELS) return STD_LOW;
 
     // Ánh xạ ChannelId thành Port và Pin vật lý
-    GET_PORT = DIO_GET_PORT_ID(ChannelId);
-    GET_PIN  = DIO_GET_PIN_NUM(ChannelId);
+    ch = &Dio_ChannelCfg[ChannelId];
 
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+    if (Dio_ReadMode == DIO_READ_SNAPSHOT)
+    {
+        return ((Dio_InputSnapshot.port[ChannelId >> 4] & ch->mask) != 0u) ? STD_HIGH : STD_LOW;
+    }
+#endif
+
+#if (DIO_BITBAND_ACCESS == STD_ON)
+    // Word alias bit-band trả về đúng 0 hoặc 1
+    retVal = (Dio_LevelType)(*ch->idrBit);
+#else
     // Đọc trạng thái chân và chuyển về STD_HIGH hoặc STD_LOW
-    if (GPIO_ReadInputDataBit(GET_PORT, GET_PIN) == Bit_SET)
+    if ((ch->port->IDR & ch->mask) != 0u)
     {
         retVal = STD_HIGH;
     }
@@ -39,6 +251,7 @@ Dio_LevelType Dio_ReadChannel(Dio_ChannelType ChannelId)
     {
         retVal = STD_LOW;
     }
+#endif
 
     return retVal;
 }
@@ -51,23 +264,43 @@ Dio_LevelType Dio_ReadChannel(Dio_ChannelType ChannelId)
  * @param[in]  Level      Mức logic cần ghi (STD_HIGH hoặc STD_LOW).
  *
  * @note       Chân phải được cấu hình là output thì mới có tác dụng.
+ *             Ghi bằng một lệnh store vào BSRR/BRR nên an toàn khi ISR
+ *             cũng ghi vào cùng port.
  */
 void Dio_WriteChannel(Dio_ChannelType ChannelId, Dio_LevelType Level)
 {
-    GPIO_TypeDef *GET_PORT = NULL_PTR;
-    uint16_t GET_PIN;
+    const Dio_ChannelCfgType *ch;
 
-    GET_PORT = DIO_GET_PORT_ID(ChannelId);
-    GET_PIN  = DIO_GET_PIN_NUM(ChannelId);
+    if (ChannelId >= DIO_NUM_CHANNELS) return;
+
+    ch = &Dio_ChannelCfg[ChannelId];
+
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+    if (Dio_WriteMode == DIO_WRITE_DEFERRED)
+    {
+        if (Level == STD_HIGH || Level == STD_LOW)
+        {
+            Dio_StageWrite(ChannelId >> 4, (Level == STD_HIGH) ? ch->mask : 0u, ch->mask);
+        }
+        return;
+    }
+#endif
 
     switch (Level)
     {
+#if (DIO_BITBAND_ACCESS == STD_ON)
         case STD_HIGH:
-            GPIO_WriteBit(GET_PORT, GET_PIN, Bit_SET);
+        case STD_LOW:
+            *ch->odrBit = Level;
+            break;
+#else
+        case STD_HIGH:
+            ch->port->BSRR = ch->mask;
             break;
         case STD_LOW:
-            GPIO_WriteBit(GET_PORT, GET_PIN, Bit_RESET);
+            ch->port->BRR = ch->mask;
             break;
+#endif
         default:
             break;
     }
@@ -75,42 +308,62 @@ void Dio_WriteChannel(Dio_ChannelType ChannelId, Dio_LevelType Level)
 
 /**
  * @brief      Đảo trạng thái logic của một chân DIO.
- * @details    Đọc trạng thái hiện tại, sau đó ghi giá trị ngược lại.
+ * @details    Đọc ODR một lần, sau đó ghi giá trị ngược lại bằng một lệnh
+ *             store vào BSRR/BRR (hoặc vào alias bit-band của bit ODR).
  *
  * @param[in]  ChannelId  ID của kênh cần đảo trạng thái.
  *
  * @return     Trạng thái mới sau khi được đảo.
  *
- * @note       Chân phải ở chế độ output. Hàm không đảm bảo tính nguyên tử.
+ * @note       Chân phải ở chế độ output. Chỉ bit của kênh này bị thay đổi,
+ *             các bit khác trong port do ISR ghi sẽ không bị mất.
  */
 Dio_LevelType Dio_FlipChannel(Dio_ChannelType ChannelId)
 {
-    Dio_LevelType val = STD_LOW;
     Dio_LevelType new_reval = STD_LOW;
+    const Dio_ChannelCfgType *ch;
+
+    if (ChannelId >= DIO_NUM_CHANNELS) return STD_LOW;
 
-    val = Dio_ReadChannel(ChannelId);
+    ch = &Dio_ChannelCfg[ChannelId];
 
-    switch (val)
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+    if (Dio_WriteMode == DIO_WRITE_DEFERRED)
     {
-        case STD_LOW:
-            Dio_WriteChannel(ChannelId, STD_HIGH);
-            new_reval = STD_HIGH;
-            break;
-        case STD_HIGH:
-            Dio_WriteChannel(ChannelId, STD_LOW);
-            new_reval = STD_LOW;
-            break;
-        default:
-            new_reval = val;
-            break;
+        // Trạng thái hiện tại = ODR đã áp các thay đổi đang chờ commit
+        const Dio_ShadowPortType *sh = &Dio_Shadow[ChannelId >> 4];
+        uint16 current = (uint16)((ch->port->ODR & ~sh->resetMask) | sh->setMask);
+
+        new_reval = ((current & ch->mask) != 0u) ? STD_LOW : STD_HIGH;
+        Dio_StageWrite(ChannelId >> 4, (new_reval == STD_HIGH) ? ch->mask : 0u, ch->mask);
+        return new_reval;
     }
+#endif
+
+#if (DIO_BITBAND_ACCESS == STD_ON)
+    // Ghi vào alias chỉ thay đổi đúng một bit ODR (bus thực hiện RMW nguyên tử)
+    new_reval = (Dio_LevelType)(*ch->odrBit ^ 1u);
+    *ch->odrBit = new_reval;
+#else
+    if ((ch->port->ODR & ch->mask) != 0u)
+    {
+        ch->port->BRR = ch->mask;
+        new_reval = STD_LOW;
+    }
+    else
+    {
+        ch->port->BSRR = ch->mask;
+        new_reval = STD_HIGH;
+    }
+#endif
 
     return new_reval;
 }
 
 /**
  * @brief      Đọc toàn bộ trạng thái logic của một port.
- * @details    Trả về giá trị mức logic của tất cả các chân trong port.
+ * @details    Trả về giá trị mức logic của tất cả các chân trong port,
+ *             đọc từ thanh ghi đầu vào IDR (hoặc từ snapshot nếu đang bật).
  *
  * @param[in]  PortId  ID của port cần đọc (VD: DIO_GPIO_PORT_A...)
  *
@@ -137,9 +390,17 @@ Dio_PortLevelType Dio_ReadPort(Dio_PortType PortId)
         case 1: GET_PORT = GPIOB; break;
         case 2: GET_PORT = GPIOC; break;
         case 3: GET_PORT = GPIOD; break;
+        default: return STD_LOW;
+    }
+
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+    if (Dio_ReadMode == DIO_READ_SNAPSHOT)
+    {
+        return Dio_InputSnapshot.port[PortId];
     }
+#endif
 
-    retVal = (Dio_PortLevelType)(GPIO_ReadOutputData(GET_PORT));
+    retVal = (Dio_PortLevelType)(GET_PORT->IDR);
     return retVal;
 }
 
@@ -147,6 +408,7 @@ Dio_PortLevelType Dio_ReadPort(Dio_PortType PortId)
  * @brief      Ghi toàn bộ mức logic ra một port.
  * @details    Ghi giá trị logic cho toàn bộ các chân của port.
  *             Các chân cấu hình input sẽ không bị ảnh hưởng.
+ *             Cả 16 bit được set/reset bằng một lệnh store vào BSRR.
  *
  * @param[in]  PortId  ID của port (VD: 0 cho GPIOA, 1 cho GPIOB, ...)
  * @param[in]  Level   Giá trị logic bitwise cần ghi.
@@ -164,12 +426,21 @@ void Dio_WritePort(Dio_PortType PortId, Dio_PortLevelType Level)
         default: return;
     }
 
-    GPIO_Write(GET_PORT, Level);
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+    if (Dio_WriteMode == DIO_WRITE_DEFERRED)
+    {
+        Dio_StageWrite(PortId, Level, 0xFFFFu);
+        return;
+    }
+#endif
+
+    GET_PORT->BSRR = DIO_BSRR_VALUE(Level, 0xFFFFu);
 }
 
 /**
  * @brief      Đọc trạng thái của một nhóm kênh DIO liền kề.
  * @details    Trả về giá trị nhóm sau khi đã dịch offset về bit thấp nhất.
+ *             Giá trị được lấy từ IDR (hoặc từ snapshot nếu đang bật).
  *
  * @param[in]  ChannelGroupIdPtr  Con trỏ tới cấu trúc nhóm kênh.
  *
@@ -181,10 +452,15 @@ Dio_PortLevelType Dio_ReadChannelGroup(const Dio_ChannelGroupType* ChannelGroupI
 
     if (ChannelGroupIdPtr == NULL_PTR) return STD_LOW;
 
-    GET_PORT = DIO_GET_PORT_ID(ChannelGroupIdPtr->port);
+    GET_PORT = DIO_GET_PORT_BASE(ChannelGroupIdPtr->port);
     if (GET_PORT == NULL_PTR) return STD_LOW;
 
-    uint16_t value = GPIO_ReadOutputData(GET_PORT);
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+    uint16_t value = (Dio_ReadMode == DIO_READ_SNAPSHOT) ?
+                     Dio_InputSnapshot.port[ChannelGroupIdPtr->port] : (uint16_t)GET_PORT->IDR;
+#else
+    uint16_t value = (uint16_t)GET_PORT->IDR;
+#endif
     uint16_t group_value = (value & ChannelGroupIdPtr->mask) >> ChannelGroupIdPtr->offset;
 
     return (Dio_PortLevelType)group_value;
@@ -192,7 +468,8 @@ Dio_PortLevelType Dio_ReadChannelGroup(const Dio_ChannelGroupType* ChannelGroupI
 
 /**
  * @brief      Ghi mức logic cho nhóm kênh DIO.
- * @details    Chỉ những bit nằm trong mask mới bị thay đổi.
+ * @details    Chỉ những bit nằm trong mask mới bị thay đổi. Mặt nạ set/reset
+ *             được tính từ mask/offset và ghi bằng một lệnh store vào BSRR.
  *
  * @param[in]  ChannelGroupIdPtr  Con trỏ đến cấu hình nhóm kênh.
  * @param[in]  Level              Giá trị logic cần ghi (bit thấp nhất ứng với offset).
@@ -203,15 +480,21 @@ void Dio_WriteChannelGroup(const Dio_ChannelGroupType* ChannelGroupIdPtr, Dio_Po
 
     if (ChannelGroupIdPtr == NULL_PTR) return;
 
-    GET_PORT = DIO_GET_PORT_ID(ChannelGroupIdPtr->port);
+    GET_PORT = DIO_GET_PORT_BASE(ChannelGroupIdPtr->port);
     if (GET_PORT == NULL_PTR) return;
 
-    uint16_t port_value = GPIO_ReadOutputData(GET_PORT);
-
-    port_value &= ~(ChannelGroupIdPtr->mask);
-    port_value |= ((Level << ChannelGroupIdPtr->offset) & ChannelGroupIdPtr->mask);
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+    if (Dio_WriteMode == DIO_WRITE_DEFERRED)
+    {
+        Dio_StageWrite(ChannelGroupIdPtr->port,
+                       (uint16)((uint32)Level << ChannelGroupIdPtr->offset),
+                       ChannelGroupIdPtr->mask);
+        return;
+    }
+#endif
 
-    GPIO_Write(GET_PORT, port_value);
+    GET_PORT->BSRR = DIO_BSRR_VALUE((uint32)Level << ChannelGroupIdPtr->offset,
+                                    ChannelGroupIdPtr->mask);
 }
 
 /**
@@ -231,6 +514,7 @@ void Dio_GetVersionInfo(Std_VersionInfoType* VersionInfo)
 /**
  * @brief      Ghi dữ liệu có mặt nạ lên port.
  * @details    Chỉ những bit được chỉ định bởi mask sẽ bị ghi đè. Các bit còn lại giữ nguyên.
+ *             Không đọc ODR: một lệnh store vào BSRR thay cho read-modify-write.
  *
  * @param[in]  PortId  ID của port (VD: DIO_GPIO_PORT_A, B, C, D)
  * @param[in]  Level   Giá trị cần ghi (bit phải đúng vị trí mask)
@@ -249,7 +533,495 @@ void Dio_MaskedWritePort(Dio_PortType PortId, Dio_PortLevelType Level, Dio_PortL
         default: return;
     }
 
-    uint16_t port_val = GPIO_ReadOutputData(GET_PORT);
-    port_val = (port_val & ~Mask) | (Level & Mask);
-    GPIO_Write(GET_PORT, port_val);
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+    if (Dio_WriteMode == DIO_WRITE_DEFERRED)
+    {
+        Dio_StageWrite(PortId, Level, Mask);
+        return;
+    }
+#endif
+
+    GET_PORT->BSRR = DIO_BSRR_VALUE(Level, Mask);
+}
+
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+/**
+ * @brief      Chọn chế độ ghi của các API ghi DIO.
+ * @details    Khi chuyển về DIO_WRITE_IMMEDIATE, các thay đổi đang chờ được
+ *             commit ngay để không bị mất.
+ *
+ * @param[in]  Mode  DIO_WRITE_IMMEDIATE hoặc DIO_WRITE_DEFERRED.
+ */
+void Dio_SetWriteMode(Dio_WriteModeType Mode)
+{
+    if (Mode == DIO_WRITE_IMMEDIATE)
+    {
+        Dio_Commit();
+    }
+    Dio_WriteMode = Mode;
+}
+
+/**
+ * @brief      Xuất toàn bộ ảnh shadow ra các port.
+ * @details    Mỗi port có thay đổi được ghi bằng đúng một lệnh store vào BSRR,
+ *             nên mọi output của một chu kỳ trên cùng port đổi đồng thời.
+ *             Port không có thay đổi thì không bị truy cập.
+ *
+ * @note       Gọi một lần ở cuối mỗi chu kỳ. Các lệnh ghi ở chế độ trễ nên được
+ *             gọi từ cùng một ngữ cảnh với Dio_Commit (ISR dùng các hàm inline
+ *             Dio_WriteChannel_<n> để ghi trực tiếp).
+ */
+void Dio_Commit(void)
+{
+    for (Dio_PortType i = 0; i < DIO_NUM_PORTS; i++)
+    {
+        uint32 bsrr = ((uint32)Dio_Shadow[i].resetMask << 16) | Dio_Shadow[i].setMask;
+
+        if (bsrr != 0u)
+        {
+            DIO_GET_PORT_BASE(i)->BSRR = bsrr;
+            Dio_Shadow[i].setMask = 0u;
+            Dio_Shadow[i].resetMask = 0u;
+        }
+    }
+}
+#endif
+
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+/**
+ * @brief      Chốt đầu vào của cả 4 port vào ảnh snapshot.
+ * @details    Đọc IDR của GPIOA..GPIOD liên tiếp (4 lệnh load) nên các kênh
+ *             trong một chu kỳ được lấy mẫu gần như cùng lúc, kèm timestamp
+ *             theo chu kỳ CPU (DWT CYCCNT).
+ *
+ * @note       Gọi một lần ở đầu mỗi chu kỳ, trước các lệnh đọc kênh.
+ */
+void Dio_SnapshotInputs(void)
+{
+    Dio_InputSnapshot.timestamp = CycleCounter_Get();
+    Dio_InputSnapshot.port[GPIO_PORT_A] = (Dio_PortLevelType)GPIOA->IDR;
+    Dio_InputSnapshot.port[GPIO_PORT_B] = (Dio_PortLevelType)GPIOB->IDR;
+    Dio_InputSnapshot.port[GPIO_PORT_C] = (Dio_PortLevelType)GPIOC->IDR;
+    Dio_InputSnapshot.port[GPIO_PORT_D] = (Dio_PortLevelType)GPIOD->IDR;
+}
+
+/**
+ * @brief      Chọn nguồn dữ liệu cho Dio_ReadChannel/Dio_ReadPort/Dio_ReadChannelGroup.
+ * @details    Khi chọn DIO_READ_SNAPSHOT, bộ đếm chu kỳ được bật và ảnh đầu vào
+ *             được chốt ngay một lần để các lệnh đọc đầu tiên có dữ liệu hợp lệ.
+ *
+ * @param[in]  Mode  DIO_READ_LIVE hoặc DIO_READ_SNAPSHOT.
+ */
+void Dio_SetReadMode(Dio_ReadModeType Mode)
+{
+    if (Mode == DIO_READ_SNAPSHOT)
+    {
+        CycleCounter_Init();
+        Dio_SnapshotInputs();
+    }
+    Dio_ReadMode = Mode;
+}
+
+/**
+ * @brief      Trả về ảnh đầu vào chốt gần nhất (cả 4 port và timestamp).
+ */
+const Dio_InputSnapshotType* Dio_GetInputSnapshot(void)
+{
+    return &Dio_InputSnapshot;
+}
+#endif
+
+#if (DIO_STREAM_API == STD_ON)
+/**
+ * @brief      Phát một chuỗi word BSRR ra port bằng DMA, nhịp bởi timer.
+ * @details    Mỗi sự kiện Update của DIO_STREAM_TIMER tạo một request DMA,
+ *             DMA ghi word tiếp theo của buffer vào GPIOx->BSRR. CPU không tham
+ *             gia sau khi khởi động; mỗi word là một cặp mặt nạ set/reset nên
+ *             các chân không nằm trong mặt nạ (kể cả chân do ISR điều khiển)
+ *             không bị ảnh hưởng.
+ *
+ * @param[in]  PortId     ID của port (0 = GPIOA ... 3 = GPIOD).
+ * @param[in]  bsrrWords  Buffer các word BSRR (xem DIO_BSRR_VALUE), phải tồn tại
+ *                        suốt thời gian phát.
+ * @param[in]  length     Số word trong buffer (>= 2 với DIO_STREAM_DOUBLE_BUFFER).
+ * @param[in]  rateHz     Tốc độ phát (word/giây).
+ * @param[in]  mode       One-shot, vòng lặp hoặc double-buffer.
+ *
+ * @return     E_OK nếu đã khởi động, E_NOT_OK nếu tham số sai, tần số không
+ *             đạt được hoặc đang có stream khác chạy.
+ *
+ * @note       Tần số thực = clock timer / ((PSC + 1) * (ARR + 1)), sai số do
+ *             làm tròn xuống số tick nguyên.
+ */
+Std_ReturnType Dio_StreamPort(Dio_PortType PortId, const uint32* bsrrWords, uint16 length,
+                              uint32 rateHz, Dio_StreamModeType mode)
+{
+    GPIO_TypeDef *GET_PORT = DIO_GET_PORT_BASE(PortId);
+    uint32 ticks;
+    uint32 psc;
+    uint32 ccr;
+
+    if (GET_PORT == NULL_PTR || bsrrWords == NULL_PTR || length == 0u || rateHz == 0u) return E_NOT_OK;
+    if (mode == DIO_STREAM_DOUBLE_BUFFER && length < 2u) return E_NOT_OK;
+    if (Dio_StreamActive) return E_NOT_OK;
+
+    // Số tick timer cho mỗi word, tách thành PSC/ARR 16 bit
+    ticks = Dio_StreamTimerClock() / rateHz;
+    if (ticks < 2u) return E_NOT_OK;   // ARR = 0 làm timer dừng đếm
+    psc = (ticks - 1u) / 65536u;
+
+    ccr = DMA_CCR1_DIR | DMA_CCR1_MINC | DMA_CCR1_PSIZE_1 | DMA_CCR1_MSIZE_1 | DMA_CCR1_PL | DMA_CCR1_TEIE;
+    switch (mode)
+    {
+        case DIO_STREAM_ONE_SHOT:
+            ccr |= DMA_CCR1_TCIE;
+            break;
+        case DIO_STREAM_CIRCULAR:
+            ccr |= DMA_CCR1_CIRC;
+            if (Dio_StreamDoneCbk != NULL_PTR) ccr |= DMA_CCR1_TCIE;
+            break;
+        case DIO_STREAM_DOUBLE_BUFFER:
+            ccr |= DMA_CCR1_CIRC | DMA_CCR1_HTIE | DMA_CCR1_TCIE;
+            break;
+        default:
+            return E_NOT_OK;
+    }
+
+    // Clock DMA1 và timer được giữ đến Dio_StopStream
+    Clock_BeginPhase();
+    Clock_Request(CLOCK_DMA1);
+    Clock_Request(DIO_STREAM_TIMER_CLOCK);
+    Clock_EndPhase();
+
+    // Timer: dừng, nạp PSC/ARR bằng UG trước khi bật UDE để không phát word thừa
+    DIO_STREAM_TIMER->CR1  = 0;
+    DIO_STREAM_TIMER->DIER = 0;
+    DIO_STREAM_TIMER->PSC  = (uint16)psc;
+    DIO_STREAM_TIMER->ARR  = (uint16)((ticks / (psc + 1u)) - 1u);
+    DIO_STREAM_TIMER->CNT  = 0;
+    DIO_STREAM_TIMER->EGR  = TIM_EGR_UG;
+    DIO_STREAM_TIMER->SR   = 0;
+
+    // DMA: bộ nhớ (32 bit, tăng địa chỉ) -> BSRR (32 bit, cố định)
+    DIO_STREAM_DMA_CHANNEL->CCR = 0;
+    DMA1->IFCR = DIO_STREAM_FLAG_ALL;
+    DIO_STREAM_DMA_CHANNEL->CPAR  = (uint32)&GET_PORT->BSRR;
+    DIO_STREAM_DMA_CHANNEL->CMAR  = (uint32)bsrrWords;
+    DIO_STREAM_DMA_CHANNEL->CNDTR = length;
+    DIO_STREAM_DMA_CHANNEL->CCR = ccr;
+
+    NVIC_InitTypeDef n;
+    n.NVIC_IRQChannel = DIO_STREAM_DMA_IRQn;
+    n.NVIC_IRQChannelPreemptionPriority = DIO_STREAM_IRQ_PRIORITY;
+    n.NVIC_IRQChannelSubPriority = 0;
+    n.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&n);
+
+    Dio_StreamMode = mode;
+    Dio_StreamActive = 1;
+
+    // Bật DMA trước, sau đó mới cho timer phát request
+    DIO_STREAM_DMA_CHANNEL->CCR = ccr | DMA_CCR1_EN;
+    DIO_STREAM_TIMER->DIER = TIM_DIER_UDE;
+    DIO_STREAM_TIMER->CR1  = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+    return E_OK;
+}
+
+/**
+ * @brief      Dừng stream đang chạy (timer và kênh DMA).
+ * @details    Chân giữ mức của word BSRR cuối cùng đã được ghi.
+ */
+void Dio_StopStream(void)
+{
+    if (!Dio_StreamActive) return;
+
+    DIO_STREAM_TIMER->CR1  = 0;
+    DIO_STREAM_TIMER->DIER = 0;
+    DIO_STREAM_DMA_CHANNEL->CCR = 0;
+    DMA1->IFCR = DIO_STREAM_FLAG_ALL;
+    Dio_StreamActive = 0;
+
+    // Ngoại vi đã dừng và cờ đã xóa mới trả clock
+    Clock_BeginPhase();
+    Clock_Release(DIO_STREAM_TIMER_CLOCK);
+    Clock_Release(CLOCK_DMA1);
+    Clock_EndPhase();
+}
+
+/**
+ * @brief      Ngắt của kênh DMA stream: nửa buffer, hết buffer, lỗi truyền.
+ * @details    Đọc ISR một lần và xóa tất cả cờ của kênh bằng một lệnh ghi IFCR.
+ */
+void DIO_STREAM_DMA_IRQHandler(void)
+{
+    uint32 isr = DMA1->ISR & DIO_STREAM_FLAG_ALL;
+
+    DMA1->IFCR = isr;
+
+    if ((isr & DIO_STREAM_FLAG_TE) != 0u)
+    {
+        Dio_StopStream();
+        return;
+    }
+
+    if ((isr & DIO_STREAM_FLAG_HT) != 0u && Dio_StreamHalfCbk != NULL_PTR)
+    {
+        Dio_StreamHalfCbk();
+    }
+
+    if ((isr & DIO_STREAM_FLAG_TC) != 0u)
+    {
+        if (Dio_StreamMode == DIO_STREAM_ONE_SHOT)
+        {
+            Dio_StopStream();
+        }
+        if (Dio_StreamDoneCbk != NULL_PTR)
+        {
+            Dio_StreamDoneCbk();
+        }
+    }
 }
+#endif
+
+#if (DIO_DEBOUNCE_API == STD_ON)
+/**
+ * @brief      Khởi tạo bộ debounce.
+ * @details    Gộp bảng ngưỡng theo kênh Dio_DebounceThreshold thành 3 bit-plane
+ *             cho mỗi port, trạng thái ban đầu lấy từ IDR hiện tại.
+ */
+void Dio_DebounceInit(void)
+{
+    for (Dio_PortType p = 0; p < DIO_NUM_PORTS; p++)
+    {
+        Dio_DebouncePortType *d = &Dio_Debounce[p];
+
+        d->thr0 = d->thr1 = d->thr2 = 0u;
+        for (uint8 pin = 0; pin < 16u; pin++)
+        {
+            uint8 thr = Dio_DebounceThreshold[(p * 16u) + pin];
+
+            if (thr == 0u) thr = 1u;
+            if (thr > DIO_DEBOUNCE_MAX_THRESHOLD) thr = DIO_DEBOUNCE_MAX_THRESHOLD;
+
+            if (thr & 0x1u) d->thr0 |= (uint16)(1u << pin);
+            if (thr & 0x2u) d->thr1 |= (uint16)(1u << pin);
+            if (thr & 0x4u) d->thr2 |= (uint16)(1u << pin);
+        }
+
+        d->state = (uint16)DIO_GET_PORT_BASE(p)->IDR;
+        d->cnt0 = d->cnt1 = d->cnt2 = 0u;
+        d->changed = 0u;
+    }
+}
+
+/**
+ * @brief      Lấy mẫu và debounce tất cả 64 kênh.
+ * @details    Gọi định kỳ (VD mỗi 1 ms); ngưỡng tính theo số lần gọi. Khi đang
+ *             đọc từ snapshot thì dùng ảnh đã chốt để khớp với các API đọc khác.
+ */
+void Dio_DebounceMainFunction(void)
+{
+    for (Dio_PortType p = 0; p < DIO_NUM_PORTS; p++)
+    {
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+        uint16 raw = (Dio_ReadMode == DIO_READ_SNAPSHOT) ?
+                     Dio_InputSnapshot.port[p] : (uint16)DIO_GET_PORT_BASE(p)->IDR;
+#else
+        uint16 raw = (uint16)DIO_GET_PORT_BASE(p)->IDR;
+#endif
+        Dio_DebounceStep(&Dio_Debounce[p], raw);
+    }
+}
+
+/**
+ * @brief      Đọc mức đã lọc nhiễu của một kênh.
+ */
+Dio_LevelType Dio_ReadChannelDebounced(Dio_ChannelType ChannelId)
+{
+    if (ChannelId >= DIO_NUM_CHANNELS) return STD_LOW;
+
+    return ((Dio_Debounce[ChannelId >> 4].state & Dio_ChannelCfg[ChannelId].mask) != 0u) ?
+           STD_HIGH : STD_LOW;
+}
+
+/**
+ * @brief      Trả về và xóa mặt nạ các kênh của port đã đổi mức (sau lọc)
+ *             kể từ lần gọi trước.
+ */
+Dio_PortLevelType Dio_GetDebounceChanges(Dio_PortType PortId)
+{
+    Dio_PortLevelType changed;
+
+    if (PortId >= DIO_NUM_PORTS) return 0u;
+
+    changed = Dio_Debounce[PortId].changed;
+    Dio_Debounce[PortId].changed = 0u;
+    return changed;
+}
+#endif
+
+#if (DIO_NOTIFICATION_API == STD_ON)
+/**
+ * @brief      Bật thông báo cạnh (EXTI) cho một kênh DIO.
+ * @details    Nối line EXTI của chân với port qua AFIO_EXTICR, chọn cạnh,
+ *             bật mặt nạ ngắt và vector NVIC tương ứng.
+ *
+ * @param[in]  ChannelId  Kênh cần theo dõi (VD: DIO_CHANEL_24 = PB8).
+ * @param[in]  Edge       Cạnh lên, cạnh xuống hoặc cả hai.
+ *
+ * @return     E_NOT_OK nếu tham số sai hoặc line EXTI đang được port khác dùng.
+ */
+Std_ReturnType Dio_EnableNotification(Dio_ChannelType ChannelId, Dio_EdgeType Edge)
+{
+    uint8 line;
+    Dio_PortType port;
+    uint32 bit;
+    uint32 primask;
+
+    if (ChannelId >= DIO_NUM_CHANNELS) return E_NOT_OK;
+    if ((Edge & DIO_EDGE_BOTH) == 0u) return E_NOT_OK;
+
+    line = (uint8)(ChannelId % 16u);
+    port = (Dio_PortType)(ChannelId >> 4);
+    bit  = 1uL << line;
+
+    CycleCounter_Init();
+
+    // IMR/RTSR/FTSR/EXTICR dùng chung với line khác (và driver khác): các lệnh
+    // đọc-sửa-ghi phải không bị ISR chen vào giữa
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if ((EXTI->IMR & bit) != 0u && Dio_ExtiPort[line] != port)
+    {
+        __set_PRIMASK(primask);
+        return E_NOT_OK;
+    }
+
+    // AFIO phải có clock trước khi ghi EXTICR; giữ một tham chiếu khi còn line bật
+    if ((EXTI->IMR & 0xFFFFu) == 0u) Clock_Request(CLOCK_AFIO);
+
+    EXTI->IMR &= ~bit;
+    Dio_ExtiPort[line] = port;
+    Dio_ExtiEdge[line] = Edge;
+    AFIO->EXTICR[line >> 2] = (AFIO->EXTICR[line >> 2] & ~(0xFuL << ((line & 3u) * 4u)))
+                              | ((uint32)port << ((line & 3u) * 4u));
+
+    if (Edge & DIO_EDGE_RISING)  EXTI->RTSR |= bit; else EXTI->RTSR &= ~bit;
+    if (Edge & DIO_EDGE_FALLING) EXTI->FTSR |= bit; else EXTI->FTSR &= ~bit;
+
+    EXTI->PR = bit;
+    EXTI->IMR |= bit;
+
+    __set_PRIMASK(primask);
+
+    NVIC_InitTypeDef n;
+    n.NVIC_IRQChannel = Dio_ExtiIrq(line);
+    n.NVIC_IRQChannelPreemptionPriority = DIO_NOTIFICATION_IRQ_PRIORITY;
+    n.NVIC_IRQChannelSubPriority = 0;
+    n.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&n);
+
+    return E_OK;
+}
+
+/**
+ * @brief      Tắt thông báo cạnh của một kênh DIO.
+ * @note       Vector NVIC của line được tắt khi không còn line nào của nó
+ *             bật: EXTI0..EXTI4 tắt ngay, EXTI9_5/EXTI15_10 dùng chung thì
+ *             tắt khi line cuối cùng của nhóm tắt.
+ */
+void Dio_DisableNotification(Dio_ChannelType ChannelId)
+{
+    uint8 line;
+    uint32 bit;
+    uint32 primask;
+    uint32 imr;
+
+    if (ChannelId >= DIO_NUM_CHANNELS) return;
+
+    line = (uint8)(ChannelId % 16u);
+    bit  = 1uL << line;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (Dio_ExtiPort[line] != (ChannelId >> 4) || (EXTI->IMR & bit) == 0u)
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    EXTI->IMR  &= ~bit;
+    EXTI->RTSR &= ~bit;
+    EXTI->FTSR &= ~bit;
+    EXTI->PR = bit;
+    imr = EXTI->IMR;
+
+    __set_PRIMASK(primask);
+
+    if ((imr & Dio_ExtiIrqLines(line)) == 0u) NVIC_DisableIRQ(Dio_ExtiIrq(line));
+
+    // Line cuối cùng đã tắt thì trả clock AFIO
+    if ((imr & 0xFFFFu) == 0u) Clock_Release(CLOCK_AFIO);
+}
+
+/**
+ * @brief      Lấy tối đa MaxEvents sự kiện ra khỏi hàng đợi (theo lô).
+ *
+ * @param[out] Events     Mảng nhận sự kiện.
+ * @param[in]  MaxEvents  Kích thước mảng.
+ *
+ * @return     Số sự kiện đã lấy ra.
+ */
+uint8 Dio_ReadEvents(Dio_EventType* Events, uint8 MaxEvents)
+{
+    uint8 tail = Dio_EventTail;
+    uint8 count = 0;
+    uint8 available;
+
+    if (Events == NULL_PTR) return 0;
+
+    available = (uint8)(Dio_EventHead - tail);
+    while (count < available && count < MaxEvents)
+    {
+        const volatile Dio_EventType *ev = &Dio_EventQueue[tail & DIO_EVENT_QUEUE_MASK];
+
+        Events[count].timestamp = ev->timestamp;
+        Events[count].channel = ev->channel;
+        Events[count].edge = ev->edge;
+        tail++;
+        count++;
+    }
+
+    // Trả chỗ cho ISR sau khi đã sao chép xong
+    Dio_EventTail = tail;
+    return count;
+}
+
+/**
+ * @brief      Tổng số sự kiện bị bỏ do hàng đợi đầy.
+ */
+uint32 Dio_GetDroppedEvents(void)
+{
+    return Dio_EventDropped;
+}
+
+/**
+ * @brief      Thời gian thực thi dài nhất của ISR EXTI (chu kỳ CPU).
+ */
+uint32 Dio_GetNotificationIsrMaxCycles(void)
+{
+    return Dio_NotifIsrMaxCycles;
+}
+
+/* Các vector ngắt EXTI: mỗi vector phục vụ một nhóm line */
+void EXTI0_IRQHandler(void)     { Dio_ExtiIsr(0x0001u); }
+void EXTI1_IRQHandler(void)     { Dio_ExtiIsr(0x0002u); }
+void EXTI2_IRQHandler(void)     { Dio_ExtiIsr(0x0004u); }
+void EXTI3_IRQHandler(void)     { Dio_ExtiIsr(0x0008u); }
+void EXTI4_IRQHandler(void)     { Dio_ExtiIsr(0x0010u); }
+void EXTI9_5_IRQHandler(void)   { Dio_ExtiIsr(0x03E0u); }
+void EXTI15_10_IRQHandler(void) { Dio_ExtiIsr(0xFC00u); }
+#endif
\ No newline at end of file
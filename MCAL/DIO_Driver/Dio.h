@@ -8,58 +8,15 @@
 #ifndef DIO_H
 #define DIO_H
 
-#include "Std_Type.h"
-/*--------------------------------------------------
- * Dio_ChannelType Definition
- *--------------------------------------------------*/
-typedef uint8 Dio_ChannelType;  // Use uint8 if < 256 channels, else uint16 (48 channels (pins))
-
-typedef uint8 Dio_PortType;  // Được sử dụng để chỉ định cụ thể loại port A,B,C,D
-
-#define DIO_CHANEL_24 24
-#define DIO_CHANEL_45 45
-
-/*--------------------------------------------------
- * Dio_ChannelGroupType Definition
- * @brief
- * @details Type for the definition of a channel group, which consists of several adjoining channels within a port.
- *--------------------------------------------------*/
-typedef struct
-{
-    uint8 mask;         //This element mask which defines the positions of the channel group.
-    uint8 offset;       //This element shall be the position of the Channel Group on the port,counted from the LSB.
-    Dio_PortType port;
-} Dio_ChannelGroupType; //This shall be the port on which the Channel group is defined
-
-/*--------------------------------------------------
- * Dio_LevelType Definition
- * @details Là mức điện áp của GPIO
- *--------------------------------------------------*/
-typedef uint8 Dio_LevelType;
-
-/*--------------------------------------------------
- * Dio_PortLevelType Definition
- * @details Sẽ in ra tất các giá trị của 1 groupt A,B,C,D dưới dạng 0 1,và phải kiểu dữ liệu phải cover groupt lớn nhất
- *--------------------------------------------------*/
-typedef uint16 Dio_PortLevelType;
-/*--------------------------------------------------
- * Giá trị hợp lệ cho Dio_LevelType (Range)
- *--------------------------------------------------*/
-#define STD_LOW     0x00U  // Mức điện áp 0V (Logic 0)
-#define STD_HIGH    0x01U  // Mức điện áp 5V/3.3V (Logic 1)
-
-/*--------------------------------------------------
- * Mô tả (Description):
- * - Dio_LevelType đại diện cho trạng thái vật lý của chân DIO (input/output).
- * - STD_LOW  = 0V (hoặc GND)
- * - STD_HIGH = 5V/3.3V (tùy MCU)
- *--------------------------------------------------*/
+#include "Dio_Types.h"
+#include "Dio_Cfg.h"     // Bảng kênh, các công tắc API và hàm truy cập inline theo kênh
 
 #define PORT_VENDOR_ID    1001u
 #define PORT_MODULE_ID    120u
 #define PORT_SW_MAJOR_VERSION 1u
 #define PORT_SW_MINOR_VERSION 0u
 #define PORT_SW_PATCH_VERSION 0u
+
  /*--------------------------------------------------
  * Function Dio_ReadChannel
  *--------------------------------------------------*/
@@ -79,6 +36,22 @@ Dio_LevelType Dio_ReadChannel(Dio_ChannelType ChannelId);
 
 /*Lấy pin của ChanelID*/
 #define DIO_GET_PIN_NUM(ChannelId)  (1 << ((ChannelId) % 16))
+
+/*Lấy địa chỉ GPIOx từ PortId (0 = A, 1 = B, ...)*/
+#define DIO_GET_PORT_BASE(PortId)  (((PortId) == GPIO_PORT_A) ? GPIOA : \
+                                    ((PortId) == GPIO_PORT_B) ? GPIOB : \
+                                    ((PortId) == GPIO_PORT_C) ? GPIOC : \
+                                    ((PortId) == GPIO_PORT_D) ? GPIOD : \
+                                    NULL_PTR)
+
+/*--------------------------------------------------
+ * Giá trị ghi vào thanh ghi BSRR
+ * @details 16 bit thấp: các bit cần SET, 16 bit cao: các bit cần RESET.
+ *          Một lần ghi BSRR thay đổi tất cả các bit trong Mask một cách
+ *          nguyên tử, không cần đọc ODR trước (không read-modify-write).
+ *--------------------------------------------------*/
+#define DIO_BSRR_VALUE(Level, Mask) ((((uint32)(~(Level) & (Mask)) & 0xFFFFu) << 16) | \
+                                     ((uint32)((Level) & (Mask)) & 0xFFFFu))
  /*--------------------------------------------------
  * Function Dio_WriteChannel
  *--------------------------------------------------*/
@@ -112,4 +85,94 @@ void Dio_GetVersionInfo (Std_VersionInfoType* VersionInfo);
  * Function Dio_MaskedWritePort
  *--------------------------------------------------*/
 void Dio_MaskedWritePort (Dio_PortType PortId,Dio_PortLevelType Level,Dio_PortLevelType Mask);
+
+#if (DIO_DEFERRED_WRITE_API == STD_ON)
+ /*--------------------------------------------------
+ * Function Dio_SetWriteMode
+ *--------------------------------------------------*/
+void Dio_SetWriteMode (Dio_WriteModeType Mode);
+ /*--------------------------------------------------
+ * Function Dio_Commit
+ *--------------------------------------------------*/
+void Dio_Commit (void);
+#endif
+
+#if (DIO_INPUT_SNAPSHOT_API == STD_ON)
+/*--------------------------------------------------
+ * Dio_InputSnapshotType Definition
+ * @details Ảnh đầu vào của cả 4 port chốt liền nhau, kèm timestamp (chu kỳ CPU).
+ *--------------------------------------------------*/
+typedef struct
+{
+    Dio_PortLevelType port[DIO_NUM_PORTS];  // IDR của GPIOA..GPIOD
+    uint32 timestamp;                       // DWT CYCCNT lúc chốt
+} Dio_InputSnapshotType;
+
+ /*--------------------------------------------------
+ * Function Dio_SnapshotInputs
+ *--------------------------------------------------*/
+void Dio_SnapshotInputs (void);
+ /*--------------------------------------------------
+ * Function Dio_SetReadMode
+ *--------------------------------------------------*/
+void Dio_SetReadMode (Dio_ReadModeType Mode);
+ /*--------------------------------------------------
+ * Function Dio_GetInputSnapshot
+ *--------------------------------------------------*/
+const Dio_InputSnapshotType* Dio_GetInputSnapshot (void);
+#endif
+
+#if (DIO_STREAM_API == STD_ON)
+ /*--------------------------------------------------
+ * Function Dio_StreamPort
+ *--------------------------------------------------*/
+Std_ReturnType Dio_StreamPort (Dio_PortType PortId, const uint32* bsrrWords, uint16 length,
+                               uint32 rateHz, Dio_StreamModeType mode);
+ /*--------------------------------------------------
+ * Function Dio_StopStream
+ *--------------------------------------------------*/
+void Dio_StopStream (void);
+#endif
+
+#if (DIO_DEBOUNCE_API == STD_ON)
+ /*--------------------------------------------------
+ * Function Dio_DebounceInit
+ *--------------------------------------------------*/
+void Dio_DebounceInit (void);
+ /*--------------------------------------------------
+ * Function Dio_DebounceMainFunction
+ *--------------------------------------------------*/
+void Dio_DebounceMainFunction (void);
+ /*--------------------------------------------------
+ * Function Dio_ReadChannelDebounced
+ *--------------------------------------------------*/
+Dio_LevelType Dio_ReadChannelDebounced (Dio_ChannelType ChannelId);
+ /*--------------------------------------------------
+ * Function Dio_GetDebounceChanges
+ *--------------------------------------------------*/
+Dio_PortLevelType Dio_GetDebounceChanges (Dio_PortType PortId);
+#endif
+
+#if (DIO_NOTIFICATION_API == STD_ON)
+ /*--------------------------------------------------
+ * Function Dio_EnableNotification
+ *--------------------------------------------------*/
+Std_ReturnType Dio_EnableNotification (Dio_ChannelType ChannelId, Dio_EdgeType Edge);
+ /*--------------------------------------------------
+ * Function Dio_DisableNotification
+ *--------------------------------------------------*/
+void Dio_DisableNotification (Dio_ChannelType ChannelId);
+ /*--------------------------------------------------
+ * Function Dio_ReadEvents
+ *--------------------------------------------------*/
+uint8 Dio_ReadEvents (Dio_EventType* Events, uint8 MaxEvents);
+ /*--------------------------------------------------
+ * Function Dio_GetDroppedEvents
+ *--------------------------------------------------*/
+uint32 Dio_GetDroppedEvents (void);
+ /*--------------------------------------------------
+ * Function Dio_GetNotificationIsrMaxCycles
+ *--------------------------------------------------*/
+uint32 Dio_GetNotificationIsrMaxCycles (void);
+#endif
 #endif /* DIO_H */
\ No newline at end of file
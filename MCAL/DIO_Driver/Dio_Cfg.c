@@ -0,0 +1,47 @@
+/**********************************************************
+ * @file    Dio_Cfg.c
+ * @brief   DIO Driver Configuration Source File (sinh tự động)
+ * @details File được sinh bởi MCAL/Generator/McalCfgGen.py từ
+ *          MCAL/Generator/Board.json. Không sửa tay: sửa file mô tả rồi chạy
+ *          'make gen'.
+ **********************************************************/
+#include "Dio_Cfg.h"
+
+/* Một phần tử của bảng: GPIOx và mặt nạ chân của kênh (+ alias bit-band nếu bật) */
+#if (DIO_BITBAND_ACCESS == STD_ON)
+#define DIO_CHANNEL_CFG(ChannelId)  { DIO_CFG_PORT(ChannelId), DIO_CFG_MASK(ChannelId), \
+                                      DIO_CFG_IDR_BIT(ChannelId), DIO_CFG_ODR_BIT(ChannelId) }
+#else
+#define DIO_CHANNEL_CFG(ChannelId)  { DIO_CFG_PORT(ChannelId), DIO_CFG_MASK(ChannelId) }
+#endif
+
+/* Bảng phân giải kênh: chỉ số là ChannelId (0–63) */
+const Dio_ChannelCfgType Dio_ChannelCfg[DIO_NUM_CHANNELS] = {
+    /* GPIOA */
+    DIO_CHANNEL_CFG(0), DIO_CHANNEL_CFG(1), DIO_CHANNEL_CFG(2), DIO_CHANNEL_CFG(3),
+    DIO_CHANNEL_CFG(4), DIO_CHANNEL_CFG(5), DIO_CHANNEL_CFG(6), DIO_CHANNEL_CFG(7),
+    DIO_CHANNEL_CFG(8), DIO_CHANNEL_CFG(9), DIO_CHANNEL_CFG(10), DIO_CHANNEL_CFG(11),
+    DIO_CHANNEL_CFG(12), DIO_CHANNEL_CFG(13), DIO_CHANNEL_CFG(14), DIO_CHANNEL_CFG(15),
+    /* GPIOB */
+    DIO_CHANNEL_CFG(16), DIO_CHANNEL_CFG(17), DIO_CHANNEL_CFG(18), DIO_CHANNEL_CFG(19),
+    DIO_CHANNEL_CFG(20), DIO_CHANNEL_CFG(21), DIO_CHANNEL_CFG(22), DIO_CHANNEL_CFG(23),
+    DIO_CHANNEL_CFG(24), DIO_CHANNEL_CFG(25), DIO_CHANNEL_CFG(26), DIO_CHANNEL_CFG(27),
+    DIO_CHANNEL_CFG(28), DIO_CHANNEL_CFG(29), DIO_CHANNEL_CFG(30), DIO_CHANNEL_CFG(31),
+    /* GPIOC */
+    DIO_CHANNEL_CFG(32), DIO_CHANNEL_CFG(33), DIO_CHANNEL_CFG(34), DIO_CHANNEL_CFG(35),
+    DIO_CHANNEL_CFG(36), DIO_CHANNEL_CFG(37), DIO_CHANNEL_CFG(38), DIO_CHANNEL_CFG(39),
+    DIO_CHANNEL_CFG(40), DIO_CHANNEL_CFG(41), DIO_CHANNEL_CFG(42), DIO_CHANNEL_CFG(43),
+    DIO_CHANNEL_CFG(44), DIO_CHANNEL_CFG(45), DIO_CHANNEL_CFG(46), DIO_CHANNEL_CFG(47),
+    /* GPIOD */
+    DIO_CHANNEL_CFG(48), DIO_CHANNEL_CFG(49), DIO_CHANNEL_CFG(50), DIO_CHANNEL_CFG(51),
+    DIO_CHANNEL_CFG(52), DIO_CHANNEL_CFG(53), DIO_CHANNEL_CFG(54), DIO_CHANNEL_CFG(55),
+    DIO_CHANNEL_CFG(56), DIO_CHANNEL_CFG(57), DIO_CHANNEL_CFG(58), DIO_CHANNEL_CFG(59),
+    DIO_CHANNEL_CFG(60), DIO_CHANNEL_CFG(61), DIO_CHANNEL_CFG(62), DIO_CHANNEL_CFG(63)
+};
+
+#if (DIO_DEBOUNCE_API == STD_ON)
+/* Ngưỡng debounce theo kênh (số lần gọi Dio_DebounceMainFunction liên tiếp) */
+const uint8 Dio_DebounceThreshold[DIO_NUM_CHANNELS] = {
+    [DIO_CHANEL_24] = 4u,   // PB8 - Input, 4 mẫu
+};
+#endif
@@ -0,0 +1,165 @@
+/***********************************************************
+ *  @file    Dio_Cfg.h
+ *  @brief   DIO Driver Configuration Header File
+ *  @details File này chứa bảng phân giải kênh DIO (ChannelId -> GPIOx, mặt nạ chân)
+ *           và các hàm truy cập inline cho từng kênh đặt tên.
+ *           Với kênh đặt tên, port và mặt nạ là hằng số lúc biên dịch nên
+ *           mỗi lần đọc/ghi chỉ còn một lệnh load hoặc store.
+ *           Khi DIO_BITBAND_ACCESS = STD_ON, địa chỉ alias bit-band của IDR/ODR
+ *           cũng được tính sẵn cho từng kênh.
+ *
+ *  @note    Mapping cố định của STM32F103: kênh 0–15 = PA0–PA15,
+ *           16–31 = PB0–PB15, 32–47 = PC0–PC15, 48–63 = PD0–PD15.
+ *           Dio_Cfg.c và các khối GENERATED ở đây do McalCfgGen.py sinh.
+ *
+ *  @version 1.0
+ *  @date    2025-06-18
+ ***********************************************************/
+
+#ifndef DIO_CFG_H
+#define DIO_CFG_H
+
+#include "Dio_Types.h"  /* Các kiểu dữ liệu của DIO Driver (không include Dio.h) */
+
+/***********************************************************
+ * Số lượng kênh / port của DIO
+ ***********************************************************/
+#define DIO_NUM_CHANNELS    64u     // 4 port x 16 chân
+#define DIO_NUM_PORTS       4u      // GPIOA..GPIOD
+
+/***********************************************************
+ * Bật/tắt chế độ ghi trễ (shadow image + Dio_Commit)
+ ***********************************************************/
+#define DIO_DEFERRED_WRITE_API  STD_ON
+
+/***********************************************************
+ * Bật/tắt snapshot đầu vào (Dio_SnapshotInputs + đọc từ ảnh đã chốt)
+ ***********************************************************/
+#define DIO_INPUT_SNAPSHOT_API  STD_ON
+
+/***********************************************************
+ * Phát mẫu bit ra port bằng DMA (Dio_StreamPort)
+ * - Timer tạo nhịp: request Update của timer kích DMA ghi một word vào BSRR.
+ * - Timer phải nằm trên APB1 (TIM2..TIM4) và không được dùng cho PWM.
+ * - Kênh DMA phải đúng kênh nhận request TIMx_UP (RM0008 bảng 78):
+ *   TIM2_UP -> DMA1_Channel2, TIM3_UP -> DMA1_Channel3, TIM4_UP -> DMA1_Channel7.
+ ***********************************************************/
+#define DIO_STREAM_API                  STD_ON
+#define DIO_STREAM_TIMER                TIM4
+#define DIO_STREAM_TIMER_CLOCK          CLOCK_TIM4      /* Clock_IdType của DIO_STREAM_TIMER */
+#define DIO_STREAM_DMA_CHANNEL          DMA1_Channel7
+#define DIO_STREAM_DMA_CHANNEL_NUM      7u
+#define DIO_STREAM_DMA_IRQn             DMA1_Channel7_IRQn
+#define DIO_STREAM_DMA_IRQHandler       DMA1_Channel7_IRQHandler
+#define DIO_STREAM_IRQ_PRIORITY         1u      // Mức ưu tiên ngắt DMA (nửa buffer/hết buffer)
+
+/* Callback (void (*)(void)) khi phát xong nửa đầu / toàn bộ buffer, NULL_PTR nếu không dùng */
+#define DIO_STREAM_HALF_NOTIFICATION    NULL_PTR
+#define DIO_STREAM_DONE_NOTIFICATION    NULL_PTR
+
+/***********************************************************
+ * Lọc nhiễu (debounce) đầu vào bằng bộ đếm dọc (vertical counter)
+ * Ngưỡng mỗi kênh = số mẫu liên tiếp khác trạng thái cần để đổi mức,
+ * 1..DIO_DEBOUNCE_MAX_THRESHOLD (0 được coi như 1: không lọc).
+ ***********************************************************/
+#define DIO_DEBOUNCE_API                STD_ON
+#define DIO_DEBOUNCE_MAX_THRESHOLD      7u      // bộ đếm 3 bit-plane
+
+extern const uint8 Dio_DebounceThreshold[DIO_NUM_CHANNELS];
+
+/***********************************************************
+ * Thông báo thay đổi đầu vào qua EXTI
+ * - ISR chỉ đẩy sự kiện {kênh, cạnh, timestamp} vào hàng đợi vòng
+ *   một-producer/một-consumer; vòng lặp chính lấy ra theo lô.
+ * - Tất cả ngắt EXTI dùng chung một mức ưu tiên để không lồng nhau,
+ *   nhờ vậy chúng là một producer duy nhất của hàng đợi.
+ ***********************************************************/
+#define DIO_NOTIFICATION_API            STD_ON
+#define DIO_EVENT_QUEUE_SIZE            32u     // Lũy thừa của 2, tối đa 128
+#define DIO_NOTIFICATION_IRQ_PRIORITY   2u
+
+/***********************************************************
+ * Các kênh DIO đặt tên (symbolic channel)
+ * (MCAL/Generator/McalCfgGen.py sinh lại từ "dio.channels")
+ ***********************************************************/
+/* GENERATED BEGIN Channels */
+#define DIO_CHANEL_24 24    // PB8 - Input
+#define DIO_CHANEL_45 45    // PC13 - LED output
+/* GENERATED END Channels */
+
+/***********************************************************
+ * Bảng phân giải kênh (định nghĩa ở Dio_Cfg.c)
+ ***********************************************************/
+extern const Dio_ChannelCfgType Dio_ChannelCfg[DIO_NUM_CHANNELS];
+
+/***********************************************************
+ * Phân giải kênh lúc biên dịch (chỉ dùng với hằng số)
+ ***********************************************************/
+#define DIO_CFG_PORT(ChannelId)     (((ChannelId) < 16) ? GPIOA : \
+                                     ((ChannelId) < 32) ? GPIOB : \
+                                     ((ChannelId) < 48) ? GPIOC : GPIOD)
+#define DIO_CFG_MASK(ChannelId)     ((uint16)(1u << ((ChannelId) % 16)))
+#define DIO_CFG_PORT_ADDR(ChannelId) (((ChannelId) < 16) ? GPIOA_BASE : \
+                                      ((ChannelId) < 32) ? GPIOB_BASE : \
+                                      ((ChannelId) < 48) ? GPIOC_BASE : GPIOD_BASE)
+
+/***********************************************************
+ * Địa chỉ alias bit-band của một bit thanh ghi ngoại vi (RM0008 mục 3.3.3)
+ * alias = PERIPH_BB_BASE + (địa chỉ byte - PERIPH_BASE) * 32 + bit * 4
+ ***********************************************************/
+#define DIO_IDR_OFFSET              0x08u
+#define DIO_ODR_OFFSET              0x0Cu
+#define DIO_BITBAND_ALIAS(RegAddr, Bit) \
+    ((uint32)PERIPH_BB_BASE + (((uint32)(RegAddr) - (uint32)PERIPH_BASE) * 32u) + ((uint32)(Bit) * 4u))
+#define DIO_CFG_IDR_BIT(ChannelId)  ((volatile uint32 *)DIO_BITBAND_ALIAS( \
+                                     DIO_CFG_PORT_ADDR(ChannelId) + DIO_IDR_OFFSET, (ChannelId) % 16))
+#define DIO_CFG_ODR_BIT(ChannelId)  ((volatile uint32 *)DIO_BITBAND_ALIAS( \
+                                     DIO_CFG_PORT_ADDR(ChannelId) + DIO_ODR_OFFSET, (ChannelId) % 16))
+
+/***********************************************************
+ * Sinh các hàm truy cập inline cho một kênh đặt tên
+ * VD: DIO_DEFINE_CHANNEL_ACCESSORS(DIO_CHANEL_45) tạo ra
+ *     Dio_ReadChannel_45(), Dio_WriteChannel_45(Level), Dio_FlipChannel_45()
+ ***********************************************************/
+#define DIO_DEFINE_CHANNEL_ACCESSORS(ChannelId)  DIO_DEFINE_CHANNEL_ACCESSORS_(ChannelId)
+#if (DIO_BITBAND_ACCESS == STD_ON)
+#define DIO_DEFINE_CHANNEL_ACCESSORS_(ChannelId)                                        \
+static inline Dio_LevelType Dio_ReadChannel_##ChannelId(void)                           \
+{                                                                                       \
+    return (Dio_LevelType)(*DIO_CFG_IDR_BIT(ChannelId));                                \
+}                                                                                       \
+static inline void Dio_WriteChannel_##ChannelId(Dio_LevelType Level)                    \
+{                                                                                       \
+    *DIO_CFG_ODR_BIT(ChannelId) = (Level == STD_HIGH) ? 1u : 0u;                        \
+}                                                                                       \
+static inline void Dio_FlipChannel_##ChannelId(void)                                    \
+{                                                                                       \
+    *DIO_CFG_ODR_BIT(ChannelId) ^= 1u;                                                  \
+}
+#else
+#define DIO_DEFINE_CHANNEL_ACCESSORS_(ChannelId)                                        \
+static inline Dio_LevelType Dio_ReadChannel_##ChannelId(void)                           \
+{                                                                                       \
+    return ((DIO_CFG_PORT(ChannelId)->IDR & DIO_CFG_MASK(ChannelId)) != 0u) ?           \
+           STD_HIGH : STD_LOW;                                                          \
+}                                                                                       \
+static inline void Dio_WriteChannel_##ChannelId(Dio_LevelType Level)                    \
+{                                                                                       \
+    if (Level == STD_HIGH) DIO_CFG_PORT(ChannelId)->BSRR = DIO_CFG_MASK(ChannelId);     \
+    else                   DIO_CFG_PORT(ChannelId)->BRR  = DIO_CFG_MASK(ChannelId);     \
+}                                                                                       \
+static inline void Dio_FlipChannel_##ChannelId(void)                                    \
+{                                                                                       \
+    if ((DIO_CFG_PORT(ChannelId)->ODR & DIO_CFG_MASK(ChannelId)) != 0u)                 \
+        DIO_CFG_PORT(ChannelId)->BRR  = DIO_CFG_MASK(ChannelId);                        \
+    else                                                                                \
+        DIO_CFG_PORT(ChannelId)->BSRR = DIO_CFG_MASK(ChannelId);                        \
+}
+#endif
+
+/* GENERATED BEGIN Accessors */
+DIO_DEFINE_CHANNEL_ACCESSORS(DIO_CHANEL_24)
+DIO_DEFINE_CHANNEL_ACCESSORS(DIO_CHANEL_45)
+/* GENERATED END Accessors */
+
+#endif /* DIO_CFG_H */
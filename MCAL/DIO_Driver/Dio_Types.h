@@ -0,0 +1,145 @@
+/***************************************************************************
+ * @file    Dio_Types.h
+ * @brief   Các kiểu dữ liệu dùng chung của DIO Driver
+ * @details Tách khỏi Dio.h để Dio_Cfg.h (bảng kênh, hàm truy cập inline) chỉ
+ *          cần include file này. Chiều include một chiều:
+ *          Dio.h -> Dio_Cfg.h -> Dio_Types.h.
+ * @version 1.0
+ * @date    18-06-2025
+ ***************************************************************************/
+#ifndef DIO_TYPES_H
+#define DIO_TYPES_H
+
+#include "Std_Type.h"
+#include "stm32f10x.h"
+/*--------------------------------------------------
+ * Dio_ChannelType Definition
+ *--------------------------------------------------*/
+typedef uint8 Dio_ChannelType;  // Use uint8 if < 256 channels, else uint16 (48 channels (pins))
+
+typedef uint8 Dio_PortType;  // Được sử dụng để chỉ định cụ thể loại port A,B,C,D
+
+/*--------------------------------------------------
+ * Dio_ChannelGroupType Definition
+ * @brief
+ * @details Type for the definition of a channel group, which consists of several adjoining channels within a port.
+ *--------------------------------------------------*/
+typedef struct
+{
+    uint8 mask;         //This element mask which defines the positions of the channel group.
+    uint8 offset;       //This element shall be the position of the Channel Group on the port,counted from the LSB.
+    Dio_PortType port;
+} Dio_ChannelGroupType; //This shall be the port on which the Channel group is defined
+
+/*--------------------------------------------------
+ * Dio_LevelType Definition
+ * @details Là mức điện áp của GPIO
+ *--------------------------------------------------*/
+typedef uint8 Dio_LevelType;
+
+/*--------------------------------------------------
+ * Dio_PortLevelType Definition
+ * @details Sẽ in ra tất các giá trị của 1 groupt A,B,C,D dưới dạng 0 1,và phải kiểu dữ liệu phải cover groupt lớn nhất
+ *--------------------------------------------------*/
+typedef uint16 Dio_PortLevelType;
+
+/*--------------------------------------------------
+ * Dio_WriteModeType Definition
+ * @details DIO_WRITE_IMMEDIATE: mỗi API ghi ra thanh ghi ngay (mặc định).
+ *          DIO_WRITE_DEFERRED : các API ghi chỉ cập nhật ảnh shadow trong RAM,
+ *                               Dio_Commit() xuất tất cả bằng một lệnh BSRR mỗi port.
+ *--------------------------------------------------*/
+typedef enum
+{
+    DIO_WRITE_IMMEDIATE = 0x00,
+    DIO_WRITE_DEFERRED  = 0x01
+} Dio_WriteModeType;
+
+/*--------------------------------------------------
+ * Dio_ReadModeType Definition
+ * @details DIO_READ_LIVE    : các API đọc truy cập IDR ngay lúc gọi (mặc định).
+ *          DIO_READ_SNAPSHOT: các API đọc trả về giá trị chốt bởi Dio_SnapshotInputs().
+ *--------------------------------------------------*/
+typedef enum
+{
+    DIO_READ_LIVE     = 0x00,
+    DIO_READ_SNAPSHOT = 0x01
+} Dio_ReadModeType;
+
+/*--------------------------------------------------
+ * Dio_StreamModeType Definition
+ * @details DIO_STREAM_ONE_SHOT     : phát buffer một lần rồi dừng timer.
+ *          DIO_STREAM_CIRCULAR     : phát lặp vòng liên tục, không cần CPU.
+ *          DIO_STREAM_DOUBLE_BUFFER: lặp vòng, báo ở nửa buffer và cuối buffer
+ *                                    để ứng dụng nạp lại nửa vừa phát xong.
+ *--------------------------------------------------*/
+typedef enum
+{
+    DIO_STREAM_ONE_SHOT      = 0x00,
+    DIO_STREAM_CIRCULAR      = 0x01,
+    DIO_STREAM_DOUBLE_BUFFER = 0x02
+} Dio_StreamModeType;
+
+/* Kiểu callback báo trạng thái phát DMA */
+typedef void (*Dio_StreamNotificationType)(void);
+
+/*--------------------------------------------------
+ * Dio_EdgeType Definition
+ * @details Cạnh tín hiệu dùng cho thông báo EXTI.
+ *--------------------------------------------------*/
+typedef enum
+{
+    DIO_EDGE_RISING  = 0x01,
+    DIO_EDGE_FALLING = 0x02,
+    DIO_EDGE_BOTH    = 0x03
+} Dio_EdgeType;
+
+/*--------------------------------------------------
+ * Dio_EventType Definition
+ * @details Một sự kiện thay đổi đầu vào do ISR EXTI ghi nhận.
+ *--------------------------------------------------*/
+typedef struct
+{
+    uint32 timestamp;           // DWT CYCCNT lúc vào ISR
+    Dio_ChannelType channel;    // Kênh DIO (0–63)
+    Dio_EdgeType edge;          // Cạnh lên/xuống (line bắt cả hai cạnh: theo mức IDR trong ISR)
+} Dio_EventType;
+
+/*--------------------------------------------------
+ * Chọn backend truy cập kênh lúc biên dịch
+ * @details STD_ON: Dio_ReadChannel/Dio_WriteChannel/Dio_FlipChannel dùng vùng
+ *          alias bit-band của Cortex-M3 (mỗi bit là một word riêng, một lệnh
+ *          load/store, không cần mask). STD_OFF: dùng IDR/ODR/BSRR như thường.
+ *--------------------------------------------------*/
+#ifndef DIO_BITBAND_ACCESS
+#define DIO_BITBAND_ACCESS  STD_OFF
+#endif
+
+/*--------------------------------------------------
+ * Dio_ChannelCfgType Definition
+ * @details Một phần tử của bảng phân giải kênh: ChannelId -> {GPIOx, mặt nạ chân}.
+ *          Bảng được sinh sẵn trong Dio_Cfg.c nên không phải tính lúc chạy.
+ *--------------------------------------------------*/
+typedef struct
+{
+    GPIO_TypeDef *port;     // Địa chỉ thanh ghi GPIOx chứa kênh
+    uint16 mask;            // Mặt nạ bit của chân trong port (1 << pin)
+#if (DIO_BITBAND_ACCESS == STD_ON)
+    volatile uint32 *idrBit;    // Địa chỉ alias bit-band của bit IDR
+    volatile uint32 *odrBit;    // Địa chỉ alias bit-band của bit ODR
+#endif
+} Dio_ChannelCfgType;
+/*--------------------------------------------------
+ * Giá trị hợp lệ cho Dio_LevelType (Range)
+ *--------------------------------------------------*/
+#define STD_LOW     0x00U  // Mức điện áp 0V (Logic 0)
+#define STD_HIGH    0x01U  // Mức điện áp 5V/3.3V (Logic 1)
+
+/*--------------------------------------------------
+ * Mô tả (Description):
+ * - Dio_LevelType đại diện cho trạng thái vật lý của chân DIO (input/output).
+ * - STD_LOW  = 0V (hoặc GND)
+ * - STD_HIGH = 5V/3.3V (tùy MCU)
+ *--------------------------------------------------*/
+
+#endif /* DIO_TYPES_H */
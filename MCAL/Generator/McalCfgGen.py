@@ -0,0 +1,601 @@
+#!/usr/bin/env python3
+"""
+@file    McalCfgGen.py
+@brief   Sinh port_cfg.c, Pwm_cfg.c và Dio_Cfg.c từ file mô tả chân/timer (JSON)
+@details Chạy trên máy host lúc build (make gen). Kiểm tra mô tả với bảng
+         TIM/chân/remap trong PWM_Driver/mapping_.txt, rồi sinh:
+           - Port_ConfigSets: mỗi bộ cấu hình post-build ("portSets") gồm
+             bảng chân đóng gói và ảnh CRL/CRH/ODR tính sẵn, cùng quy tắc
+             với Port_GetPinNibble/Port_BuildRegImages
+           - pwmChannelscfg với địa chỉ CCR tính sẵn cho từng kênh
+           - bảng kênh DIO (Dio_ChannelCfg) và ngưỡng debounce theo kênh
+           - khối GENERATED trong Port_Cfg.h (Pincount, PORT_CONFIG_SET_xxx),
+             Dio_Cfg.h (tên kênh "dio.channels" và hàm truy cập inline của
+             chúng) và PinPWM trong Pwm_cfg.h
+         Mọi lỗi được in ra cùng lúc và không file nào bị ghi nếu còn lỗi.
+
+         Cách dùng: python3 McalCfgGen.py <board.json> [--check]
+@version 1.0
+"""
+
+import json
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+MCAL = os.path.dirname(HERE)
+
+MAPPING_FILE = os.path.join(MCAL, "PWM_Driver", "mapping_.txt")
+PORT_CFG_C = os.path.join(MCAL, "Port_Driver", "Port_Cfg.c")
+PORT_CFG_H = os.path.join(MCAL, "Port_Driver", "Port_Cfg.h")
+PWM_CFG_C = os.path.join(MCAL, "PWM_Driver", "Pwm_cfg.c")
+PWM_CFG_H = os.path.join(MCAL, "PWM_Driver", "Pwm_cfg.h")
+DIO_CFG_C = os.path.join(MCAL, "DIO_Driver", "Dio_Cfg.c")
+DIO_CFG_H = os.path.join(MCAL, "DIO_Driver", "Dio_Cfg.h")
+
+PORT_NAMES = "ABCD"
+
+# Giá trị khớp với Port.h / SPL
+PIN_MODES = {"DIO": "PORT_PIN_MODE_DIO", "ADC": "PORT_PIN_MODE_ADC", "PWM": "PORT_PIN_MODE_PWM"}
+DIRECTIONS = {"IN": "PORT_PIN_IN", "OUT": "PORT_PIN_OUT"}
+SPEEDS = {"10MHz": ("GPIO_Speed_10MHz", 1), "2MHz": ("GPIO_Speed_2MHz", 2), "50MHz": ("GPIO_Speed_50MHz", 3)}
+PULLS = {"UP": "PULL_UP", "DOWN": "PULL_DOWN"}
+LEVELS = {"HIGH": "PORT_PIN_LEVEL_HIGH", "LOW": "PORT_PIN_LEVEL_LOW"}
+
+PWM_CLASSES = {"VARIABLE_PERIOD": "PWM_VARIABLE_PERIOD",
+               "FIXED_PERIOD": "PWM_FIXED_PERIOD",
+               "FIXED_PERIOD_SHIFTED": "PWM_FIXED_PERIOD_SHIFTED"}
+PWM_STATES = {"HIGH": "PWM_HIGH", "LOW": "PWM_LOW"}
+
+# Nibble CNF/MODE, RM0008 mục 9.2.1 (trùng PORT_CNF_* trong Port.c)
+CNF_IN_ANALOG = 0x0
+CNF_IN_PULL = 0x8
+CNF_OUT_PP = 0x0
+CNF_OUT_OD = 0x4
+CNF_AF_PP = 0x8
+
+GEN_BEGIN = "/* GENERATED BEGIN %s */"
+GEN_END = "/* GENERATED END %s */"
+
+# Trùng DIO_DEBOUNCE_MAX_THRESHOLD trong Dio_Cfg.h (bộ đếm dọc 3 bit-plane)
+DIO_DEBOUNCE_MAX = 7
+
+USER_BEGIN = "/* USER CODE BEGIN Callbacks */"
+USER_END = "/* USER CODE END Callbacks */"
+
+C_IDENT = re.compile(r"^[A-Za-z_][A-Za-z0-9_]*$")
+
+
+class Errors(list):
+    def add(self, where, msg):
+        self.append("%s: %s" % (where, msg))
+
+
+def parse_pin(name):
+    """'PC13' -> (2, 13); None nếu sai định dạng"""
+    m = re.match(r"^P([A-D])(\d{1,2})$", str(name))
+    if not m or int(m.group(2)) > 15:
+        return None
+    return PORT_NAMES.index(m.group(1)), int(m.group(2))
+
+
+def load_mapping(path):
+    """Đọc mapping_.txt: {(timer, ch): (chân mặc định, chân remap hoặc None)};
+    chân bù CHxN có khóa (timer, ch, "N")"""
+    table = {}
+    rx = re.compile(r"^(TIM\d)\s+CH(\d)(N?)\s+(P[A-D]\d+)(?:.*remap:\s*(P[A-D]\d+))?")
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            m = rx.match(line.strip())
+            if m:
+                key = (m.group(1), int(m.group(2))) + (("N",) if m.group(3) else ())
+                table[key] = (m.group(4), m.group(5))
+    return table
+
+
+def pick(errs, where, entry, key, choices, default=None):
+    val = entry.get(key, default)
+    if val not in choices:
+        errs.add(where, "'%s' = %r không hợp lệ, chọn một trong %s" % (key, val, "/".join(choices)))
+        return None
+    return val
+
+
+# ---------------------------------------------------------------------------
+#  Kiểm tra mô tả
+# ---------------------------------------------------------------------------
+
+def check_sets(desc, errs):
+    """Trả về [(tên bộ, danh sách chân)]; "port" đơn lẻ là bộ DEFAULT"""
+    raw = desc.get("portSets")
+    if raw is None:
+        raw = [{"name": "DEFAULT", "pins": desc.get("port", [])}]
+    sets = []
+    names = set()
+    for i, st in enumerate(raw):
+        name = str(st.get("name", ""))
+        if not re.match(r"^[A-Z][A-Z0-9_]*$", name) or name in names:
+            errs.add("portSets[%d]" % i, "tên bộ %r phải là chữ hoa, duy nhất" % name)
+            continue
+        names.add(name)
+        sets.append((name, check_port(st.get("pins", []), "%s.pins" % name, errs)))
+    if not sets:
+        errs.add("portSets", "cần ít nhất một bộ cấu hình")
+    return sets
+
+
+def check_port(entries, prefix, errs):
+    pins = []
+    seen = {}
+    for i, e in enumerate(entries):
+        where = "%s[%d]" % (prefix, i)
+        loc = parse_pin(e.get("pin"))
+        if loc is None:
+            errs.add(where, "chân %r không hợp lệ (PA0..PD15)" % e.get("pin"))
+            continue
+        if loc in seen:
+            errs.add(where, "chân %s đã được cấu hình ở %s[%d]" % (e["pin"], prefix, seen[loc]))
+            continue
+        seen[loc] = i
+        pin = {
+            "name": e["pin"], "port": loc[0], "bit": loc[1],
+            "mode": pick(errs, where, e, "mode", PIN_MODES),
+            "direction": pick(errs, where, e, "direction", DIRECTIONS),
+            "speed": pick(errs, where, e, "speed", SPEEDS, "2MHz"),
+            "pull": pick(errs, where, e, "pull", PULLS, "DOWN"),
+            "level": pick(errs, where, e, "level", LEVELS, "LOW"),
+            "directionChangeable": bool(e.get("directionChangeable", False)),
+            "modeChangeable": bool(e.get("modeChangeable", False)),
+        }
+        if pin["mode"] == "PWM" and pin["direction"] != "OUT":
+            errs.add(where, "chân PWM %s phải là OUT" % e["pin"])
+        pins.append(pin)
+    return pins
+
+
+def check_complementary(e, key, mapping, by_name, where, errs):
+    """Chân bù CHxN (chỉ TIM1 CH1..CH3): trả về tên chân hoặc None"""
+    pin = e.get("complementaryPin")
+    if pin is None:
+        return None
+    nkey = key + ("N",)
+    if nkey not in mapping:
+        errs.add(where, "%s_CH%dN không có trong mapping_.txt (chỉ TIM1 CH1..CH3)" % key)
+        return None
+    default_pin, remap_pin = mapping[nkey]
+    if pin != default_pin:
+        errs.add(where, "%s_CH%dN nằm trên %s%s, không phải %s (driver chưa cấu hình remap)"
+                 % (key + (default_pin, " (remap %s)" % remap_pin if remap_pin else "", pin)))
+        return None
+    p = by_name.get(pin)
+    if p is None or p["mode"] != "PWM":
+        errs.add(where, "chân bù %s phải có mode PWM trong bộ cấu hình mặc định" % pin)
+    return pin
+
+
+def check_phase(e, cls, where, errs):
+    """Pha của kênh shifted: phaseTicks (tick) hoặc phaseDeg (độ, lưu 1/100 độ)"""
+    if "phaseTicks" in e and "phaseDeg" in e:
+        errs.add(where, "chỉ dùng một trong phaseTicks/phaseDeg")
+        return 0, "PWM_PHASE_TICKS"
+    if ("phaseTicks" in e or "phaseDeg" in e) and cls != "FIXED_PERIOD_SHIFTED":
+        errs.add(where, "pha chỉ dùng được với class FIXED_PERIOD_SHIFTED")
+        return 0, "PWM_PHASE_TICKS"
+    if "phaseDeg" in e:
+        deg = e["phaseDeg"]
+        if not isinstance(deg, (int, float)) or not 0 <= deg < 360:
+            errs.add(where, "phaseDeg %r ngoài khoảng 0..<360" % deg)
+            return 0, "PWM_PHASE_TICKS"
+        return int(round(deg * 100)) % 36000, "PWM_PHASE_CENTIDEGREES"
+    ticks = e.get("phaseTicks", 0)
+    if not isinstance(ticks, int) or not 0 <= ticks <= 0xFFFF:
+        errs.add(where, "phaseTicks %r ngoài khoảng 0..65535" % ticks)
+        ticks = 0
+    return ticks, "PWM_PHASE_TICKS"
+
+
+def check_pwm(desc, sets, mapping, errs):
+    """Kênh PWM kiểm tra với bộ cấu hình đầu tiên (bộ mặc định)"""
+    chans = []
+    used = {}
+    periods = {}
+    freqs = {}
+    shifted = {}
+    by_name = {p["name"]: p for p in sets[0][1]} if sets else {}
+    for i, e in enumerate(desc.get("pwm", [])):
+        where = "pwm[%d]" % i
+        tim, ch = e.get("timer"), e.get("channel")
+        key = (tim, ch)
+        if key not in mapping:
+            errs.add(where, "%s_CH%s không có trong mapping_.txt" % (tim, ch))
+            continue
+        if key in used:
+            errs.add(where, "%s_CH%d đã dùng ở pwm[%d]" % (tim, ch, used[key]))
+            continue
+        used[key] = i
+
+        default_pin, remap_pin = mapping[key]
+        pin = e.get("pin")
+        if pin == remap_pin:
+            errs.add(where, "%s là chân remap của %s_CH%d; driver chưa cấu hình AFIO->MAPR, dùng %s"
+                     % (pin, tim, ch, default_pin))
+        elif pin != default_pin:
+            errs.add(where, "%s_CH%d nằm trên %s%s, không phải %s"
+                     % (tim, ch, default_pin, " (remap %s)" % remap_pin if remap_pin else "", pin))
+
+        p = by_name.get(pin)
+        if p is None:
+            errs.add(where, "chân %s chưa có trong bộ cấu hình mặc định" % pin)
+        elif p["mode"] != "PWM":
+            errs.add(where, "chân %s phải có mode PWM trong bộ cấu hình mặc định" % pin)
+
+        period = e.get("period")
+        if not isinstance(period, int) or not 1 <= period <= 0xFFFF:
+            errs.add(where, "period %r ngoài khoảng 1..65535" % period)
+            period = None
+        elif tim in periods and periods[tim][0] != period:
+            errs.add(where, "%s dùng chung ARR: period %d khác %d ở pwm[%d]"
+                     % (tim, period, periods[tim][0], periods[tim][1]))
+        else:
+            periods.setdefault(tim, (period, i))
+
+        freq = e.get("frequency", 0)
+        if not isinstance(freq, int) or freq < 0:
+            errs.add(where, "frequency %r phải là số nguyên Hz >= 0" % freq)
+            freq = 0
+        elif tim in freqs and freqs[tim][0] != freq:
+            errs.add(where, "%s dùng chung PSC/ARR: frequency %d khác %d ở pwm[%d]"
+                     % (tim, freq, freqs[tim][0], freqs[tim][1]))
+        else:
+            freqs.setdefault(tim, (freq, i))
+
+        duty = e.get("duty", 0)
+        if not isinstance(duty, int) or not 0 <= duty <= 0x8000:
+            errs.add(where, "duty %r ngoài khoảng 0..0x8000" % duty)
+        compare = e.get("compare", 0)
+        if not isinstance(compare, int) or compare < 0 or (period is not None and compare > period):
+            errs.add(where, "compare %r ngoài khoảng 0..period" % compare)
+
+        cb = e.get("notification")
+        if cb is not None and not C_IDENT.match(str(cb)):
+            errs.add(where, "notification %r không phải tên hàm C" % cb)
+
+        npin = check_complementary(e, key, mapping, by_name, where, errs)
+
+        cls = pick(errs, where, e, "class", PWM_CLASSES, "VARIABLE_PERIOD")
+        phase, unit = check_phase(e, cls, where, errs)
+        # Cả timer chạy center-aligned: mọi kênh của nó là shifted và cùng một pha
+        if tim in shifted and (shifted[tim][0] != (cls == "FIXED_PERIOD_SHIFTED")
+                               or shifted[tim][1] != (phase, unit)):
+            errs.add(where, "%s dùng chung counter: class/pha khác pwm[%d]" % (tim, shifted[tim][2]))
+        else:
+            shifted.setdefault(tim, (cls == "FIXED_PERIOD_SHIFTED", (phase, unit), i))
+
+        chans.append({
+            "timer": tim, "channel": ch, "pin": pin,
+            "class": cls, "phase": phase, "phaseUnit": unit, "npin": npin,
+            "npolarity": pick(errs, where, e, "complementaryPolarity", PWM_STATES, "HIGH"),
+            "period": period, "frequency": freq, "duty": duty, "compare": compare,
+            "polarity": pick(errs, where, e, "polarity", PWM_STATES, "HIGH"),
+            "idle": pick(errs, where, e, "idle", PWM_STATES, "LOW"),
+            "notification": cb,
+        })
+
+    for name, pins in sets:
+        for p in pins:
+            if p["mode"] == "PWM" and p["name"] not in [c[k] for c in chans for k in ("pin", "npin")]:
+                errs.add(name, "chân %s mode PWM nhưng không có kênh PWM nào dùng" % p["name"])
+    return chans
+
+
+def check_dio(desc, errs):
+    """Kênh DIO đặt tên: tên macro, chân và ngưỡng debounce (tùy chọn)"""
+    chans = []
+    names = {}
+    pins = {}
+    for i, e in enumerate(desc.get("dio", {}).get("channels", [])):
+        where = "dio.channels[%d]" % i
+        name = str(e.get("name", ""))
+        if not re.match(r"^DIO_[A-Z0-9_]+$", name):
+            errs.add(where, "tên kênh %r phải có dạng DIO_XXX (chữ hoa)" % name)
+            continue
+        if name in names:
+            errs.add(where, "tên %s đã dùng ở dio.channels[%d]" % (name, names[name]))
+            continue
+        names[name] = i
+        loc = parse_pin(e.get("pin"))
+        if loc is None:
+            errs.add(where, "chân %r không hợp lệ (PA0..PD15)" % e.get("pin"))
+            continue
+        if loc in pins:
+            errs.add(where, "chân %s đã đặt tên ở dio.channels[%d]" % (e["pin"], pins[loc]))
+            continue
+        pins[loc] = i
+        debounce = e.get("debounce")
+        if debounce is not None and (not isinstance(debounce, int) or not 1 <= debounce <= DIO_DEBOUNCE_MAX):
+            errs.add(where, "debounce %r ngoài khoảng 1..%d" % (debounce, DIO_DEBOUNCE_MAX))
+            debounce = None
+        chans.append({"name": name, "pin": e["pin"], "id": loc[0] * 16 + loc[1],
+                      "comment": str(e.get("comment", "")), "debounce": debounce})
+    return chans
+
+
+# ---------------------------------------------------------------------------
+#  Ảnh thanh ghi (cùng quy tắc với Port_GetPinNibble / Port_BuildRegImages)
+# ---------------------------------------------------------------------------
+
+def pin_nibble(p):
+    speed = SPEEDS[p["speed"]][1]
+    if p["mode"] == "ADC":
+        return CNF_IN_ANALOG
+    if p["mode"] == "PWM":
+        return CNF_AF_PP | speed
+    if p["direction"] == "IN":
+        return CNF_IN_PULL
+    return (CNF_OUT_PP if p["pull"] == "UP" else CNF_OUT_OD) | speed
+
+
+def build_images(pins):
+    imgs = [dict(crl=0, crlMask=0, crh=0, crhMask=0, odr=0, odrMask=0) for _ in PORT_NAMES]
+    for p in pins:
+        img, bit = imgs[p["port"]], p["bit"]
+        reg = "crl" if bit < 8 else "crh"
+        shift = (bit % 8) * 4
+        img[reg] = (img[reg] & ~(0xF << shift)) | (pin_nibble(p) << shift)
+        img[reg + "Mask"] |= 0xF << shift
+
+        level = None
+        if p["direction"] == "OUT":
+            level = p["level"] == "HIGH"
+        elif p["mode"] == "DIO":
+            level = p["pull"] == "UP"
+        if level is not None:
+            img["odr"] = (img["odr"] & ~(1 << bit)) | (int(level) << bit)
+            img["odrMask"] |= 1 << bit
+    return imgs
+
+
+# ---------------------------------------------------------------------------
+#  Sinh file
+# ---------------------------------------------------------------------------
+
+def banner(name, brief, src):
+    return ("/**********************************************************\n"
+            " * @file    %s\n"
+            " * @brief   %s\n"
+            " * @details File được sinh bởi MCAL/Generator/McalCfgGen.py từ\n"
+            " *          %s. Không sửa tay: sửa file mô tả rồi chạy\n"
+            " *          'make gen'.\n"
+            " **********************************************************/\n" % (name, brief, src))
+
+
+def gen_port_c(sets, src):
+    out = [banner("Port_Cfg.c", "Port Driver Configuration Source File (sinh tự động)", src)]
+    out.append('#include "Port_Cfg.h"\n')
+
+    for name, pins in sets:
+        out.append("\n/* ==== Bộ cấu hình %s ==== */\n" % name)
+        out.append("static const Port_PinConfigType PortCfg_Pins_%s[] = {\n" % name)
+        rows = []
+        for p in pins:
+            rows.append(
+                "    /* %s */\n"
+                "    {\n"
+                "        .PortID = PORT_ID_%s,\n"
+                "        .PinID = %d,\n"
+                "        .PinMode = %s,\n"
+                "        .Direction = %s,\n"
+                "        .Speed = %s,\n"
+                "        .Pull = %s,\n"
+                "        .Level = %s,\n"
+                "        .DirectionChangeable = %d,\n"
+                "        .ModeChangeable = %d\n"
+                "    }" % (p["name"], PORT_NAMES[p["port"]], p["port"] * 16 + p["bit"],
+                         PIN_MODES[p["mode"]], DIRECTIONS[p["direction"]], SPEEDS[p["speed"]][0],
+                         PULLS[p["pull"]], LEVELS[p["level"]],
+                         int(p["directionChangeable"]), int(p["modeChangeable"])))
+        out.append(",\n".join(rows) + "\n};\n\n")
+
+        out.append("/* Ảnh thanh ghi tính sẵn: { crl, crlMask, crh, crhMask, odr, odrMask } */\n")
+        out.append("static const Port_RegImageType PortCfg_RegImages_%s[PORT_NUM_PORTS] = {\n" % name)
+        rows = []
+        for i, img in enumerate(build_images(pins)):
+            rows.append("    /* GPIO%s */ { 0x%08XuL, 0x%08XuL, 0x%08XuL, 0x%08XuL, 0x%04Xu, 0x%04Xu }"
+                        % (PORT_NAMES[i], img["crl"], img["crlMask"], img["crh"], img["crhMask"],
+                           img["odr"], img["odrMask"]))
+        out.append(",\n".join(rows) + "\n};\n")
+
+    out.append("\n/* ==== Các bộ cấu hình post-build ==== */\n")
+    out.append("const Port_ConfigType Port_ConfigSets[PORT_NUM_CONFIG_SETS] = {\n")
+    rows = []
+    for name, pins in sets:
+        rows.append("    [PORT_CONFIG_SET_%s] = {\n"
+                    "        .PinCfgType = PortCfg_Pins_%s,\n"
+                    "        .PortCfg_PinsCount = %d,\n"
+                    "        .RegImages = PortCfg_RegImages_%s\n"
+                    "    }" % (name, name, len(pins), name))
+    out.append(",\n".join(rows) + "\n};\n\n")
+
+    out.append("/* Mỗi chân chiếm đúng một word trong ROM */\n")
+    out.append("typedef char Port_PinConfigSizeCheck[(sizeof(Port_PinConfigType) == 4u) ? 1 : -1];\n")
+    return "".join(out)
+
+
+def replace_block(path, text, tag, lines):
+    """Thay nội dung khối GENERATED <tag> trong text bằng các dòng mới"""
+    begin, end = GEN_BEGIN % tag, GEN_END % tag
+    b, e = text.find(begin), text.find(end)
+    if b < 0 or e < b:
+        raise SystemExit("%s: không tìm thấy khối %s" % (path, begin))
+    return text[:b + len(begin)] + "\n" + "\n".join(lines) + "\n" + text[e:]
+
+
+def read_text(path):
+    with open(path, encoding="utf-8", newline="") as f:
+        return f.read().replace("\r\n", "\n")
+
+
+def gen_port_h(path, sets):
+    """Sinh lại khối GENERATED trong Port_Cfg.h"""
+    lines = ["#define Pincount     %d      // Số chân của bộ cấu hình lớn nhất"
+             % max(len(p) for _, p in sets),
+             "#define PORT_NUM_CONFIG_SETS        %du" % len(sets)]
+    for i, (name, _) in enumerate(sets):
+        lines.append("#define %-27s %du" % ("PORT_CONFIG_SET_" + name, i))
+    return replace_block(path, read_text(path), "ConfigSets", lines)
+
+
+def gen_dio_c(chans, src):
+    out = [banner("Dio_Cfg.c", "DIO Driver Configuration Source File (sinh tự động)", src)]
+    out.append('#include "Dio_Cfg.h"\n\n')
+    out.append("/* Một phần tử của bảng: GPIOx và mặt nạ chân của kênh (+ alias bit-band nếu bật) */\n"
+               "#if (DIO_BITBAND_ACCESS == STD_ON)\n"
+               "#define DIO_CHANNEL_CFG(ChannelId)  { DIO_CFG_PORT(ChannelId), DIO_CFG_MASK(ChannelId), \\\n"
+               "                                      DIO_CFG_IDR_BIT(ChannelId), DIO_CFG_ODR_BIT(ChannelId) }\n"
+               "#else\n"
+               "#define DIO_CHANNEL_CFG(ChannelId)  { DIO_CFG_PORT(ChannelId), DIO_CFG_MASK(ChannelId) }\n"
+               "#endif\n\n")
+    out.append("/* Bảng phân giải kênh: chỉ số là ChannelId (0–63) */\n")
+    out.append("const Dio_ChannelCfgType Dio_ChannelCfg[DIO_NUM_CHANNELS] = {\n")
+    rows = []
+    for port in range(len(PORT_NAMES)):
+        quads = ["    " + ", ".join("DIO_CHANNEL_CFG(%d)" % (port * 16 + q * 4 + k) for k in range(4))
+                 for q in range(4)]
+        rows.append("    /* GPIO%s */\n" % PORT_NAMES[port] + ",\n".join(quads))
+    out.append(",\n".join(rows) + "\n};\n\n")
+
+    out.append("#if (DIO_DEBOUNCE_API == STD_ON)\n")
+    out.append("/* Ngưỡng debounce theo kênh (số lần gọi Dio_DebounceMainFunction liên tiếp) */\n")
+    out.append("const uint8 Dio_DebounceThreshold[DIO_NUM_CHANNELS] = {\n")
+    for c in chans:
+        if c["debounce"] is not None:
+            out.append("    [%s] = %du,   // %s, %d mẫu\n" % (c["name"], c["debounce"], pin_comment(c), c["debounce"]))
+    out.append("};\n#endif\n")
+    return "".join(out)
+
+
+def pin_comment(c):
+    return "%s - %s" % (c["pin"], c["comment"]) if c["comment"] else c["pin"]
+
+
+def gen_dio_h(path, chans):
+    """Sinh lại tên kênh và lời gọi DIO_DEFINE_CHANNEL_ACCESSORS trong Dio_Cfg.h"""
+    names = []
+    for c in chans:
+        names.append("#define %s %d    // %s" % (c["name"], c["id"], pin_comment(c)))
+    text = replace_block(path, read_text(path), "Channels", names)
+    return replace_block(path, text, "Accessors",
+                         ["DIO_DEFINE_CHANNEL_ACCESSORS(%s)" % c["name"] for c in chans])
+
+
+def gen_pwm_c(chans, user_code, src):
+    out = [banner("Pwm_cfg.c", "PWM Driver Configuration Source File (sinh tự động)", src)]
+    out.append('#include "Pwm_cfg.h"\n#include "stm32f10x_gpio.h"\n')
+
+    externs = sorted({c["notification"] for c in chans if c["notification"]})
+    for cb in externs:
+        out.append("void %s(void);\n" % cb)
+    out.append("\n" + USER_BEGIN + user_code + USER_END + "\n\n")
+
+    out.append("/* ==== Cấu hình từng kênh PWM ==== */\n")
+    out.append("const Pwm_ChannelConfigType pwmChannelscfg[PinPWM] = {\n")
+    rows = []
+    for i, c in enumerate(chans):
+        rows.append(
+            "    /* Channel %d: %s - %s_CH%d */\n"
+            "    {\n"
+            "        .TIMx             = %s,\n"
+            "        .CcrAddr          = &%s->CCR%d,\n"
+            "        .channel          = %d,\n"
+            "        .classType        = %s,\n"
+            "        .defaultFrequencyHz = %du,\n"
+            "        .defaultPeriod    = %d,\n"
+            "        .defaultDutyCycle = 0x%04X,\n"
+            "        .polarity         = %s,\n"
+            "        .idleState        = %s,\n"
+            "        .CompareVal       = %d,\n"
+            "        .phase            = %d,\n"
+            "        .phaseUnit        = %s,\n"
+            "        .complementary    = %d,\n"
+            "        .nPolarity        = %s,\n"
+            "        .notificationEnable = %d,\n"
+            "        .NotificationCb   = %s\n"
+            "    }" % (i, c["pin"], c["timer"], c["channel"],
+                     c["timer"], c["timer"], c["channel"], c["channel"],
+                     PWM_CLASSES[c["class"]], c["frequency"], c["period"], c["duty"],
+                     PWM_STATES[c["polarity"]], PWM_STATES[c["idle"]], c["compare"],
+                     c["phase"], c["phaseUnit"],
+                     int(c["npin"] is not None), PWM_STATES[c["npolarity"]],
+                     int(c["notification"] is not None), c["notification"] or "NULL_PTR"))
+    out.append(",\n".join(rows) + "\n};\n\n")
+    out.append("/* Ba con trỏ + 16 byte dữ liệu/bitfield: 28 byte/kênh trên Cortex-M3 */\n")
+    out.append("typedef char Pwm_ChannelConfigSizeCheck[(sizeof(Pwm_ChannelConfigType) == "
+               "((3u * sizeof(void*)) + 16u)) ? 1 : -1];\n")
+    return "".join(out)
+
+
+def read_user_code(path):
+    """Giữ lại đoạn code tay giữa hai marker USER CODE của file cũ"""
+    try:
+        with open(path, encoding="utf-8", newline="") as f:
+            text = f.read().replace("\r\n", "\n")
+    except FileNotFoundError:
+        return "\n"
+    b, e = text.find(USER_BEGIN), text.find(USER_END)
+    if b < 0 or e < b:
+        return "\n"
+    return text[b + len(USER_BEGIN):e]
+
+
+def set_define(path, name, value):
+    with open(path, encoding="utf-8", newline="") as f:
+        text = f.read().replace("\r\n", "\n")
+    text, n = re.subn(r"(#define\s+%s\s+)\d+" % name, lambda m: m.group(1) + str(value), text, 1)
+    if n != 1:
+        raise SystemExit("%s: không tìm thấy #define %s" % (path, name))
+    return text
+
+
+def write_crlf(path, text):
+    # Nguồn trong repo dùng CRLF
+    with open(path, "w", encoding="utf-8", newline="") as f:
+        f.write(text.replace("\r\n", "\n").replace("\n", "\r\n"))
+
+
+def main(argv):
+    if len(argv) < 2:
+        print("Cách dùng: python3 McalCfgGen.py <board.json> [--check]", file=sys.stderr)
+        return 2
+    src_path = argv[1]
+    check_only = "--check" in argv[2:]
+
+    with open(src_path, encoding="utf-8") as f:
+        desc = json.load(f)
+    mapping = load_mapping(MAPPING_FILE)
+
+    errs = Errors()
+    sets = check_sets(desc, errs)
+    chans = check_pwm(desc, sets, mapping, errs)
+    dio = check_dio(desc, errs)
+    if errs:
+        for e in errs:
+            print("%s: lỗi: %s" % (src_path, e), file=sys.stderr)
+        return 1
+    if check_only:
+        return 0
+
+    src = os.path.relpath(src_path, os.path.dirname(MCAL)).replace(os.sep, "/")
+    write_crlf(PORT_CFG_C, gen_port_c(sets, src))
+    write_crlf(PORT_CFG_H, gen_port_h(PORT_CFG_H, sets))
+    write_crlf(PWM_CFG_C, gen_pwm_c(chans, read_user_code(PWM_CFG_C), src))
+    write_crlf(PWM_CFG_H, set_define(PWM_CFG_H, "PinPWM", len(chans)))
+    write_crlf(DIO_CFG_C, gen_dio_c(dio, src))
+    write_crlf(DIO_CFG_H, gen_dio_h(DIO_CFG_H, dio))
+    print("%s: %d bộ cấu hình port, %d kênh PWM, %d kênh DIO đặt tên"
+          % (src_path, len(sets), len(chans), len(dio)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -9,8 +9,11 @@
 
 #include "Pwm.h"
 #include "stm32f10x_tim.h"
+#include "stm32f10x_rcc.h"
 #include "misc.h"
 #include "Pwm_cfg.h"
+#include "Clock.h"
+#include "CycleCounter.h"
 /* ===============================
  *     Biến và hằng cục bộ
  * =============================== */
@@ -21,10 +24,301 @@ static const Pwm_ConfigType* Pwm_CurrentConfigPtr = NULL_PTR;
 /* Biến trạng thái khởi tạo driver PWM */
 static uint8 Pwm_IsInitialized = 0;
 
+/* Các clock timer (bit theo Clock_IdType) mà PWM đang giữ */
+static uint16 Pwm_ClockMask = 0;
+
+/* Period lớn nhất bộ giải chọn: duty 0x8000 cho CCR = period, phải vừa 16 bit
+ * (period 65536 làm CCR tràn về 0, tức 0% thay vì 100%) */
+#define PWM_MAX_PERIOD  65535u
+
+/* Các timer có kênh được cấu hình (không trùng), dựng trong Pwm_Init */
+#define PWM_MAX_TIMERS  4u
+static TIM_TypeDef* Pwm_Timers[PWM_MAX_TIMERS];
+static uint8 Pwm_NumTimers = 0;
+
+/* Độ sâu lồng của Pwm_BeginUpdate */
+static uint8 Pwm_UpdateDepth = 0;
+
+/* Ảnh thanh ghi cho dừng khẩn cấp, tính trong Pwm_Init: CCMR1/CCMR2 khi chạy
+ * và khi dừng (OCxM = force theo idleState) theo thứ tự Pwm_Timers, BDTR của
+ * TIM1 khi chạy và khi dừng (MOE = 0) */
+static uint16 Pwm_RunCcmr[PWM_MAX_TIMERS][2];
+static uint16 Pwm_StopCcmr[PWM_MAX_TIMERS][2];
+static uint16 Pwm_RunBdtr = 0;
+static uint16 Pwm_StopBdtr = 0;
+
+#if (PWM_STOP_MEASURE == STD_ON)
+/* Số chu kỳ CPU lớn nhất của Pwm_EmergencyStop */
+static uint32 Pwm_StopMaxCycles = 0;
+#endif
+
+#if (PWM_INIT_MEASURE == STD_ON)
+/* Số chu kỳ CPU của lần Pwm_Init gần nhất */
+static uint32 Pwm_InitCycles = 0;
+#endif
+
+#if (PWM_SEQUENCE_API == STD_ON)
+/* Kênh DMA1 nhận request TIMx_UP (RM0008 bảng 78). TIM4_UP dùng
+ * DMA1_Channel7 của Dio stream nên không phát chuỗi trên TIM4. */
+typedef struct {
+    TIM_TypeDef*              TIMx;
+    DMA_Channel_TypeDef*      dma;
+    uint8                     flagShift;        /**< Vị trí 4 bit cờ trong DMA1->ISR/IFCR */
+    IRQn_Type                 irq;
+} Pwm_SeqDmaType;
+
+#define PWM_SEQ_NUM_DMA     3u
+static const Pwm_SeqDmaType Pwm_SeqDma[PWM_SEQ_NUM_DMA] = {
+    { TIM1, DMA1_Channel5, 16u, DMA1_Channel5_IRQn },
+    { TIM2, DMA1_Channel2,  4u, DMA1_Channel2_IRQn },
+    { TIM3, DMA1_Channel3,  8u, DMA1_Channel3_IRQn },
+};
+
+/* Trạng thái chuỗi đang phát trên từng kênh DMA */
+static volatile uint8 Pwm_SeqActive[PWM_SEQ_NUM_DMA];
+static Pwm_SequenceModeType Pwm_SeqMode[PWM_SEQ_NUM_DMA];
+static Pwm_ChannelType Pwm_SeqChannel[PWM_SEQ_NUM_DMA];
+static const Pwm_SequenceNotificationType Pwm_SeqHalfCbk = PWM_SEQUENCE_HALF_NOTIFICATION;
+static const Pwm_SequenceNotificationType Pwm_SeqDoneCbk = PWM_SEQUENCE_DONE_NOTIFICATION;
+#endif
+
+#if (PWM_RAMP_API == STD_ON)
+/* Bảng 33 điểm trên trục Q15 (bước 1024), nội suy tuyến tính giữa hai điểm */
+#define PWM_LUT_SHIFT       10u
+
+/* Gamma 2.2: y = x^2.2, độ sáng cảm nhận tuyến tính theo x */
+static const uint16 Pwm_GammaLut[33] = {
+        0,    16,    74,   179,   338,   552,   824,  1157,  1552,  2011,  2536,
+     3127,  3787,  4516,  5316,  6188,  7132,  8149,  9241, 10408, 11652, 12972,
+    14370, 15846, 17401, 19037, 20752, 22549, 24427, 26387, 28431, 30557, 32768
+};
+
+/* Ease in-out (smoothstep): y = 3x^2 - 2x^3 */
+static const uint16 Pwm_EaseLut[33] = {
+        0,    94,   368,   810,  1408,  2150,  3024,  4018,  5120,  6318,  7600,
+     8954, 10368, 11830, 13328, 14850, 16384, 17918, 19440, 20938, 22400, 23814,
+    25168, 26450, 27648, 28750, 29744, 30618, 31360, 31958, 32400, 32674, 32768
+};
+
+/* Trạng thái ramp của một kênh: giá trị v đi từ 'from' tới 'to' theo
+ * hình dạng 'shape', duty = out(v). Với gamma, from/to nằm trong miền
+ * độ sáng cảm nhận (ngược gamma của duty đầu/cuối). */
+typedef struct {
+    uint32                    acc;              /**< Tiến độ Q15.16 (0 .. 32768 << 16) */
+    uint32                    step;             /**< Tiến độ mỗi sự kiện update */
+    sint32                    from;
+    sint32                    to;
+    const uint16*             shape;            /**< NULL_PTR: tuyến tính */
+    const uint16*             out;              /**< NULL_PTR: duty = v */
+    uint16                    target;           /**< Duty đích, ghi đúng giá trị ở bước cuối */
+} Pwm_RampType;
+
+static Pwm_RampType Pwm_Ramp[PWM_NUM_CHANNELS];
+
+/* Kênh đang có ramp chạy (bit theo số thứ tự kênh) */
+static volatile uint16 Pwm_RampActiveMask = 0;
+#endif
+
+/* Bảng dispatch ngắt trong RAM, dựng trong Pwm_Init; chỉ số timer 0 = TIM1 ... 3 = TIM4 */
+#define PWM_NUM_TIMER_IDX   4u
+#define PWM_IRQ_FLAGS       (TIM_SR_UIF | TIM_IT_CC1 | TIM_IT_CC2 | TIM_IT_CC3 | TIM_IT_CC4)
+
+/* Callback notification của từng kênh (NULL_PTR: không cho phép notification) */
+static void (*Pwm_ChannelCb[PWM_NUM_CHANNELS])(void);
+
+/* Kênh PWM gắn với CC1..CC4 của từng timer (PWM_NUM_CHANNELS: không có) */
+static uint8 Pwm_CcChannel[PWM_NUM_TIMER_IDX][4];
+
+/* Các kênh của từng timer (bit theo số thứ tự kênh) */
+static uint16 Pwm_TimerChannels[PWM_NUM_TIMER_IDX];
+
+/* Các kênh có notification ở sự kiện update của từng timer */
+static volatile uint16 Pwm_UpdateNotify[PWM_NUM_TIMER_IDX];
+
+#if (PWM_ISR_MEASURE == STD_ON)
+/* Số chu kỳ CPU lớn nhất của Pwm_TimerIrq */
+static uint32 Pwm_IsrMaxCycles = 0;
+#endif
+
+/* Thanh ghi giả cho kênh chưa khởi tạo (ghi vào đây không có tác dụng) */
+static volatile uint16 Pwm_DummyCcr;
+
+/* Con trỏ CCR và period cache của từng kênh */
+Pwm_ChannelRtType Pwm_ChannelRt[PWM_NUM_CHANNELS];
+
 /* ===============================
  *      Định nghĩa hàm chức năng
  * =============================== */
 
+/**********************************************************
+ * @brief   Lấy địa chỉ thanh ghi CCR của một kênh
+ * @details Ưu tiên địa chỉ generator đã tính sẵn trong cấu hình;
+ *          nếu không có thì suy ra từ số kênh (CCR1..CCR4 cách nhau
+ *          4 byte: thanh ghi 16 bit kèm 16 bit dự trữ).
+ * @return  NULL_PTR nếu số kênh không hợp lệ
+ **********************************************************/
+static volatile uint16* Pwm_GetCcr(const Pwm_ChannelConfigType* ch)
+{
+    if (ch->CcrAddr != NULL_PTR) return ch->CcrAddr;
+    if (ch->channel < 1u || ch->channel > 4u) return NULL_PTR;
+    return &ch->TIMx->CCR1 + 2u * (ch->channel - 1u);
+}
+
+/**********************************************************
+ * @brief   Clock của một timer
+ * @return  CLOCK_NUM_IDS nếu timer không được hỗ trợ
+ **********************************************************/
+static Clock_IdType Pwm_TimerClock(const TIM_TypeDef* TIMx)
+{
+    if (TIMx == TIM1) return CLOCK_TIM1;
+    if (TIMx == TIM2) return CLOCK_TIM2;
+    if (TIMx == TIM3) return CLOCK_TIM3;
+    if (TIMx == TIM4) return CLOCK_TIM4;
+    return CLOCK_NUM_IDS;
+}
+
+/**********************************************************
+ * @brief   Chỉ số timer trong các bảng ngắt (0 = TIM1 ... 3 = TIM4)
+ * @return  PWM_NUM_TIMER_IDX nếu không phải TIM1..TIM4
+ **********************************************************/
+static uint8 Pwm_TimerIndex(const TIM_TypeDef* TIMx)
+{
+    if (TIMx == TIM1) return 0u;
+    if (TIMx == TIM2) return 1u;
+    if (TIMx == TIM3) return 2u;
+    if (TIMx == TIM4) return 3u;
+    return PWM_NUM_TIMER_IDX;
+}
+
+/**********************************************************
+ * @brief   Xóa bảng dispatch ngắt: không kênh, không callback
+ **********************************************************/
+static void Pwm_ResetIrqTables(void)
+{
+    for (uint8 i = 0; i < PWM_NUM_CHANNELS; i++) Pwm_ChannelCb[i] = NULL_PTR;
+    for (uint8 t = 0; t < PWM_NUM_TIMER_IDX; t++)
+    {
+        for (uint8 c = 0; c < 4u; c++) Pwm_CcChannel[t][c] = PWM_NUM_CHANNELS;
+        Pwm_TimerChannels[t] = 0;
+        Pwm_UpdateNotify[t] = 0;
+    }
+}
+
+/**********************************************************
+ * @brief   Đưa bảng runtime về trạng thái chưa khởi tạo
+ **********************************************************/
+static void Pwm_ResetChannelRt(void)
+{
+    for (uint8 i = 0; i < PWM_NUM_CHANNELS; i++)
+    {
+        Pwm_ChannelRt[i].ccr = &Pwm_DummyCcr;
+        Pwm_ChannelRt[i].period = 0u;
+    }
+}
+
+/**
+ * @brief Clock vào timer: PCLK, nhân 2 nếu bộ chia APB khác 1
+ */
+static uint32 Pwm_GetTimerClockHz(const TIM_TypeDef* TIMx)
+{
+    RCC_ClocksTypeDef clocks;
+    uint32 pclk;
+
+    RCC_GetClocksFreq(&clocks);
+    pclk = (TIMx == TIM1) ? clocks.PCLK2_Frequency : clocks.PCLK1_Frequency;
+    return (pclk == clocks.HCLK_Frequency) ? pclk : 2u * pclk;
+}
+
+/**********************************************************
+ * @brief   Đổi period của mọi kênh dùng chung timer, giữ tỷ lệ duty
+ * @details Tính lại CCR của từng kênh theo period mới và cập nhật
+ *          period cache. Gọi trong Pwm_BeginUpdate/Pwm_CommitUpdate
+ *          để CCR mới và ARR chốt cùng một sự kiện update.
+ * @param[in] TIMx   Timer sắp đổi ARR
+ * @param[in] period ARR + 1 mới
+ **********************************************************/
+static void Pwm_RescaleTimer(const TIM_TypeDef* TIMx, uint32 period)
+{
+    for (uint8 i = 0; i < Pwm_CurrentConfigPtr->NumChannels && i < PWM_NUM_CHANNELS; i++)
+    {
+        uint32 duty;
+
+        // Kênh không có CCR (period = 0) không có duty để giữ
+        if (Pwm_CurrentConfigPtr->Channels[i].TIMx != TIMx || Pwm_ChannelRt[i].period == 0u) continue;
+        duty = ((uint32)*Pwm_ChannelRt[i].ccr << 15) / Pwm_ChannelRt[i].period;
+        Pwm_ChannelRt[i].period = period;
+        Pwm_SetDutyCycleFast(i, (uint16)((duty > 0x8000u) ? 0x8000u : duty));
+    }
+}
+
+/**
+ * @brief Kênh dịch pha đầu tiên của timer; NULL_PTR nếu timer chạy edge-aligned
+ */
+static const Pwm_ChannelConfigType* Pwm_ShiftedChannel(const Pwm_ConfigType* ConfigPtr, const TIM_TypeDef* TIMx)
+{
+    for (uint8 i = 0; i < ConfigPtr->NumChannels; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &ConfigPtr->Channels[i];
+
+        if (ch->TIMx == TIMx && ch->classType == PWM_FIXED_PERIOD_SHIFTED) return ch;
+    }
+    return NULL_PTR;
+}
+
+/**
+ * @brief Đặt CNT/DIR theo pha của kênh trên tam giác 0 -> ARR -> 0 (chu kỳ 2*ARR)
+ * @note  Gọi khi CEN = 0 và trước khi chọn CMS: ở center-aligned DIR chỉ đọc
+ */
+static void Pwm_PresetPhase(TIM_TypeDef* TIMx, const Pwm_ChannelConfigType* ch)
+{
+    uint32 arr = TIMx->ARR;
+    uint32 full = 2u * arr;
+    uint32 delay, pos;
+
+    if (arr == 0u) return;
+    // phase * ARR / 18000 thay cho phase * 2ARR / 36000: không tràn 32 bit
+    delay = (ch->phaseUnit == PWM_PHASE_CENTIDEGREES) ? ((uint32)ch->phase * arr) / 18000u
+                                                       : (uint32)ch->phase % full;
+    // Trễ delay tick: khi CEN bật, counter đang ở vị trí -delay trong chu kỳ
+    pos = (full - delay) % full;
+    if (pos <= arr)
+    {
+        TIMx->CR1 &= (uint16)~TIM_CR1_DIR;
+        TIMx->CNT = (uint16)pos;
+    }
+    else
+    {
+        TIMx->CR1 |= TIM_CR1_DIR;
+        TIMx->CNT = (uint16)(full - pos);
+    }
+}
+
+/**
+ * @brief Ảnh CCMR khi chạy và khi dừng khẩn cấp của timer thứ t trong Pwm_Timers
+ * @note  Gọi sau khi các kênh OC của timer đã cấu hình. Output = OCref XOR CCxP:
+ *        force active khi idleState trùng polarity (mức tích cực), force inactive khi khác
+ */
+static void Pwm_BuildStopImages(const Pwm_ConfigType* ConfigPtr, uint8 t)
+{
+    TIM_TypeDef* TIMx = Pwm_Timers[t];
+
+    Pwm_RunCcmr[t][0] = Pwm_StopCcmr[t][0] = TIMx->CCMR1;
+    Pwm_RunCcmr[t][1] = Pwm_StopCcmr[t][1] = TIMx->CCMR2;
+    for (uint8 i = 0; i < ConfigPtr->NumChannels; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &ConfigPtr->Channels[i];
+        uint8 reg, shift;
+        uint16 force;
+
+        if (ch->TIMx != TIMx || ch->channel < 1u || ch->channel > 4u) continue;
+        // CH1/CH3 ở byte thấp, CH2/CH4 ở byte cao của CCMR1/CCMR2; OCxM là bit 6:4 của byte
+        reg = (uint8)((ch->channel - 1u) >> 1);
+        shift = (uint8)(((ch->channel - 1u) & 1u) * 8u);
+        force = (ch->idleState == ch->polarity) ? TIM_ForcedAction_Active : TIM_ForcedAction_InActive;
+        Pwm_StopCcmr[t][reg] = (uint16)((Pwm_StopCcmr[t][reg] & ~(0x0070u << shift)) | (force << shift));
+    }
+}
+
 /**********************************************************
  * @brief   Khởi tạo PWM driver với cấu hình được truyền vào
  * @details Bật clock, cấu hình timer (prescaler, period, mode)
@@ -35,47 +329,236 @@ void Pwm_Init(const Pwm_ConfigType* ConfigPtr)
 {
     if (Pwm_IsInitialized || ConfigPtr == NULL_PTR) return;
 
+    uint8 dtg = 0u;
+
+    // Dead-time TIM1 vượt 1008 tDTS: DTG bão hòa sẽ cho dead-time ngắn hơn yêu cầu
+    // nên không khởi tạo (chưa xin clock, chưa ghi thanh ghi nào)
+    for (uint8 i = 0; i < ConfigPtr->NumChannels; i++)
+    {
+        if (ConfigPtr->Channels[i].TIMx != TIM1) continue;
+        if (Pwm_DeadTimeToDtg(Pwm_GetTimerClockHz(TIM1), PWM_DEADTIME_NS, &dtg) != E_OK) return;
+        break;
+    }
+
+#if (PWM_INIT_MEASURE == STD_ON)
+    CycleCounter_Init();
+    uint32 start = CycleCounter_Get();
+#endif
+
     Pwm_CurrentConfigPtr = ConfigPtr;
 
+    TIM_TypeDef* master = NULL_PTR;
+
+    // Xin clock một lần cho mỗi timer được dùng; clock chỉ bật sau Clock_EndPhase
+    Pwm_NumTimers = 0;
+    Pwm_UpdateDepth = 0;
+    Clock_BeginPhase();
     for (uint8 i = 0; i < ConfigPtr->NumChannels; i++)
     {
-        if (ConfigPtr->Channels[i].TIMx == TIM1)
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1, ENABLE);
-        else if (ConfigPtr->Channels[i].TIMx == TIM2)
-            RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
-        else if (ConfigPtr->Channels[i].TIMx == TIM3)
-            RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
-        else if (ConfigPtr->Channels[i].TIMx == TIM4)
-            RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM4, ENABLE);
-
-        TIM_TimeBaseInitTypeDef tim;
-        tim.TIM_ClockDivision = TIM_CKD_DIV1;
-        tim.TIM_CounterMode = TIM_CounterMode_Up;
-        tim.TIM_Period = ConfigPtr->Channels[i].defaultPeriod - 1;
-        tim.TIM_Prescaler = 8 - 1; // sử dụng thạch anh 8MHz
-
-        TIM_TimeBaseInit(ConfigPtr->Channels[i].TIMx, &tim);
-
-        TIM_OCInitTypeDef oc;
-        oc.TIM_OCMode = TIM_OCMode_PWM1;
-        oc.TIM_OutputState = TIM_OutputState_Enable;
-        oc.TIM_Pulse = ConfigPtr->Channels[i].CompareVal;
-        oc.TIM_OCPolarity = TIM_OCPolarity_High;
-
-        switch (ConfigPtr->Channels[i].channel)
+        Clock_IdType clk = Pwm_TimerClock(ConfigPtr->Channels[i].TIMx);
+
+        if (clk == CLOCK_NUM_IDS || (Pwm_ClockMask & (1u << clk))) continue;
+        Clock_Request(clk);
+        Pwm_ClockMask |= (uint16)(1u << clk);
+        Pwm_Timers[Pwm_NumTimers++] = ConfigPtr->Channels[i].TIMx;
+    }
+    Clock_EndPhase();
+
+    // Mỗi timer: một lần time base, tất cả kênh OC của nó, rồi mới chạy
+    for (uint8 t = 0; t < Pwm_NumTimers; t++)
+    {
+        TIM_TypeDef* TIMx = Pwm_Timers[t];
+        const Pwm_ChannelConfigType* shifted = Pwm_ShiftedChannel(ConfigPtr, TIMx);
+        uint8 first = 1;
+        uint32 period = 0;
+
+        for (uint8 i = 0; i < ConfigPtr->NumChannels; i++)
         {
-            case 1: TIM_OC1Init(ConfigPtr->Channels[i].TIMx, &oc); break;
-            case 2: TIM_OC2Init(ConfigPtr->Channels[i].TIMx, &oc); break;
-            case 3: TIM_OC3Init(ConfigPtr->Channels[i].TIMx, &oc); break;
-            case 4: TIM_OC4Init(ConfigPtr->Channels[i].TIMx, &oc); break;
-            default: break;
+            if (ConfigPtr->Channels[i].TIMx != TIMx) continue;
+
+            // Các kênh cùng timer chung PSC/ARR: lấy theo kênh đầu tiên
+            if (first)
+            {
+                TIM_TimeBaseInitTypeDef tim;
+                uint32 clk = Pwm_GetTimerClockHz(TIMx);
+                Pwm_TimeBaseType tb;
+
+                // Cấu hình theo Hz; không có nghiệm thì dùng defaultPeriod với tick PWM_TICK_HZ.
+                // Center-aligned: một chu kỳ PWM là 2*ARR tick nên giải cho tần số 2f
+                if (ConfigPtr->Channels[i].defaultFrequencyHz == 0u ||
+                    Pwm_SolveTimeBase(clk, ConfigPtr->Channels[i].defaultFrequencyHz << (shifted != NULL_PTR),
+                                      &tb) != E_OK)
+                {
+                    tb.prescaler = (uint16)((clk / PWM_TICK_HZ) - 1u);
+                    tb.period = ConfigPtr->Channels[i].defaultPeriod >> (shifted != NULL_PTR);
+                }
+                period = tb.period;
+
+                tim.TIM_ClockDivision = TIM_CKD_DIV1;
+                tim.TIM_CounterMode = TIM_CounterMode_Up;
+                tim.TIM_Period = (shifted != NULL_PTR) ? (uint16)tb.period : (uint16)(tb.period - 1u);
+                tim.TIM_Prescaler = tb.prescaler;
+                tim.TIM_RepetitionCounter = 0;
+
+                TIM_TimeBaseInit(TIMx, &tim);
+                // ARR qua thanh ghi preload: period mới có hiệu lực từ chu kỳ sau
+                TIM_ARRPreloadConfig(TIMx, ENABLE);
+                // Bỏ chế độ master/slave của lần Init trước
+                TIMx->SMCR = 0;
+                TIM_SelectOutputTrigger(TIMx, TIM_TRGOSource_Reset);
+                TIM_SelectMasterSlaveMode(TIMx, TIM_MasterSlaveMode_Disable);
+                if (shifted != NULL_PTR)
+                {
+                    // CNT/DIR theo pha khi còn edge-aligned, sau đó mới chuyển CMS = 01
+                    Pwm_PresetPhase(TIMx, shifted);
+                    TIMx->CR1 |= TIM_CounterMode_CenterAligned1;
+                }
+                first = 0;
+            }
+
+            TIM_OCInitTypeDef oc;
+            // Các trường CHxN/idle chỉ TIM1 dùng nhưng vẫn phải có giá trị xác định
+            TIM_OCStructInit(&oc);
+            oc.TIM_OCMode = TIM_OCMode_PWM1;
+            oc.TIM_OutputState = TIM_OutputState_Enable;
+            oc.TIM_Pulse = (ConfigPtr->Channels[i].defaultFrequencyHz != 0u)
+                         ? (uint16)((period * ConfigPtr->Channels[i].defaultDutyCycle) >> 15)
+                         : ConfigPtr->Channels[i].CompareVal;
+            oc.TIM_OCPolarity = (ConfigPtr->Channels[i].polarity == PWM_HIGH) ? TIM_OCPolarity_High
+                                                                              : TIM_OCPolarity_Low;
+            // OISx/OISxN (chỉ TIM1): mức output khi MOE = 0; CHxN về mức không tích cực
+            oc.TIM_OCIdleState = (ConfigPtr->Channels[i].idleState == PWM_HIGH) ? TIM_OCIdleState_Set
+                                                                                : TIM_OCIdleState_Reset;
+            if (TIMx == TIM1 && ConfigPtr->Channels[i].complementary && ConfigPtr->Channels[i].channel <= 3u)
+            {
+                oc.TIM_OutputNState = TIM_OutputNState_Enable;
+                oc.TIM_OCNPolarity = (ConfigPtr->Channels[i].nPolarity == PWM_HIGH) ? TIM_OCNPolarity_High
+                                                                                    : TIM_OCNPolarity_Low;
+                oc.TIM_OCNIdleState = (ConfigPtr->Channels[i].nPolarity == PWM_HIGH) ? TIM_OCNIdleState_Reset
+                                                                                     : TIM_OCNIdleState_Set;
+            }
+
+            switch (ConfigPtr->Channels[i].channel)
+            {
+                // CCR qua thanh ghi preload: không có xung cụt khi đổi duty giữa chu kỳ
+                case 1: TIM_OC1Init(TIMx, &oc); TIM_OC1PreloadConfig(TIMx, TIM_OCPreload_Enable); break;
+                case 2: TIM_OC2Init(TIMx, &oc); TIM_OC2PreloadConfig(TIMx, TIM_OCPreload_Enable); break;
+                case 3: TIM_OC3Init(TIMx, &oc); TIM_OC3PreloadConfig(TIMx, TIM_OCPreload_Enable); break;
+                case 4: TIM_OC4Init(TIMx, &oc); TIM_OC4PreloadConfig(TIMx, TIM_OCPreload_Enable); break;
+                default: break;
+            }
+        }
+
+        Pwm_BuildStopImages(ConfigPtr, t);
+
+        // TIM1: output chỉ ra chân khi MOE = 1. Dead-time và LOCK ghi cùng một
+        // lệnh, sau cùng: LOCK khác OFF khóa DTG (và CCxP/CCxNP ở mức 2) tới reset.
+        // OSSI/OSSR: khi MOE = 0 output bị giữ ở OISx thay vì thả nổi
+        if (TIMx == TIM1)
+        {
+            Pwm_RunBdtr = (uint16)(TIM_BDTR_MOE | TIM_BDTR_OSSR | TIM_BDTR_OSSI | PWM_LOCK_LEVEL | dtg);
+#if (PWM_BREAK_INPUT == STD_ON)
+            Pwm_RunBdtr |= (uint16)(TIM_BDTR_BKE | PWM_BREAK_POLARITY);
+#endif
+            Pwm_StopBdtr = (uint16)(Pwm_RunBdtr & ~TIM_BDTR_MOE);
+            TIM1->BDTR = Pwm_RunBdtr;
+        }
+
+        if (shifted != NULL_PTR)
+        {
+            // Timer dịch pha đầu tiên là master: TRGO = CEN của nó. Các timer dịch
+            // pha còn lại ở trigger mode với ITRx = chỉ số master (RM0008, bảng
+            // ITR của TIM1..TIM4), phần cứng bật CEN của chúng cùng một cạnh clock
+            if (master == NULL_PTR)
+            {
+                master = TIMx;
+                TIM_SelectOutputTrigger(TIMx, TIM_TRGOSource_Enable);
+                TIM_SelectMasterSlaveMode(TIMx, TIM_MasterSlaveMode_Enable);
+            }
+            else
+            {
+                TIM_SelectInputTrigger(TIMx, (uint16)((uint16)Pwm_TimerIndex(master) << 4));
+                TIM_SelectSlaveMode(TIMx, TIM_SlaveMode_Trigger);
+            }
+            continue;
         }
 
-        TIM_Cmd(ConfigPtr->Channels[i].TIMx, ENABLE);
+#if (PWM_SYNC_START == STD_OFF)
+        TIM_Cmd(TIMx, ENABLE);
+#endif
     }
 
+    // Đưa counter edge-aligned về 0 rồi bật CEN liền nhau: các timer lệch nhau vài
+    // chu kỳ CPU. Timer dịch pha giữ CNT đã đặt theo pha, chỉ master được bật CEN
+    {
+        uint32 primask = __get_PRIMASK();
+
+        __disable_irq();
+#if (PWM_SYNC_START == STD_ON)
+        for (uint8 t = 0; t < Pwm_NumTimers; t++)
+        {
+            if (Pwm_ShiftedChannel(ConfigPtr, Pwm_Timers[t]) == NULL_PTR) Pwm_Timers[t]->CNT = 0;
+        }
+        for (uint8 t = 0; t < Pwm_NumTimers; t++)
+        {
+            if (Pwm_ShiftedChannel(ConfigPtr, Pwm_Timers[t]) == NULL_PTR) Pwm_Timers[t]->CR1 |= TIM_CR1_CEN;
+        }
+#endif
+        if (master != NULL_PTR) master->CR1 |= TIM_CR1_CEN;
+        __set_PRIMASK(primask);
+    }
+
+    // Bảng runtime: CCR tính một lần, period đọc từ ARR đã nạp
+    // (center-aligned: CCR = ARR là 100%, nên period là ARR thay vì ARR + 1)
+    Pwm_ResetChannelRt();
+    for (uint8 i = 0; i < ConfigPtr->NumChannels && i < PWM_NUM_CHANNELS; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &ConfigPtr->Channels[i];
+        volatile uint16* ccr = Pwm_GetCcr(ch);
+
+        if (ccr == NULL_PTR) continue;
+        Pwm_ChannelRt[i].ccr = ccr;
+        Pwm_ChannelRt[i].period = (uint32)ch->TIMx->ARR + ((Pwm_ShiftedChannel(ConfigPtr, ch->TIMx) != NULL_PTR) ? 0u : 1u);
+    }
+
+    // Bảng dispatch ngắt: kênh theo timer/CCx và callback chép sang RAM
+    Pwm_ResetIrqTables();
+    for (uint8 i = 0; i < ConfigPtr->NumChannels && i < PWM_NUM_CHANNELS; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &ConfigPtr->Channels[i];
+        uint8 t = Pwm_TimerIndex(ch->TIMx);
+
+        if (t == PWM_NUM_TIMER_IDX) continue;
+        Pwm_TimerChannels[t] |= (uint16)(1u << i);
+        if (ch->channel >= 1u && ch->channel <= 4u) Pwm_CcChannel[t][ch->channel - 1u] = i;
+        if (ch->notificationEnable) Pwm_ChannelCb[i] = ch->NotificationCb;
+    }
+
+#if (PWM_ISR_MEASURE == STD_ON)
+    CycleCounter_Init();
+    Pwm_IsrMaxCycles = 0;
+#endif
+#if (PWM_STOP_MEASURE == STD_ON)
+    CycleCounter_Init();
+    Pwm_StopMaxCycles = 0;
+#endif
+
     Pwm_IsInitialized = 1;
+
+#if (PWM_INIT_MEASURE == STD_ON)
+    Pwm_InitCycles = CycleCounter_Get() - start;
+#endif
+}
+
+#if (PWM_INIT_MEASURE == STD_ON)
+/**********************************************************
+ * @brief   Số chu kỳ CPU của lần Pwm_Init gần nhất
+ **********************************************************/
+uint32 Pwm_GetInitCycles(void)
+{
+    return Pwm_InitCycles;
 }
+#endif
 
 /**********************************************************
  * @brief   Giải phóng tài nguyên và dừng các kênh PWM
@@ -84,59 +567,302 @@ void Pwm_DeInit(void)
 {
     if (!Pwm_IsInitialized) return;
 
-    for (uint8 i = 0; i < Pwm_CurrentConfigPtr->NumChannels; i++)
+    // Output về idleState trước: counter dừng thì output giữ nguyên mức hiện tại
+    Pwm_EmergencyStop();
+    for (uint8 t = 0; t < Pwm_NumTimers; t++) TIM_Cmd(Pwm_Timers[t], DISABLE);
+
+#if (PWM_SEQUENCE_API == STD_ON)
+    for (uint8 d = 0; d < PWM_SEQ_NUM_DMA; d++)
+    {
+        if (Pwm_SeqActive[d]) Pwm_StopSequence(Pwm_SeqChannel[d]);
+    }
+#endif
+#if (PWM_RAMP_API == STD_ON)
+    Pwm_RampActiveMask = 0;
+#endif
+    Pwm_ResetIrqTables();
+
+    Pwm_ResetChannelRt();
+    Pwm_NumTimers = 0;
+    Pwm_UpdateDepth = 0;
+
+    // Timer đã dừng mới trả clock
+    Clock_BeginPhase();
+    for (uint8 clk = 0; clk < CLOCK_NUM_IDS; clk++)
     {
-        const Pwm_ChannelConfigType* ch = &Pwm_CurrentConfigPtr->Channels[i];
-        TIM_Cmd(ch->TIMx, DISABLE);
-        if (ch->TIMx == TIM1) TIM_CtrlPWMOutputs(TIM1, DISABLE);
+        if (Pwm_ClockMask & (1u << clk)) Clock_Release((Clock_IdType)clk);
     }
+    Clock_EndPhase();
+    Pwm_ClockMask = 0;
 
     Pwm_IsInitialized = 0;
 }
 
+/**********************************************************
+ * @brief   Dừng khẩn cấp mọi output
+ * @details Tối đa 1 + 2 x 3 lệnh ghi thanh ghi (TIM1 + TIM2..TIM4),
+ *          không đọc-sửa-ghi. Output TIM2..TIM4 đổi mức ngay ở lệnh
+ *          ghi CCMR; output TIM1 về OISx sau dead-time.
+ **********************************************************/
+void Pwm_EmergencyStop(void)
+{
+#if (PWM_STOP_MEASURE == STD_ON)
+    uint32 start = CycleCounter_Get();
+    uint32 cycles;
+#endif
+
+    if (!Pwm_IsInitialized) return;
+
+    // TIM1 trước: một lệnh ghi dừng cả CHx và CHxN
+    if (Pwm_ClockMask & (1u << CLOCK_TIM1)) TIM1->BDTR = Pwm_StopBdtr;
+    for (uint8 t = 0; t < Pwm_NumTimers; t++)
+    {
+        TIM_TypeDef* TIMx = Pwm_Timers[t];
+
+        if (TIMx == TIM1) continue;
+        TIMx->CCMR1 = Pwm_StopCcmr[t][0];
+        TIMx->CCMR2 = Pwm_StopCcmr[t][1];
+    }
+
+#if (PWM_STOP_MEASURE == STD_ON)
+    cycles = CycleCounter_Get() - start;
+    if (cycles > Pwm_StopMaxCycles) Pwm_StopMaxCycles = cycles;
+#endif
+}
+
+/**********************************************************
+ * @brief   Chạy lại output sau dừng khẩn cấp
+ * @details Critical section: Pwm_EmergencyStop gọi từ ngắt giữa
+ *          chừng không bị các lệnh ghi còn lại ghi đè.
+ **********************************************************/
+Std_ReturnType Pwm_EmergencyRearm(void)
+{
+    uint32 primask;
+
+    if (!Pwm_IsInitialized) return E_NOT_OK;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (Pwm_ClockMask & (1u << CLOCK_TIM1))
+    {
+        // BIF chỉ xóa được khi BKIN hết tích cực; break còn thì MOE bị xóa lại ngay
+        TIM1->SR = (uint16)~TIM_FLAG_Break;
+        TIM1->BDTR = Pwm_RunBdtr;
+        if ((TIM1->BDTR & TIM_BDTR_MOE) == 0u)
+        {
+            __set_PRIMASK(primask);
+            return E_NOT_OK;
+        }
+    }
+    for (uint8 t = 0; t < Pwm_NumTimers; t++)
+    {
+        TIM_TypeDef* TIMx = Pwm_Timers[t];
+
+        if (TIMx == TIM1) continue;
+        TIMx->CCMR1 = Pwm_RunCcmr[t][0];
+        TIMx->CCMR2 = Pwm_RunCcmr[t][1];
+    }
+    __set_PRIMASK(primask);
+
+    return E_OK;
+}
+
+#if (PWM_STOP_MEASURE == STD_ON)
+/**********************************************************
+ * @brief   Số chu kỳ CPU lớn nhất của Pwm_EmergencyStop
+ **********************************************************/
+uint32 Pwm_GetEmergencyStopCycles(void)
+{
+    return Pwm_StopMaxCycles;
+}
+#endif
+
 /**********************************************************
  * @brief   Đặt duty cycle cho kênh PWM
+ * @details Kiểm tra tham số rồi gọi Pwm_SetDutyCycleFast:
+ *          CCR = period * duty >> 15, nên 0x8000 là 100% (period là
+ *          ARR + 1, hoặc ARR với timer center-aligned).
  * @param[in] ChannelNumber Số thứ tự kênh
  * @param[in] DutyCycle     Giá trị duty (0 - 0x8000 tương ứng 0-100%)
  **********************************************************/
 void Pwm_SetDutyCycle(Pwm_ChannelType ChannelNumber, uint16 DutyCycle)
 {
     if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return;
+    if (ChannelNumber >= PWM_NUM_CHANNELS) return;
 
-    const Pwm_ChannelConfigType* ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
-    uint16_t period = ch->TIMx->ARR;
-    uint16_t compare = ((uint32_t)period * DutyCycle) >> 15;
+    Pwm_SetDutyCycleFast(ChannelNumber, DutyCycle);
+}
 
-    switch (ch->channel)
+/**********************************************************
+ * @brief   Chọn PSC/ARR cho một tần số
+ * @details Bắt đầu từ PSC nhỏ nhất để period <= PWM_MAX_PERIOD (độ phân giải
+ *          lớn nhất), tăng dần cho tới khi sai số làm tròn nằm trong
+ *          PWM_FREQ_MAX_ERROR_PPM hoặc period xuống dưới 2 tick.
+ **********************************************************/
+Std_ReturnType Pwm_SolveTimeBase(uint32 TimerClockHz, uint32 FrequencyHz, Pwm_TimeBaseType* Result)
+{
+    uint32 div;
+
+    if (Result == NULL_PTR || FrequencyHz == 0u || TimerClockHz / FrequencyHz < 2u) return E_NOT_OK;
+
+    div = (TimerClockHz / FrequencyHz + (PWM_MAX_PERIOD - 1u)) / PWM_MAX_PERIOD;
+    if (div == 0u) div = 1u;
+
+    for (; div <= 65536u; div++)
     {
-        case 1: ch->TIMx->CCR1 = compare; break;
-        case 2: ch->TIMx->CCR2 = compare; break;
-        case 3: ch->TIMx->CCR3 = compare; break;
-        case 4: ch->TIMx->CCR4 = compare; break;
-        default: break;
+        uint32 den = div * FrequencyHz;
+        uint32 period = (TimerClockHz + den / 2u) / den;
+        uint32 actual, diff, ppm;
+
+        if (period > PWM_MAX_PERIOD) continue;
+        if (period < 2u) break;
+
+        // Sai số tương đối |f_thực - f| / f_thực, tính bằng ppm
+        actual = period * den;
+        diff = (actual > TimerClockHz) ? actual - TimerClockHz : TimerClockHz - actual;
+        ppm = (uint32)(((uint64_t)diff * 1000000u) / actual);
+        if (ppm <= PWM_FREQ_MAX_ERROR_PPM)
+        {
+            Result->prescaler = (uint16)(div - 1u);
+            Result->period = period;
+            Result->errorPpm = ppm;
+            return E_OK;
+        }
     }
+
+    return E_NOT_OK;
+}
+
+/**********************************************************
+ * @brief   Mã hóa dead-time thành DTG
+ * @details Số tick làm tròn lên, rồi lấy dải nhỏ nhất chứa nó với
+ *          bước làm tròn lên: dead-time thật không ngắn hơn yêu cầu.
+ **********************************************************/
+Std_ReturnType Pwm_DeadTimeToDtg(uint32 ClockHz, uint32 DeadTimeNs, uint8* Dtg)
+{
+    uint32 khz = ClockHz / 1000u;
+    uint32 ticks;
+
+    if (Dtg == NULL_PTR) return E_NOT_OK;
+    *Dtg = 0xFFu;
+    // ns * kHz / 10^6 = tick; quá 1008 tick thì không cần tính chính xác
+    if (khz != 0u && DeadTimeNs > 0xFFFFFFFFu / khz) return E_NOT_OK;
+    ticks = DeadTimeNs * khz;
+    ticks = ticks / 1000000u + ((ticks % 1000000u) != 0u);
+
+    if (ticks <= 127u)       *Dtg = (uint8)ticks;
+    else if (ticks <= 254u)  *Dtg = (uint8)(0x80u | (((ticks + 1u) >> 1) - 64u));
+    else if (ticks <= 504u)  *Dtg = (uint8)(0xC0u | (((ticks + 7u) >> 3) - 32u));
+    else if (ticks <= 1008u) *Dtg = (uint8)(0xE0u | (((ticks + 15u) >> 4) - 32u));
+    else return E_NOT_OK;
+
+    return E_OK;
+}
+
+/**********************************************************
+ * @brief   Đổi tần số PWM của kênh, giữ nguyên tỷ lệ duty
+ **********************************************************/
+Std_ReturnType Pwm_SetFrequency(Pwm_ChannelType ChannelNumber, uint32 FrequencyHz)
+{
+    Pwm_TimeBaseType tb;
+    const Pwm_ChannelConfigType* ch;
+
+    if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return E_NOT_OK;
+    if (ChannelNumber >= PWM_NUM_CHANNELS) return E_NOT_OK;
+    ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
+    if (ch->classType != PWM_VARIABLE_PERIOD) return E_NOT_OK;
+    if (Pwm_SolveTimeBase(Pwm_GetTimerClockHz(ch->TIMx), FrequencyHz, &tb) != E_OK) return E_NOT_OK;
+
+    // PSC, ARR và CCR của mọi kênh trên timer chốt cùng một sự kiện update
+    Pwm_BeginUpdate();
+    Pwm_RescaleTimer(ch->TIMx, tb.period);
+    ch->TIMx->PSC = tb.prescaler;
+    ch->TIMx->ARR = (uint16)(tb.period - 1u);
+    Pwm_CommitUpdate();
+
+    return E_OK;
+}
+
+/**********************************************************
+ * @brief   Bắt đầu giao dịch cập nhật: giữ giá trị preload
+ * @details Bật UDIS trên mọi timer đang dùng: các lệnh ghi CCR/ARR
+ *          sau đó chỉ nằm trong thanh ghi preload, không được
+ *          chuyển sang thanh ghi thật ở các sự kiện update.
+ *          Lồng nhau được; chỉ lần Begin ngoài cùng ghi thanh ghi.
+ * @note    Khi UDIS bật, ngắt/DMA update của các timer này cũng
+ *          không xảy ra.
+ **********************************************************/
+void Pwm_BeginUpdate(void)
+{
+    if (!Pwm_IsInitialized) return;
+    if (Pwm_UpdateDepth++ != 0u) return;
+
+    for (uint8 t = 0; t < Pwm_NumTimers; t++) Pwm_Timers[t]->CR1 |= TIM_CR1_UDIS;
+}
+
+/**********************************************************
+ * @brief   Kết thúc giao dịch: mọi giá trị đã ghi có hiệu lực
+ *          cùng lúc ở sự kiện update kế tiếp của mỗi timer
+ * @details UDIS của các timer được xóa liền nhau trong critical
+ *          section, nên các timer cùng period và cùng pha chốt
+ *          trong cùng một chu kỳ PWM (trừ khi update rơi đúng vào
+ *          vài chu kỳ CPU giữa hai lệnh ghi).
+ **********************************************************/
+void Pwm_CommitUpdate(void)
+{
+    uint32 primask;
+
+    if (!Pwm_IsInitialized || Pwm_UpdateDepth == 0u) return;
+    if (--Pwm_UpdateDepth != 0u) return;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8 t = 0; t < Pwm_NumTimers; t++) Pwm_Timers[t]->CR1 &= ~TIM_CR1_UDIS;
+    __set_PRIMASK(primask);
+}
+
+/**********************************************************
+ * @brief   Đặt duty cho nhiều kênh, có hiệu lực trong cùng một chu kỳ
+ * @param[in] Channels    Mảng số thứ tự kênh
+ * @param[in] DutyCycles  Mảng duty tương ứng (0 - 0x8000)
+ * @param[in] NumChannels Số phần tử
+ * @return  E_NOT_OK nếu chưa khởi tạo hoặc có kênh không hợp lệ
+ *          (khi đó không kênh nào bị ghi)
+ **********************************************************/
+Std_ReturnType Pwm_SetDutyCycles(const Pwm_ChannelType* Channels, const uint16* DutyCycles, uint8 NumChannels)
+{
+    if (!Pwm_IsInitialized || Channels == NULL_PTR || DutyCycles == NULL_PTR) return E_NOT_OK;
+
+    for (uint8 i = 0; i < NumChannels; i++)
+    {
+        if (Channels[i] >= Pwm_CurrentConfigPtr->NumChannels || Channels[i] >= PWM_NUM_CHANNELS) return E_NOT_OK;
+    }
+
+    Pwm_BeginUpdate();
+    for (uint8 i = 0; i < NumChannels; i++) Pwm_SetDutyCycleFast(Channels[i], DutyCycles[i]);
+    Pwm_CommitUpdate();
+
+    return E_OK;
 }
 
 /**********************************************************
  * @brief   Đặt period và duty cho PWM nếu hỗ trợ
+ * @details Các kênh khác cùng timer giữ tỷ lệ duty; ARR và mọi CCR
+ *          chốt cùng một sự kiện update như Pwm_SetFrequency.
  **********************************************************/
 void Pwm_SetPeriodAndDuty(Pwm_ChannelType ChannelNumber, Pwm_PeriodType Period, uint16 DutyCycle)
 {
     if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return;
+    if (ChannelNumber >= PWM_NUM_CHANNELS || Period == 0u) return;
     const Pwm_ChannelConfigType* ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
     if (ch->classType != PWM_VARIABLE_PERIOD) return;
 
-    ch->TIMx->ARR = Period;
-    uint16_t compare = ((uint32_t)Period * DutyCycle) >> 15;
-
-    switch (ch->channel)
-    {
-        case 1: ch->TIMx->CCR1 = compare; break;
-        case 2: ch->TIMx->CCR2 = compare; break;
-        case 3: ch->TIMx->CCR3 = compare; break;
-        case 4: ch->TIMx->CCR4 = compare; break;
-        default: break;
-    }
+    // Period tính bằng tick như defaultPeriod: ARR = Period - 1
+    Pwm_BeginUpdate();
+    Pwm_RescaleTimer(ch->TIMx, Period);
+    ch->TIMx->ARR = (uint16)(Period - 1u);
+    Pwm_SetDutyCycleFast(ChannelNumber, DutyCycle);
+    Pwm_CommitUpdate();
 }
 
 /**********************************************************
@@ -145,16 +871,21 @@ void Pwm_SetPeriodAndDuty(Pwm_ChannelType ChannelNumber, Pwm_PeriodType Period,
 void Pwm_SetOutputToIdle(Pwm_ChannelType ChannelNumber)
 {
     if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return;
+    if (ChannelNumber >= PWM_NUM_CHANNELS) return;
     const Pwm_ChannelConfigType* ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
 
-    switch (ch->channel)
+#if (PWM_RAMP_API == STD_ON)
     {
-        case 1: ch->TIMx->CCR1 = 0; break;
-        case 2: ch->TIMx->CCR2 = 0; break;
-        case 3: ch->TIMx->CCR3 = 0; break;
-        case 4: ch->TIMx->CCR4 = 0; break;
-        default: break;
+        uint32 primask = __get_PRIMASK();
+
+        __disable_irq();
+        Pwm_RampActiveMask &= (uint16)~(1u << ChannelNumber);
+        __set_PRIMASK(primask);
     }
+#endif
+    // Duty 0% / 100%: output đứng yên ở mức idleState (100% là mức polarity),
+    // Pwm_SetDutyCycle chạy lại được
+    Pwm_SetDutyCycleFast(ChannelNumber, (ch->idleState == ch->polarity) ? 0x8000u : 0u);
 }
 
 /**********************************************************
@@ -178,79 +909,509 @@ Pwm_OutputStateType Pwm_GetOutputState(Pwm_ChannelType ChannelNumber)
     return (enabled ? PWM_HIGH : PWM_LOW);
 }
 
+/**********************************************************
+ * @brief   Bật IRQ của timer trên NVIC (TIM1 có IRQ update và CC riêng)
+ **********************************************************/
+static void Pwm_EnableTimerIrq(const TIM_TypeDef* TIMx)
+{
+    NVIC_InitTypeDef n;
+
+    n.NVIC_IRQChannelPreemptionPriority = PWM_IRQ_PRIORITY;
+    n.NVIC_IRQChannelSubPriority = 0;
+    n.NVIC_IRQChannelCmd = ENABLE;
+    if (TIMx == TIM1)
+    {
+        n.NVIC_IRQChannel = TIM1_CC_IRQn;
+        NVIC_Init(&n);
+        n.NVIC_IRQChannel = TIM1_UP_IRQn;
+    }
+    else if (TIMx == TIM2) n.NVIC_IRQChannel = TIM2_IRQn;
+    else if (TIMx == TIM3) n.NVIC_IRQChannel = TIM3_IRQn;
+    else n.NVIC_IRQChannel = TIM4_IRQn;
+    NVIC_Init(&n);
+}
+
 /**********************************************************
  * @brief   Tắt ngắt cho PWM channel
+ * @details Ngắt update chỉ được tắt ở lần ngắt kế tiếp, khi timer
+ *          không còn kênh nào cần (ramp, notification update).
  **********************************************************/
 void Pwm_DisableNotification(Pwm_ChannelType ChannelNumber)
 {
+    const Pwm_ChannelConfigType* ch;
+    uint32 primask;
+    uint8 t;
+
     if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return;
-    const Pwm_ChannelConfigType* ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
+    if (ChannelNumber >= PWM_NUM_CHANNELS) return;
+    ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
+    t = Pwm_TimerIndex(ch->TIMx);
+    if (t == PWM_NUM_TIMER_IDX || ch->channel < 1u || ch->channel > 4u) return;
 
-    switch (ch->channel)
+    primask = __get_PRIMASK();
+    __disable_irq();
+    ch->TIMx->DIER &= (uint16)~(TIM_IT_CC1 << (ch->channel - 1u));
+    Pwm_UpdateNotify[t] &= (uint16)~(1u << ChannelNumber);
+    __set_PRIMASK(primask);
+}
+
+/**********************************************************
+ * @brief   Bật notification cạnh lên/xuống/cả hai cho kênh PWM
+ * @details PWM mode 1: output lên mức active ở sự kiện update và về
+ *          mức inactive khi CNT = CCR. Với CCxP = 0 (active high):
+ *          cạnh lên = update, cạnh xuống = compare; CCxP = 1 thì ngược
+ *          lại. Trạng thái lưu trong RAM, bảng cấu hình không bị sửa.
+ *          Timer center-aligned (kênh dịch pha) bị từ chối: ở đó UIF
+ *          đến cả ở đỉnh lẫn đáy, còn với CMS = 01 CCxIF chỉ bật khi
+ *          đếm xuống, nên update/compare không còn ứng với cạnh lên/xuống.
+ *          Kênh có notificationEnable = 0 hoặc không có callback thì
+ *          không bật được.
+ **********************************************************/
+void Pwm_EnableNotification(Pwm_ChannelType ChannelNumber, Pwm_EdgeNotificationType Notification)
+{
+    const Pwm_ChannelConfigType* ch;
+    uint32 primask;
+    uint16 cc, dier;
+    uint8 t, activeLow, onUpdate, onCompare;
+
+    if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return;
+    if (ChannelNumber >= PWM_NUM_CHANNELS || Pwm_ChannelCb[ChannelNumber] == NULL_PTR) return;
+    ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
+    t = Pwm_TimerIndex(ch->TIMx);
+    if (t == PWM_NUM_TIMER_IDX || ch->channel < 1u || ch->channel > 4u) return;
+    if (Pwm_ShiftedChannel(Pwm_CurrentConfigPtr, ch->TIMx) != NULL_PTR) return;
+
+    cc = (uint16)(TIM_IT_CC1 << (ch->channel - 1u));
+    activeLow = (uint8)((ch->TIMx->CCER >> ((ch->channel - 1u) * 4u + 1u)) & 1u);
+    onUpdate  = (uint8)(Notification & (activeLow ? PWM_FALLING_EDGE : PWM_RISING_EDGE));
+    onCompare = (uint8)(Notification & (activeLow ? PWM_RISING_EDGE : PWM_FALLING_EDGE));
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (onUpdate) Pwm_UpdateNotify[t] |= (uint16)(1u << ChannelNumber);
+    else          Pwm_UpdateNotify[t] &= (uint16)~(1u << ChannelNumber);
+    dier = (uint16)(ch->TIMx->DIER & ~cc);
+    if (onCompare) dier |= cc;
+    if (onUpdate)  dier |= TIM_DIER_UIE;
+    // Xóa cờ cũ để không gọi callback cho sự kiện xảy ra trước khi bật
+    ch->TIMx->SR = (uint16)~(cc | (onUpdate ? TIM_SR_UIF : 0u));
+    ch->TIMx->DIER = dier;
+    __set_PRIMASK(primask);
+
+    Pwm_EnableTimerIrq(ch->TIMx);
+}
+
+#if (PWM_RAMP_API == STD_ON)
+/**********************************************************
+ * @brief   Tra bảng 33 điểm với nội suy tuyến tính
+ * @param   x: Q15 (0 - 0x8000)
+ **********************************************************/
+static inline uint32 Pwm_LutInterp(const uint16* lut, uint32 x)
+{
+    uint32 i = x >> PWM_LUT_SHIFT;
+    uint32 f = x & ((1u << PWM_LUT_SHIFT) - 1u);
+
+    if (i >= 32u) return lut[32];
+    return lut[i] + (((uint32)(lut[i + 1u] - lut[i]) * f) >> PWM_LUT_SHIFT);
+}
+
+/**********************************************************
+ * @brief   Tra ngược bảng đồng biến: x sao cho lut(x) ~ y
+ * @details Chỉ gọi lúc khởi động ramp, không gọi trong ISR.
+ **********************************************************/
+static uint32 Pwm_LutInverse(const uint16* lut, uint32 y)
+{
+    uint32 i = 0;
+
+    if (y >= lut[32]) return 0x8000u;
+    while (lut[i + 1u] <= y) i++;
+    return (i << PWM_LUT_SHIFT) + (((y - lut[i]) << PWM_LUT_SHIFT) / (uint32)(lut[i + 1u] - lut[i]));
+}
+
+/**********************************************************
+ * @brief   Một bước ramp của các kênh thuộc timer, gọi ở ngắt update
+ * @details Mỗi kênh tối đa hai lần tra bảng, một phép nhân 32 bit
+ *          và một lệnh ghi CCR (preload: có hiệu lực chu kỳ sau).
+ **********************************************************/
+static void Pwm_RampStep(uint8 t)
+{
+    uint32 mask = Pwm_RampActiveMask & Pwm_TimerChannels[t];
+
+    while (mask != 0u)
     {
-        case 1: TIM_ITConfig(ch->TIMx, TIM_IT_CC1, DISABLE); break;
-        case 2: TIM_ITConfig(ch->TIMx, TIM_IT_CC2, DISABLE); break;
-        case 3: TIM_ITConfig(ch->TIMx, TIM_IT_CC3, DISABLE); break;
-        case 4: TIM_ITConfig(ch->TIMx, TIM_IT_CC4, DISABLE); break;
-        default: break;
+        uint8 i = (uint8)(31u - __CLZ(mask));
+        Pwm_RampType* r = &Pwm_Ramp[i];
+        uint32 pos;
+        sint32 v;
+
+        mask &= ~(1uL << i);
+        r->acc += r->step;
+        pos = r->acc >> 16;
+        if (pos >= 0x8000u)
+        {
+            // Bước cuối: ghi đúng duty đích (tra ngược bảng có sai số làm tròn)
+            Pwm_RampActiveMask &= (uint16)~(1u << i);
+            Pwm_SetDutyCycleFast(i, r->target);
+            continue;
+        }
+        if (r->shape != NULL_PTR) pos = Pwm_LutInterp(r->shape, pos);
+
+        v = r->from + (sint32)(((r->to - r->from) * (sint32)pos) >> 15);
+        Pwm_SetDutyCycleFast(i, (uint16)((r->out != NULL_PTR) ? Pwm_LutInterp(r->out, (uint32)v) : (uint32)v));
     }
 }
 
-/**
- * @brief Kích hoạt ngắt (notification) cho kênh PWM tương ứng
- *
- * @param channelId       Chỉ số của kênh PWM
- * @param notification    Loại cạnh dùng để kích hoạt ngắt (PWM_RISING_EDGE, PWM_FALLING_EDGE, hoặc cả hai)
- */
-void Pwm_EnableNotification(uint8_t channelId, Pwm_EdgeNotificationType notification)
+/**********************************************************
+ * @brief   Chạy duty của kênh tới giá trị đích trong khoảng thời gian
+ *          cho trước, bước trong ngắt update của timer
+ **********************************************************/
+Std_ReturnType Pwm_StartRamp(Pwm_ChannelType ChannelNumber, uint16 TargetDuty, uint16 DurationMs,
+                             Pwm_RampCurveType Curve)
 {
-    // Kiểm tra nếu channelId vượt quá số kênh cho phép thì thoát
-    if (channelId >= PWM_NUM_CHANNELS)
-        return;
+    const Pwm_ChannelConfigType* ch;
+    Pwm_RampType* r;
+    uint32 rate, ticks, start, primask;
 
-    // Trỏ đến cấu hình kênh PWM cụ thể
-    Pwm_ChannelConfigType *cfg = (Pwm_ChannelConfigType *) &pwmChannelscfg[channelId];
+    if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return E_NOT_OK;
+    if (ChannelNumber >= PWM_NUM_CHANNELS || TargetDuty > 0x8000u) return E_NOT_OK;
+    // Kênh không có CCR: period = 0, không tính được duty/tốc độ bước
+    if (Pwm_ChannelRt[ChannelNumber].period == 0u) return E_NOT_OK;
+    ch = &Pwm_CurrentConfigPtr->Channels[ChannelNumber];
+    r = &Pwm_Ramp[ChannelNumber];
 
-    // Lấy bộ timer tương ứng với kênh này
-    TIM_TypeDef *TIMx = cfg->TIMx;
+    // Dừng ramp cũ của kênh; duty bắt đầu là giá trị CCR hiện tại
+    primask = __get_PRIMASK();
+    __disable_irq();
+    Pwm_RampActiveMask &= (uint16)~(1u << ChannelNumber);
+    __set_PRIMASK(primask);
+    start = ((uint32)*Pwm_ChannelRt[ChannelNumber].ccr << 15) / Pwm_ChannelRt[ChannelNumber].period;
+    if (start > 0x8000u) start = 0x8000u;
 
-    // Tạo bitmask của cờ Capture/Compare tương ứng với kênh (CC1, CC2, CC3, CC4)
-    uint16_t cc_flag = TIM_IT_CC1 << (cfg->channel - 1);
+    // Số sự kiện update trong DurationMs
+    rate = Pwm_GetTimerClockHz(ch->TIMx) / (((uint32)ch->TIMx->PSC + 1u) * Pwm_ChannelRt[ChannelNumber].period);
+    ticks = (uint32)(((uint64_t)DurationMs * rate) / 1000u);
+    if (ticks == 0u)
+    {
+        Pwm_SetDutyCycleFast(ChannelNumber, TargetDuty);
+        return E_OK;
+    }
 
-    // Đánh dấu rằng kênh này đã bật notification
-    cfg->notificationEnable = 1;
+    r->acc = 0;
+    // Làm tròn lên: tiến độ đạt 0x8000 đúng ở sự kiện update thứ ticks
+    r->step = ((0x8000uL << 16) + ticks - 1u) / ticks;
+    r->target = TargetDuty;
+    switch (Curve)
+    {
+        case PWM_RAMP_LINEAR:
+            r->shape = NULL_PTR;
+            r->out = NULL_PTR;
+            r->from = (sint32)start;
+            r->to = (sint32)TargetDuty;
+            break;
+        case PWM_RAMP_GAMMA:
+            r->shape = NULL_PTR;
+            r->out = Pwm_GammaLut;
+            r->from = (sint32)Pwm_LutInverse(Pwm_GammaLut, start);
+            r->to = (sint32)Pwm_LutInverse(Pwm_GammaLut, TargetDuty);
+            break;
+        case PWM_RAMP_EASE_IN_OUT:
+            r->shape = Pwm_EaseLut;
+            r->out = NULL_PTR;
+            r->from = (sint32)start;
+            r->to = (sint32)TargetDuty;
+            break;
+        default:
+            return E_NOT_OK;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    Pwm_RampActiveMask |= (uint16)(1u << ChannelNumber);
+    ch->TIMx->DIER |= TIM_DIER_UIE;
+    __set_PRIMASK(primask);
+    Pwm_EnableTimerIrq(ch->TIMx);
+
+    return E_OK;
+}
 
-    // Nếu yêu cầu ngắt theo cạnh lên (rising edge)
-    if (notification & PWM_RISING_EDGE)
+/**********************************************************
+ * @brief   Kênh còn đang chạy ramp hay không
+ **********************************************************/
+uint8 Pwm_IsRampActive(Pwm_ChannelType ChannelNumber)
+{
+    if (ChannelNumber >= PWM_NUM_CHANNELS) return 0;
+    return (Pwm_RampActiveMask & (1u << ChannelNumber)) ? 1u : 0u;
+}
+#endif
+
+/**********************************************************
+ * @brief   Sự kiện update của timer: bước ramp, gọi notification
+ *          update; tắt UIE khi timer không còn kênh nào cần
+ **********************************************************/
+static void Pwm_UpdateIrq(TIM_TypeDef* TIMx, uint8 t)
+{
+    uint32 subs = Pwm_UpdateNotify[t];
+    uint32 users = subs;
+
+#if (PWM_RAMP_API == STD_ON)
+    Pwm_RampStep(t);
+    users |= Pwm_RampActiveMask & Pwm_TimerChannels[t];
+#endif
+
+    while (subs != 0u)
     {
-        TIM_ITConfig(TIMx, cc_flag, ENABLE); // Bật ngắt theo Capture Compare
+        uint8 ch = (uint8)(31u - __CLZ(subs));
+
+        subs &= ~(1uL << ch);
+        Pwm_ChannelCb[ch]();
     }
 
-    // Nếu yêu cầu ngắt theo cạnh xuống (falling edge)
-    if (notification & PWM_FALLING_EDGE)
+    if (users == 0u) TIMx->DIER &= (uint16)~TIM_DIER_UIE;
+}
+
+/**********************************************************
+ * @brief   Ngắt chung của các timer PWM
+ * @details Đọc SR một lần, lọc theo DIER và xóa mọi cờ sẽ xử lý bằng
+ *          một lệnh ghi. Các bit được quét từ cao xuống bằng CLZ:
+ *          CC4..CC1 tra bảng Pwm_CcChannel ra kênh và gọi callback
+ *          trong RAM, UIF gọi Pwm_UpdateIrq. Chi phí tỷ lệ với số cờ
+ *          đang bật, không với số kênh cấu hình.
+ **********************************************************/
+static void Pwm_TimerIrq(TIM_TypeDef* TIMx, uint8 t)
+{
+#if (PWM_ISR_MEASURE == STD_ON)
+    uint32 start = CycleCounter_Get();
+#endif
+    uint32 sr = (uint32)(TIMx->SR & TIMx->DIER) & PWM_IRQ_FLAGS;
+
+    TIMx->SR = (uint16)~sr;
+
+    while (sr != 0u)
     {
-        TIM_ITConfig(TIMx, TIM_IT_Update, ENABLE); // Bật ngắt theo sự kiện Update
+        uint32 bit = 31u - __CLZ(sr);
+
+        sr &= ~(1uL << bit);
+        if (bit == 0u)
+        {
+            Pwm_UpdateIrq(TIMx, t);
+        }
+        else
+        {
+            uint8 ch = Pwm_CcChannel[t][bit - 1u];
+            if (ch < PWM_NUM_CHANNELS && Pwm_ChannelCb[ch] != NULL_PTR) Pwm_ChannelCb[ch]();
+        }
+    }
+
+#if (PWM_ISR_MEASURE == STD_ON)
+    {
+        uint32 cycles = CycleCounter_Get() - start;
+        if (cycles > Pwm_IsrMaxCycles) Pwm_IsrMaxCycles = cycles;
+    }
+#endif
+}
+
+void TIM1_UP_IRQHandler(void) { Pwm_TimerIrq(TIM1, 0u); }
+void TIM1_CC_IRQHandler(void) { Pwm_TimerIrq(TIM1, 0u); }
+void TIM2_IRQHandler(void)    { Pwm_TimerIrq(TIM2, 1u); }
+void TIM3_IRQHandler(void)    { Pwm_TimerIrq(TIM3, 2u); }
+void TIM4_IRQHandler(void)    { Pwm_TimerIrq(TIM4, 3u); }
+
+#if (PWM_ISR_MEASURE == STD_ON)
+/**********************************************************
+ * @brief   Số chu kỳ CPU lớn nhất của một lần ngắt timer PWM
+ **********************************************************/
+uint32 Pwm_GetIsrMaxCycles(void)
+{
+    return Pwm_IsrMaxCycles;
+}
+#endif
+
+#if (PWM_SEQUENCE_API == STD_ON)
+/**********************************************************
+ * @brief   Tìm kênh DMA nhận request update của một timer
+ * @return  Chỉ số trong Pwm_SeqDma, PWM_SEQ_NUM_DMA nếu không có
+ **********************************************************/
+static uint8 Pwm_SeqFindDma(const TIM_TypeDef* TIMx)
+{
+    uint8 d;
+
+    for (d = 0; d < PWM_SEQ_NUM_DMA; d++)
+    {
+        if (Pwm_SeqDma[d].TIMx == TIMx) break;
+    }
+    return d;
+}
+
+/**********************************************************
+ * @brief   Khởi động DMA ghi vào thanh ghi Target mỗi sự kiện update
+ * @param   Burst: giá trị DCR (0: ghi thẳng một CCR, không dùng burst)
+ **********************************************************/
+static Std_ReturnType Pwm_SeqStart(Pwm_ChannelType ChannelNumber, volatile uint16* Target, uint16 Burst,
+                                   const uint16* Buffer, uint16 Length, Pwm_SequenceModeType Mode)
+{
+    const Pwm_SeqDmaType* map;
+    TIM_TypeDef* TIMx;
+    uint8 d;
+    uint32 ccr;
+
+    TIMx = Pwm_CurrentConfigPtr->Channels[ChannelNumber].TIMx;
+    d = Pwm_SeqFindDma(TIMx);
+    if (d == PWM_SEQ_NUM_DMA || Pwm_SeqActive[d]) return E_NOT_OK;
+    map = &Pwm_SeqDma[d];
+
+    // DMA: bộ nhớ (16 bit, tăng địa chỉ) -> CCR/DMAR (16 bit, cố định)
+    ccr = DMA_CCR1_DIR | DMA_CCR1_MINC | DMA_CCR1_PSIZE_0 | DMA_CCR1_MSIZE_0 | DMA_CCR1_PL_1 | DMA_CCR1_TEIE;
+    switch (Mode)
+    {
+        case PWM_SEQUENCE_ONE_SHOT:
+            ccr |= DMA_CCR1_TCIE;
+            break;
+        case PWM_SEQUENCE_CIRCULAR:
+            ccr |= DMA_CCR1_CIRC;
+            if (Pwm_SeqDoneCbk != NULL_PTR) ccr |= DMA_CCR1_TCIE;
+            break;
+        case PWM_SEQUENCE_DOUBLE_BUFFER:
+            ccr |= DMA_CCR1_CIRC | DMA_CCR1_HTIE | DMA_CCR1_TCIE;
+            break;
+        default:
+            return E_NOT_OK;
+    }
+
+    // Clock DMA1 được giữ đến Pwm_StopSequence
+    Clock_Request(CLOCK_DMA1);
+
+    // Kênh DMA đang được module khác dùng
+    if (map->dma->CCR & DMA_CCR1_EN)
+    {
+        Clock_Release(CLOCK_DMA1);
+        return E_NOT_OK;
+    }
+
+    map->dma->CCR   = 0;
+    DMA1->IFCR      = 0xFuL << map->flagShift;
+    map->dma->CPAR  = (uint32)Target;
+    map->dma->CMAR  = (uint32)Buffer;
+    map->dma->CNDTR = Length;
+    map->dma->CCR   = ccr;
+
+    NVIC_InitTypeDef n;
+    n.NVIC_IRQChannel = map->irq;
+    n.NVIC_IRQChannelPreemptionPriority = PWM_IRQ_PRIORITY;
+    n.NVIC_IRQChannelSubPriority = 0;
+    n.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&n);
+
+    Pwm_SeqMode[d] = Mode;
+    Pwm_SeqChannel[d] = ChannelNumber;
+    Pwm_SeqActive[d] = 1;
+
+    // Bật DMA trước, sau đó mới cho timer phát request update
+    TIMx->DCR = Burst;
+    map->dma->CCR = ccr | DMA_CCR1_EN;
+    TIMx->DIER |= TIM_DIER_UDE;
+
+    return E_OK;
+}
+
+/**********************************************************
+ * @brief   Phát chuỗi giá trị CCR trên một kênh bằng DMA
+ * @details Mỗi sự kiện update của timer, DMA ghi phần tử tiếp theo
+ *          vào thanh ghi preload CCR của kênh; giá trị có hiệu lực ở
+ *          chu kỳ PWM kế tiếp. CPU không tham gia sau khi khởi động.
+ **********************************************************/
+Std_ReturnType Pwm_StartSequence(Pwm_ChannelType ChannelNumber, const uint16* Compares, uint16 Length,
+                                 Pwm_SequenceModeType Mode)
+{
+    if (!Pwm_IsInitialized || Compares == NULL_PTR || Length == 0u) return E_NOT_OK;
+    if (ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels || ChannelNumber >= PWM_NUM_CHANNELS) return E_NOT_OK;
+    if (Mode == PWM_SEQUENCE_DOUBLE_BUFFER && Length < 2u) return E_NOT_OK;
+
+    return Pwm_SeqStart(ChannelNumber, Pwm_ChannelRt[ChannelNumber].ccr, 0u, Compares, Length, Mode);
+}
+
+/**********************************************************
+ * @brief   Phát chuỗi khung CCR cho nhiều kênh liên tiếp của một timer
+ * @details Dùng chế độ DMA burst của timer (DCR/DMAR): mỗi sự kiện
+ *          update, timer phát NumCcr request liên tiếp, DMA ghi một
+ *          khung vào CCRn..CCR(n + NumCcr - 1) qua TIMx->DMAR, với n
+ *          là kênh timer của FirstChannel. Các kênh trong khung đổi
+ *          cùng một chu kỳ.
+ **********************************************************/
+Std_ReturnType Pwm_StartSequenceBurst(Pwm_ChannelType FirstChannel, uint8 NumCcr, const uint16* Frames,
+                                      uint16 NumFrames, Pwm_SequenceModeType Mode)
+{
+    const Pwm_ChannelConfigType* ch;
+    uint32 total = (uint32)NumFrames * NumCcr;
+
+    if (!Pwm_IsInitialized || Frames == NULL_PTR || NumFrames == 0u) return E_NOT_OK;
+    if (FirstChannel >= Pwm_CurrentConfigPtr->NumChannels || FirstChannel >= PWM_NUM_CHANNELS) return E_NOT_OK;
+    ch = &Pwm_CurrentConfigPtr->Channels[FirstChannel];
+    if (NumCcr == 0u || ch->channel == 0u || ch->channel + NumCcr > 5u) return E_NOT_OK;
+    if (total > 0xFFFFu) return E_NOT_OK;
+    if (Mode == PWM_SEQUENCE_DOUBLE_BUFFER && NumFrames < 2u) return E_NOT_OK;
+
+    // DBA: chỉ số word của CCRn tính từ CR1 (CCR1 ở offset 0x34); DBL: số lần ghi - 1
+    return Pwm_SeqStart(FirstChannel, &ch->TIMx->DMAR,
+                        (uint16)(((uint16)(NumCcr - 1u) << 8) | (0x34u / 4u + ch->channel - 1u)),
+                        Frames, (uint16)total, Mode);
+}
+
+/**********************************************************
+ * @brief   Dừng chuỗi đang phát trên timer của kênh
+ * @details Kênh giữ giá trị CCR cuối cùng DMA đã ghi.
+ **********************************************************/
+void Pwm_StopSequence(Pwm_ChannelType ChannelNumber)
+{
+    TIM_TypeDef* TIMx;
+    uint8 d;
+
+    if (!Pwm_IsInitialized || ChannelNumber >= Pwm_CurrentConfigPtr->NumChannels) return;
+    TIMx = Pwm_CurrentConfigPtr->Channels[ChannelNumber].TIMx;
+    d = Pwm_SeqFindDma(TIMx);
+    if (d == PWM_SEQ_NUM_DMA || !Pwm_SeqActive[d]) return;
+
+    TIMx->DIER &= (uint16)~TIM_DIER_UDE;
+    TIMx->DCR = 0;
+    Pwm_SeqDma[d].dma->CCR = 0;
+    DMA1->IFCR = 0xFuL << Pwm_SeqDma[d].flagShift;
+    Pwm_SeqActive[d] = 0;
+
+    // Kênh DMA đã dừng mới trả clock
+    Clock_Release(CLOCK_DMA1);
+}
+
+/**********************************************************
+ * @brief   Ngắt chung của các kênh DMA phát chuỗi
+ * @details Đọc ISR một lần và xóa mọi cờ của kênh bằng một lệnh ghi IFCR.
+ **********************************************************/
+static void Pwm_SeqIrq(uint8 d)
+{
+    uint32 isr = (DMA1->ISR >> Pwm_SeqDma[d].flagShift) & 0xFu;
+    Pwm_ChannelType ch = Pwm_SeqChannel[d];
+
+    DMA1->IFCR = isr << Pwm_SeqDma[d].flagShift;
+    if (!Pwm_SeqActive[d]) return;
+
+    // Lỗi truyền: DMA đã tự tắt kênh
+    if (isr & 0x8u)
+    {
+        Pwm_StopSequence(ch);
+        return;
     }
 
-    // Xác định đúng IRQn tương ứng với timer đang dùng
-    IRQn_Type irq =
-        (TIMx == TIM2) ? TIM2_IRQn :
-        (TIMx == TIM3) ? TIM3_IRQn :
-        (TIMx == TIM4) ? TIM4_IRQn :
-        (IRQn_Type)0xFF; // Không hỗ trợ các timer khác (ví dụ TIM1)
+    if ((isr & 0x4u) && Pwm_SeqHalfCbk != NULL_PTR) Pwm_SeqHalfCbk(ch);
 
-    // Nếu xác định được IRQ hợp lệ
-    if (irq != (IRQn_Type)0xFF)
+    if (isr & 0x2u)
     {
-        NVIC_InitTypeDef n;
-        n.NVIC_IRQChannel = irq;                // Gán IRQ tương ứng
-        n.NVIC_IRQChannelPreemptionPriority = 1;// Độ ưu tiên ngắt
-        n.NVIC_IRQChannelSubPriority = 0;       // Sub-priority
-        n.NVIC_IRQChannelCmd = ENABLE;          // Cho phép ngắt
-        NVIC_Init(&n);                          // Khởi tạo NVIC
+        if (Pwm_SeqMode[d] == PWM_SEQUENCE_ONE_SHOT) Pwm_StopSequence(ch);
+        if (Pwm_SeqDoneCbk != NULL_PTR) Pwm_SeqDoneCbk(ch);
     }
 }
 
+void DMA1_Channel5_IRQHandler(void) { Pwm_SeqIrq(0u); }
+void DMA1_Channel2_IRQHandler(void) { Pwm_SeqIrq(1u); }
+void DMA1_Channel3_IRQHandler(void) { Pwm_SeqIrq(2u); }
+#endif
 
 /**********************************************************
  * @brief   Trả về thông tin phiên bản phần mềm của driver PWM
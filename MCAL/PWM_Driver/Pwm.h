@@ -47,11 +47,41 @@ typedef enum {
  * @brief   Loại cạnh để thông báo ngắt PWM
  **********************************************************/
 typedef enum {
-    PWM_RISING_EDGE  = 0x00,   /**< Cạnh lên */
-    PWM_FALLING_EDGE = 0x01,   /**< Cạnh xuống */
-    PWM_BOTH_EDGES   = 0x02    /**< Cả hai cạnh */
+    PWM_RISING_EDGE  = 0x01,   /**< Cạnh lên */
+    PWM_FALLING_EDGE = 0x02,   /**< Cạnh xuống */
+    PWM_BOTH_EDGES   = 0x03    /**< Cả hai cạnh (RISING | FALLING) */
 } Pwm_EdgeNotificationType;
 
+/**********************************************************
+ * @enum    Pwm_SequenceModeType
+ * @brief   Chế độ phát chuỗi duty bằng DMA
+ * @details ONE_SHOT: phát một lần rồi dừng, kênh giữ giá trị cuối.
+ *          CIRCULAR: lặp vòng liên tục.
+ *          DOUBLE_BUFFER: lặp vòng, báo ở nửa và cuối buffer để
+ *          ứng dụng nạp lại nửa vừa phát xong.
+ **********************************************************/
+typedef enum {
+    PWM_SEQUENCE_ONE_SHOT      = 0x00,
+    PWM_SEQUENCE_CIRCULAR      = 0x01,
+    PWM_SEQUENCE_DOUBLE_BUFFER = 0x02
+} Pwm_SequenceModeType;
+
+/* Callback phát chuỗi, tham số là kênh đã truyền cho Pwm_StartSequence */
+typedef void (*Pwm_SequenceNotificationType)(Pwm_ChannelType ChannelNumber);
+
+/**********************************************************
+ * @enum    Pwm_RampCurveType
+ * @brief   Dạng đường cong của Pwm_StartRamp
+ * @details LINEAR: duty tuyến tính theo thời gian.
+ *          GAMMA: độ sáng cảm nhận tuyến tính (duty = L^2.2), dùng cho LED.
+ *          EASE_IN_OUT: chậm ở hai đầu, nhanh ở giữa (smoothstep).
+ **********************************************************/
+typedef enum {
+    PWM_RAMP_LINEAR      = 0x00,
+    PWM_RAMP_GAMMA       = 0x01,
+    PWM_RAMP_EASE_IN_OUT = 0x02
+} Pwm_RampCurveType;
+
 /**********************************************************
  * @enum    Pwm_ChannelClassType
  * @brief   Kiểu kênh PWM (chu kỳ cố định, biến đổi, v.v.)
@@ -62,21 +92,48 @@ typedef enum {
     PWM_FIXED_PERIOD_SHIFTED = 0x02    /**< PWM period cố định, shifted */
 } Pwm_ChannelClassType;
 
+/**********************************************************
+ * @enum    Pwm_PhaseUnitType
+ * @brief   Đơn vị của pha kênh PWM_FIXED_PERIOD_SHIFTED
+ **********************************************************/
+typedef enum {
+    PWM_PHASE_TICKS        = 0x00,   /**< Tick timer, 0 .. 2*ARR - 1 */
+    PWM_PHASE_CENTIDEGREES = 0x01    /**< 1/100 độ, 0 .. 35999 */
+} Pwm_PhaseUnitType;
+
 /**********************************************************
  * @struct  Pwm_ChannelConfigType
  * @brief   Cấu trúc cấu hình cho từng kênh PWM
+ * @details Sắp theo kích thước giảm dần, các trường nhỏ gộp
+ *          thành bitfield: 28 byte/kênh trong ROM.
+ *          Khi defaultFrequencyHz khác 0, PSC/ARR do bộ giải tính từ
+ *          clock timer thật, CCR ban đầu lấy từ defaultDutyCycle và
+ *          CompareVal bị bỏ qua.
+ *          Kênh PWM_FIXED_PERIOD_SHIFTED chạy center-aligned: counter
+ *          đếm lên rồi xuống, chu kỳ PWM là 2*ARR tick và xung đối xứng
+ *          quanh CNT = 0. phase là độ trễ so với thời điểm các timer cùng
+ *          bắt đầu đếm; các kênh cùng timer chung một counter nên dùng
+ *          chung một pha.
+ *          complementary bật thêm chân CHxN của TIM1: cùng dạng sóng
+ *          với CHx nhưng đảo, hai cạnh cách nhau PWM_DEADTIME_NS.
  **********************************************************/
 typedef struct {
     TIM_TypeDef*              TIMx;             /**< Timer sử dụng (TIM1, TIM2, ...) */
-    Pwm_ChannelType           channel;          /**< Channel số (1, 2, 3, 4) */
-    Pwm_ChannelClassType      classType;        /**< Loại kênh */
-    Pwm_PeriodType            defaultPeriod;    /**< Chu kỳ mặc địnhm  */
+    volatile uint16*          CcrAddr;          /**< Địa chỉ TIMx->CCRn tính sẵn (NULL_PTR: suy ra từ channel) */
+    void (*NotificationCb)(void);               /**< Callback notification (optional) */
+    uint32                    defaultFrequencyHz; /**< Tần số mặc định (Hz); 0: dùng defaultPeriod */
+    Pwm_PeriodType            defaultPeriod;    /**< Chu kỳ mặc định (tick PWM_TICK_HZ) */
     uint16                    defaultDutyCycle; /**< Duty Cycle mặc định (0x0000 - 0x8000) */
-    Pwm_OutputStateType       polarity;         /**< Đầu ra ban đầu */
-    Pwm_OutputStateType       idleState;        /**< Trạng thái khi idle */
     uint16                    CompareVal;
-    uint8                notificationEnable;    /**< Thông báo bật ngắt hoặc tắt */
-    void (*NotificationCb)(void);               /**< Callback notification (optional) */
+    uint16                    phase;            /**< Pha của kênh shifted, đơn vị theo phaseUnit */
+    uint8                     channel            : 3; /**< Channel số (1, 2, 3, 4) */
+    uint8                     classType          : 2; /**< Loại kênh: Pwm_ChannelClassType */
+    uint8                     polarity           : 1; /**< Mức tích cực (trong duty) của CHx: Pwm_OutputStateType */
+    uint8                     idleState          : 1; /**< Trạng thái khi idle: Pwm_OutputStateType */
+    uint8                     notificationEnable : 1; /**< Thông báo bật ngắt hoặc tắt */
+    uint8                     phaseUnit          : 1; /**< Đơn vị của phase: Pwm_PhaseUnitType */
+    uint8                     complementary      : 1; /**< Bật chân CHxN (chỉ TIM1 CH1..CH3) */
+    uint8                     nPolarity          : 1; /**< Mức tích cực của CHxN: Pwm_OutputStateType */
 } Pwm_ChannelConfigType;
 
 /**********************************************************
@@ -88,21 +145,107 @@ typedef struct {
     uint8                        NumChannels; /**< Số lượng kênh PWM */
 } Pwm_ConfigType;
 
+/**********************************************************
+ * @struct  Pwm_ChannelRtType
+ * @brief   Trạng thái runtime của một kênh, dựng trong Pwm_Init
+ * @details Kênh chưa được khởi tạo trỏ tới một thanh ghi giả
+ *          trong RAM nên Pwm_SetDutyCycleFast không cần rẽ nhánh.
+ **********************************************************/
+typedef struct {
+    volatile uint16*          ccr;              /**< Thanh ghi TIMx->CCRn của kênh */
+    uint32                    period;           /**< CCR của duty 100%: ARR + 1 (edge-aligned) hoặc ARR (center-aligned); 0: không có CCR */
+} Pwm_ChannelRtType;
+
+/**********************************************************
+ * @struct  Pwm_TimeBaseType
+ * @brief   Kết quả bộ giải PSC/ARR cho một tần số
+ **********************************************************/
+typedef struct {
+    uint16                    prescaler;        /**< Giá trị ghi vào PSC (chia PSC + 1) */
+    uint32                    period;           /**< ARR + 1: số bước duty (độ phân giải) */
+    uint32                    errorPpm;         /**< Sai số tần số so với yêu cầu (ppm) */
+} Pwm_TimeBaseType;
+
+/* Bảng runtime theo số thứ tự kênh (định nghĩa ở Pwm.c) */
+extern Pwm_ChannelRtType Pwm_ChannelRt[PWM_NUM_CHANNELS];
+
 /**********************************************************
  * Khai báo các API của PWM Driver (chuẩn AUTOSAR)
  **********************************************************/
 
+/**********************************************************
+ * @brief   Đổi duty (Q15) sang giá trị CCR của kênh, dùng để dựng
+ *          buffer cho Pwm_StartSequence
+ **********************************************************/
+static inline uint16 Pwm_DutyToCompare(Pwm_ChannelType ChannelNumber, uint16 DutyCycle)
+{
+    return (uint16)((Pwm_ChannelRt[ChannelNumber].period * DutyCycle) >> 15);
+}
+
+/**********************************************************
+ * @brief   Đặt duty cycle không kiểm tra, dùng trong ISR/vòng điều khiển
+ * @details Một phép nhân-dịch và một lệnh ghi CCR; không kiểm tra
+ *          khởi tạo, số kênh hay loại kênh.
+ * @param   ChannelNumber: Số thứ tự kênh PWM (< PWM_NUM_CHANNELS)
+ * @param   DutyCycle: Tỷ lệ (0x0000 - 0x8000, ứng với 0%-100%)
+ **********************************************************/
+static inline void Pwm_SetDutyCycleFast(Pwm_ChannelType ChannelNumber, uint16 DutyCycle)
+{
+    const Pwm_ChannelRtType* rt = &Pwm_ChannelRt[ChannelNumber];
+    *rt->ccr = (uint16)((rt->period * DutyCycle) >> 15);
+}
+
 /**********************************************************
  * @brief   Khởi tạo PWM driver với cấu hình chỉ định
+ * @details Không làm gì (driver vẫn chưa khởi tạo) nếu cấu hình dùng TIM1
+ *          mà PWM_DEADTIME_NS vượt 1008 tDTS ở clock TIM1 hiện tại.
  * @param   ConfigPtr: Con trỏ tới cấu hình PWM
  **********************************************************/
 void Pwm_Init(const Pwm_ConfigType* ConfigPtr);
 
+/**********************************************************
+ * @brief   Số chu kỳ CPU của lần gọi Pwm_Init gần nhất
+ * @note    Chỉ có khi PWM_INIT_MEASURE == STD_ON
+ **********************************************************/
+uint32 Pwm_GetInitCycles(void);
+
 /**********************************************************
  * @brief   Giải phóng tài nguyên và tắt tất cả kênh PWM
+ * @details Output được đưa về idleState (như Pwm_EmergencyStop)
+ *          trước khi dừng timer, rồi giữ nguyên mức đó.
  **********************************************************/
 void Pwm_DeInit(void);
 
+/**********************************************************
+ * @brief   Dừng khẩn cấp: mọi output về idleState ngay lập tức
+ * @details Chỉ ghi các ảnh thanh ghi tính sẵn lúc Pwm_Init:
+ *          TIM1 một lệnh ghi BDTR (xóa MOE, output về OISx sau
+ *          dead-time), TIM2..TIM4 mỗi timer CCMR1 và CCMR2 với
+ *          OCxM = force active/inactive theo idleState. Không chờ
+ *          sự kiện update, không critical section: gọi được từ
+ *          ngắt lỗi (EXTI, comparator, ...).
+ *          Khi PWM_BREAK_INPUT == STD_ON, chân BKIN xóa MOE của
+ *          TIM1 bằng phần cứng, không cần CPU.
+ **********************************************************/
+void Pwm_EmergencyStop(void);
+
+/**********************************************************
+ * @brief   Chạy lại PWM sau Pwm_EmergencyStop hoặc break
+ * @details Ghi lại ảnh CCMR (PWM mode) và BDTR (MOE = 1); CCR,
+ *          PSC/ARR và counter không bị động tới nên duty/pha giữ
+ *          nguyên như trước khi dừng.
+ * @return  E_NOT_OK nếu chưa khởi tạo hoặc chân break của TIM1 vẫn
+ *          tích cực (MOE không bật được); khi đó TIM2..TIM4 vẫn dừng
+ **********************************************************/
+Std_ReturnType Pwm_EmergencyRearm(void);
+
+/**********************************************************
+ * @brief   Số chu kỳ CPU lớn nhất từ lúc vào Pwm_EmergencyStop
+ *          tới lệnh ghi cuối cùng, kể từ Pwm_Init
+ * @note    Chỉ có khi PWM_STOP_MEASURE == STD_ON
+ **********************************************************/
+uint32 Pwm_GetEmergencyStopCycles(void);
+
 /**********************************************************
  * @brief   Cài đặt duty cycle cho kênh PWM
  * @param   ChannelNumber: Số thứ tự kênh PWM
@@ -110,16 +253,149 @@ void Pwm_DeInit(void);
  **********************************************************/
 void Pwm_SetDutyCycle(Pwm_ChannelType ChannelNumber, uint16 DutyCycle);
 
+/**********************************************************
+ * @brief   Đặt duty cycle cho nhiều kênh trong cùng một chu kỳ PWM
+ * @param   Channels: Mảng số thứ tự kênh
+ * @param   DutyCycles: Mảng duty cycle tương ứng (0x0000 - 0x8000)
+ * @param   NumChannels: Số phần tử của hai mảng
+ * @return  E_OK, hoặc E_NOT_OK nếu có kênh không hợp lệ (không kênh nào bị ghi)
+ **********************************************************/
+Std_ReturnType Pwm_SetDutyCycles(const Pwm_ChannelType* Channels, const uint16* DutyCycles, uint8 NumChannels);
+
+/**********************************************************
+ * @brief   Đổi tần số PWM của kênh, giữ nguyên tỷ lệ duty
+ * @details Mọi kênh cùng timer đổi theo (chung PSC/ARR). Giá trị mới
+ *          có hiệu lực ở sự kiện update kế tiếp.
+ * @param   ChannelNumber: Số thứ tự kênh PWM (loại PWM_VARIABLE_PERIOD)
+ * @param   FrequencyHz: Tần số mong muốn (Hz)
+ * @return  E_NOT_OK nếu kênh không hợp lệ hoặc không đạt được tần số
+ *          trong sai số PWM_FREQ_MAX_ERROR_PPM
+ **********************************************************/
+Std_ReturnType Pwm_SetFrequency(Pwm_ChannelType ChannelNumber, uint32 FrequencyHz);
+
+/**********************************************************
+ * @brief   Chọn PSC/ARR cho một tần số, độ phân giải lớn nhất
+ * @details PSC nhỏ nhất có sai số trong PWM_FREQ_MAX_ERROR_PPM
+ *          (ARR + 1 lớn nhất, tối đa 65535 để CCR = period của duty
+ *          100% vừa 16 bit). Không truy cập thanh ghi. Luôn có nghiệm
+ *          khi clock / tần số >= 500 tick (sai số làm tròn <= 1000 ppm);
+ *          cao hơn thì chỉ các tần số gần clock / n, ví dụ 990 kHz ở
+ *          72 MHz trả E_NOT_OK.
+ * @param   TimerClockHz: Clock vào timer (Hz)
+ * @param   FrequencyHz: Tần số mong muốn (Hz)
+ * @param   Result: Kết quả PSC, ARR + 1 và sai số
+ * @return  E_NOT_OK nếu không có nghiệm (period dưới 2 tick hoặc
+ *          sai số vượt giới hạn)
+ **********************************************************/
+Std_ReturnType Pwm_SolveTimeBase(uint32 TimerClockHz, uint32 FrequencyHz, Pwm_TimeBaseType* Result);
+
+/**********************************************************
+ * @brief   Mã hóa dead-time (ns) thành trường DTG của TIMx->BDTR
+ * @details Bốn dải theo RM0008 (tDTS = 1/ClockHz, CKD = DIV1):
+ *            0xxxxxxx: DTG[6:0] x tDTS             (0 .. 127)
+ *            10xxxxxx: (64 + DTG[5:0]) x 2 tDTS    (128 .. 254)
+ *            110xxxxx: (32 + DTG[4:0]) x 8 tDTS    (256 .. 504)
+ *            111xxxxx: (32 + DTG[4:0]) x 16 tDTS   (512 .. 1008)
+ *          Chọn giá trị nhỏ nhất không ngắn hơn dead-time yêu cầu.
+ * @param[in]  ClockHz    Clock timer (Hz)
+ * @param[in]  DeadTimeNs Dead-time yêu cầu (ns)
+ * @param[out] Dtg        Giá trị DTG
+ * @return  E_NOT_OK nếu vượt 1008 tDTS; khi đó Dtg = 0xFF (dead-time lớn nhất)
+ **********************************************************/
+Std_ReturnType Pwm_DeadTimeToDtg(uint32 ClockHz, uint32 DeadTimeNs, uint8* Dtg);
+
+/**********************************************************
+ * @brief   Phát chuỗi giá trị CCR trên một kênh bằng DMA, mỗi phần
+ *          tử một chu kỳ PWM (request update của timer)
+ * @param   ChannelNumber: Số thứ tự kênh PWM (timer TIM1..TIM3)
+ * @param   Compares: Buffer giá trị CCR (xem Pwm_DutyToCompare), phải
+ *          tồn tại suốt thời gian phát
+ * @param   Length: Số phần tử (>= 2 với PWM_SEQUENCE_DOUBLE_BUFFER)
+ * @param   Mode: One-shot, vòng lặp hoặc double-buffer
+ * @return  E_NOT_OK nếu tham số sai, timer đang phát chuỗi khác hoặc
+ *          kênh DMA của timer đang bận
+ * @note    Chỉ có khi PWM_SEQUENCE_API == STD_ON. Mỗi timer phát một
+ *          chuỗi tại một thời điểm.
+ **********************************************************/
+Std_ReturnType Pwm_StartSequence(Pwm_ChannelType ChannelNumber, const uint16* Compares, uint16 Length,
+                                 Pwm_SequenceModeType Mode);
+
+/**********************************************************
+ * @brief   Phát chuỗi khung CCR cho NumCcr kênh timer liên tiếp,
+ *          bắt đầu từ kênh timer của FirstChannel (DMA burst)
+ * @param   FirstChannel: Kênh PWM có CCR đầu tiên của khung
+ * @param   NumCcr: Số CCR mỗi khung (1 - 4)
+ * @param   Frames: NumFrames khung, mỗi khung NumCcr giá trị liên tiếp
+ * @param   NumFrames: Số khung
+ * @param   Mode: One-shot, vòng lặp hoặc double-buffer
+ * @note    Chỉ có khi PWM_SEQUENCE_API == STD_ON
+ **********************************************************/
+Std_ReturnType Pwm_StartSequenceBurst(Pwm_ChannelType FirstChannel, uint8 NumCcr, const uint16* Frames,
+                                      uint16 NumFrames, Pwm_SequenceModeType Mode);
+
+/**********************************************************
+ * @brief   Dừng chuỗi đang phát trên timer của kênh
+ * @note    Chỉ có khi PWM_SEQUENCE_API == STD_ON
+ **********************************************************/
+void Pwm_StopSequence(Pwm_ChannelType ChannelNumber);
+
+/**********************************************************
+ * @brief   Chạy duty của kênh từ giá trị hiện tại tới TargetDuty trong
+ *          DurationMs, bước ở mỗi ngắt update của timer
+ * @details Nhiều kênh chạy đồng thời được; mỗi kênh tốn một lượng
+ *          tính toán cố định trong ISR (tối đa hai lần tra bảng 33
+ *          điểm). Gọi lại khi đang chạy thì ramp bắt đầu lại từ duty
+ *          hiện tại. Không dùng cùng lúc với Pwm_StartSequence trên
+ *          cùng kênh.
+ * @param   ChannelNumber: Số thứ tự kênh PWM
+ * @param   TargetDuty: Duty đích (0x0000 - 0x8000)
+ * @param   DurationMs: Thời gian ramp (ms); 0: đặt ngay
+ * @param   Curve: Dạng đường cong
+ * @return  E_NOT_OK nếu tham số sai hoặc kênh không có thanh ghi CCR
+ * @note    Chỉ có khi PWM_RAMP_API == STD_ON
+ **********************************************************/
+Std_ReturnType Pwm_StartRamp(Pwm_ChannelType ChannelNumber, uint16 TargetDuty, uint16 DurationMs,
+                             Pwm_RampCurveType Curve);
+
+/**********************************************************
+ * @brief   Kênh còn đang chạy ramp hay không (1: còn chạy)
+ * @note    Chỉ có khi PWM_RAMP_API == STD_ON
+ **********************************************************/
+uint8 Pwm_IsRampActive(Pwm_ChannelType ChannelNumber);
+
+/**********************************************************
+ * @brief   Bắt đầu giao dịch cập nhật nhiều kênh/timer
+ * @details CCR và ARR có preload (bật trong Pwm_Init). Trong giao dịch,
+ *          giá trị mới được giữ ở thanh ghi preload (UDIS) cho tới
+ *          Pwm_CommitUpdate. Gọi lồng nhau được.
+ * @note    Trong giao dịch, ngắt/DMA update của các timer không xảy ra.
+ **********************************************************/
+void Pwm_BeginUpdate(void);
+
+/**********************************************************
+ * @brief   Chốt giao dịch: giá trị mới có hiệu lực ở sự kiện update kế
+ *          tiếp, cùng lúc cho mọi kênh của một timer
+ * @details UDIS của các timer được xóa liền nhau với ngắt bị khóa. Các
+ *          timer khác nhau chỉ chốt cùng chu kỳ nếu update của chúng
+ *          không rơi vào vài chu kỳ CPU giữa hai lệnh ghi đó.
+ **********************************************************/
+void Pwm_CommitUpdate(void);
+
 /**********************************************************
  * @brief   Đặt period và duty cycle cho kênh PWM (nếu hỗ trợ)
+ * @details Mọi kênh cùng timer đổi period theo và giữ tỷ lệ duty;
+ *          ARR và các CCR có hiệu lực cùng một sự kiện update.
  * @param   ChannelNumber: Số thứ tự kênh PWM
- * @param   Period: Chu kỳ PWM (tính bằng tick timer)
+ * @param   Period: Chu kỳ PWM (tính bằng tick timer, phụ thuộc PSC hiện tại)
  * @param   DutyCycle: Duty cycle (0x0000 - 0x8000)
  **********************************************************/
 void Pwm_SetPeriodAndDuty(Pwm_ChannelType ChannelNumber, Pwm_PeriodType Period, uint16 DutyCycle);
 
 /**********************************************************
  * @brief   Đưa kênh PWM về trạng thái idle
+ * @details Duty 100% nếu idleState bằng polarity, ngược lại 0%, có
+ *          hiệu lực ở sự kiện update kế tiếp; ramp của kênh bị hủy.
+ *          Pwm_SetDutyCycle sau đó chạy lại kênh bình thường.
  * @param   ChannelNumber: Số thứ tự kênh PWM
  **********************************************************/
 void Pwm_SetOutputToIdle(Pwm_ChannelType ChannelNumber);
@@ -139,11 +415,20 @@ void Pwm_DisableNotification(Pwm_ChannelType ChannelNumber);
 
 /**********************************************************
  * @brief   Bật thông báo ngắt cạnh lên/xuống/cả 2 cho kênh PWM
+ * @details Chỉ cho timer edge-aligned: kênh nằm trên timer center-aligned
+ *          (có kênh PWM_FIXED_PERIOD_SHIFTED) bị bỏ qua.
  * @param   ChannelNumber: Số thứ tự kênh PWM
  * @param   Notification:  Loại cạnh cần thông báo
  **********************************************************/
 void Pwm_EnableNotification(Pwm_ChannelType ChannelNumber, Pwm_EdgeNotificationType Notification);
 
+/**********************************************************
+ * @brief   Số chu kỳ CPU lớn nhất của một lần ngắt timer PWM
+ *          (gồm ramp và callback) kể từ Pwm_Init
+ * @note    Chỉ có khi PWM_ISR_MEASURE == STD_ON
+ **********************************************************/
+uint32 Pwm_GetIsrMaxCycles(void);
+
 /**********************************************************
  * @brief   Lấy thông tin phiên bản của driver PWM
  * @param   versioninfo: Con trỏ tới cấu trúc Std_VersionInfoType để nhận thông tin phiên bản
@@ -1,14 +1,19 @@
 /**********************************************************
- * @file    Pwm_Lcfg.c
- * @brief   PWM Driver Configuration Source File (AUTOSAR)
- * @details Cấu hình các kênh PWM dùng cho STM32F103 (ví dụ: TIM2_CH1/PA0, TIM3_CH2/PA7)
- * @version 1.0
+ * @file    Pwm_cfg.c
+ * @brief   PWM Driver Configuration Source File (sinh tự động)
+ * @details File được sinh bởi MCAL/Generator/McalCfgGen.py từ
+ *          MCAL/Generator/Board.json. Không sửa tay: sửa file mô tả rồi chạy
+ *          'make gen'.
  **********************************************************/
-
 #include "Pwm_cfg.h"
 #include "stm32f10x_gpio.h"
-/* ==== Ví dụ hàm callback cho PWM notification ==== */
-void TIM2_IRQHandler(void)
+void Pwm_Channel0_Notification(void);
+
+/* USER CODE BEGIN Callbacks */
+/* ==== Ví dụ hàm callback cho PWM notification ====
+ * Được gọi từ TIM2_IRQHandler trong Pwm.c sau khi Pwm_EnableNotification
+ * bật notification cho kênh; cờ ngắt đã được driver xóa. */
+void Pwm_Channel0_Notification(void)
 {
     static uint8 valcheck = 0;
 
@@ -16,38 +21,50 @@ void TIM2_IRQHandler(void)
     // printf("PWM Channel 0 interrupt/callback!\n");
     //GPIO_ReSetBits(GPIOC, GPIO_Pin_13);
     valcheck++;
-    // ngắt quay lại học, nhưng cũng nói qua, thằng này kiểu khi có ngắt xảy ra, cụ thể là hàm
-    Pwm_EnableNotification(0, PWM_RISING_EDGE); // hoặc PWM_RISING_EDGE, PWM_FALLING_EDGE
-    // sẽ kích hoạt ngắt
 }
+/* USER CODE END Callbacks */
+
 /* ==== Cấu hình từng kênh PWM ==== */
 const Pwm_ChannelConfigType pwmChannelscfg[PinPWM] = {
-    /* Channel 0: PA0 - TIM2_CH1, có callback */
+    /* Channel 0: PA3 - TIM2_CH4 */
     {
         .TIMx             = TIM2,
+        .CcrAddr          = &TIM2->CCR4,
         .channel          = 4,
         .classType        = PWM_VARIABLE_PERIOD,
-        .defaultPeriod    = 999,          // 1ms (72MHz/72/1000)
-        .defaultDutyCycle = 0,       // Duty 0%
+        .defaultFrequencyHz = 1000u,
+        .defaultPeriod    = 999,
+        .defaultDutyCycle = 0x4000,
         .polarity         = PWM_HIGH,
         .idleState        = PWM_LOW,
         .CompareVal       = 500,
-        .notificationEnable =  1,
-        .NotificationCb   = TIM2_IRQHandler   // Callback không NULL!TIM2_IRQHandler
+        .phase            = 0,
+        .phaseUnit        = PWM_PHASE_TICKS,
+        .complementary    = 0,
+        .nPolarity        = PWM_HIGH,
+        .notificationEnable = 1,
+        .NotificationCb   = Pwm_Channel0_Notification
     },
-    /* Channel 1: PA6 - TIM3_CH2, không dùng callback */
+    /* Channel 1: PA6 - TIM3_CH1 */
     {
         .TIMx             = TIM3,
+        .CcrAddr          = &TIM3->CCR1,
         .channel          = 1,
         .classType        = PWM_VARIABLE_PERIOD,
+        .defaultFrequencyHz = 1000u,
         .defaultPeriod    = 999,
-        .defaultDutyCycle = 0,
+        .defaultDutyCycle = 0x0000,
         .polarity         = PWM_HIGH,
         .idleState        = PWM_LOW,
         .CompareVal       = 0,
-        .notificationEnable =  0,
+        .phase            = 0,
+        .phaseUnit        = PWM_PHASE_TICKS,
+        .complementary    = 0,
+        .nPolarity        = PWM_HIGH,
+        .notificationEnable = 0,
         .NotificationCb   = NULL_PTR
     }
 };
 
-/* ==== Cấu hình tổng PWM driver ==== */
+/* Ba con trỏ + 16 byte dữ liệu/bitfield: 28 byte/kênh trên Cortex-M3 */
+typedef char Pwm_ChannelConfigSizeCheck[(sizeof(Pwm_ChannelConfigType) == ((3u * sizeof(void*)) + 16u)) ? 1 : -1];
@@ -14,7 +14,86 @@
  *
  * @brief   Biến cấu hình tổng cho PWM Driver
  **********************************************************/
-#define PinPWM     12     // Tổng số chân của STM32 có trong 4 port
+#define PinPWM     2      // Số kênh có trong bảng pwmChannelscfg (generator cập nhật)
+
+/**********************************************************
+ * STD_ON: mọi timer được đưa CNT về 0 và bật cùng lúc ở cuối Pwm_Init
+ * (đồng pha giữa các timer). STD_OFF: mỗi timer chạy ngay sau khi
+ * cấu hình xong các kênh của nó.
+ **********************************************************/
+#define PWM_SYNC_START      STD_ON
+
+/**********************************************************
+ * Tần số tick khi kênh cấu hình bằng defaultPeriod (defaultFrequencyHz = 0)
+ * và sai số tần số tối đa bộ giải PSC/ARR chấp nhận
+ **********************************************************/
+#define PWM_TICK_HZ             1000000u
+#define PWM_FREQ_MAX_ERROR_PPM  1000u
+
+/**********************************************************
+ * Dead-time giữa CHx và CHxN của TIM1 (ns, chung cho mọi cặp) và mức
+ * khóa BDTR: TIM_LOCKLevel_OFF / _1 (DTG) / _2 (+ CCxP, CCxNP) / _3
+ * (+ OCxM). Mức khác OFF chỉ ghi được một lần sau reset.
+ * Dead-time tối đa 1008 tDTS (14000 ns với TIM1 72 MHz); vượt thì
+ * Pwm_Init không khởi tạo.
+ **********************************************************/
+#define PWM_DEADTIME_NS     500u
+#define PWM_LOCK_LEVEL      TIM_LOCKLevel_OFF
+
+/**********************************************************
+ * Break của TIM1 (chân BKIN = PB12, Port cấu hình input): STD_ON thì mức
+ * PWM_BREAK_POLARITY trên BKIN xóa MOE bất đồng bộ, không cần clock hay
+ * CPU, mọi output TIM1 về OISx (theo idleState). Chạy lại bằng
+ * Pwm_EmergencyRearm sau khi chân hết tích cực.
+ * PWM_BREAK_POLARITY: TIM_BreakPolarity_Low / TIM_BreakPolarity_High
+ **********************************************************/
+#ifndef PWM_BREAK_INPUT
+#define PWM_BREAK_INPUT     STD_OFF
+#endif
+#ifndef PWM_BREAK_POLARITY
+#define PWM_BREAK_POLARITY  TIM_BreakPolarity_Low
+#endif
+
+/**********************************************************
+ * Ghi nhận thời gian Pwm_EmergencyStop lớn nhất (Pwm_GetEmergencyStopCycles)
+ **********************************************************/
+#define PWM_STOP_MEASURE    STD_ON
+
+/**********************************************************
+ * Ramp/fade duty trong ngắt update (Pwm_StartRamp)
+ * Pwm.c định nghĩa TIM1_UP/TIM1_CC/TIM2/TIM3/TIM4_IRQHandler;
+ * callback notification của kênh được gọi từ các ngắt này.
+ **********************************************************/
+#define PWM_RAMP_API        STD_ON
+
+/**********************************************************
+ * Mức ưu tiên (preemption) của ngắt timer TIM1..TIM4 và ngắt DMA phát
+ * chuỗi của PWM
+ **********************************************************/
+#define PWM_IRQ_PRIORITY    1u
+
+/**********************************************************
+ * Phát chuỗi duty bằng DMA (Pwm_StartSequence)
+ * - Request update của timer kích DMA1: TIM1_UP -> Channel5,
+ *   TIM2_UP -> Channel2, TIM3_UP -> Channel3 (RM0008 bảng 78).
+ * - TIM4_UP -> Channel7 là kênh của Dio stream: không hỗ trợ TIM4.
+ * - Pwm.c định nghĩa DMA1_Channel2/3/5_IRQHandler.
+ **********************************************************/
+#define PWM_SEQUENCE_API    STD_ON
+
+/* Callback (Pwm_SequenceNotificationType) khi phát xong nửa đầu / toàn bộ buffer, NULL_PTR nếu không dùng */
+#define PWM_SEQUENCE_HALF_NOTIFICATION  NULL_PTR
+#define PWM_SEQUENCE_DONE_NOTIFICATION  NULL_PTR
+
+/**********************************************************
+ * Đo thời gian Pwm_Init (chu kỳ CPU, đọc bằng Pwm_GetInitCycles)
+ **********************************************************/
+#define PWM_INIT_MEASURE    STD_ON
+
+/**********************************************************
+ * Ghi nhận thời gian ngắt timer lớn nhất (Pwm_GetIsrMaxCycles)
+ **********************************************************/
+#define PWM_ISR_MEASURE     STD_ON
 
 extern const Pwm_ChannelConfigType pwmChannelscfg[PinPWM];
 
@@ -1,10 +1,455 @@
 #include "Port.h"
 #include "Dio.h"
 #include "Port_Cfg.h"
+#include "CycleCounter.h"
+#include "Clock.h"
 
 // Biến trạng thái xác định xem Port đã được khởi tạo hay chưa
 static uint8 PortInitState = 0;
 
+// Ảnh thanh ghi mong muốn của từng port, tính trong Port_Init
+static Port_RegImageType Port_RegImage[PORT_NUM_PORTS];
+
+// Bộ cấu hình post-build đang dùng; Port_SetsValid = 0 khi Port_Init nhận
+// một cấu hình không nằm trong Port_ConfigSets (khi đó không đổi bộ được)
+static uint8 Port_CurrentSet = 0;
+static uint8 Port_SetsValid = 0;
+
+// Ảnh thanh ghi của từng bộ cấu hình (chưa tính các thay đổi lúc runtime)
+static Port_RegImageType Port_SetImage[PORT_NUM_CONFIG_SETS][PORT_NUM_PORTS];
+
+/*
+ * Delta giữa hai bộ cấu hình: Port_SetDelta[from][to][port] chỉ chứa các
+ * nibble/bit ODR khác nhau, Port_SetDeltaPorts[from][to] đánh dấu các port
+ * có thay đổi. Tính một lần trong Port_Init.
+ */
+static Port_RegImageType Port_SetDelta[PORT_NUM_CONFIG_SETS][PORT_NUM_CONFIG_SETS][PORT_NUM_PORTS];
+static uint8 Port_SetDeltaPorts[PORT_NUM_CONFIG_SETS][PORT_NUM_CONFIG_SETS];
+
+// Các nibble/bit được Port_RefreshPortDirection giám sát (chân không đổi hướng được)
+typedef struct
+{
+    uint32 crlMask;
+    uint32 crhMask;
+    uint16 odrMask;                         // Chỉ bit chọn pull của input
+} Port_RefreshMaskType;
+
+static Port_RefreshMaskType Port_RefreshMask[PORT_NUM_CONFIG_SETS][PORT_NUM_PORTS];
+
+// Các port (bit 0 = A) mà Port đang giữ clock GPIO qua Clock manager
+static uint8 Port_ClockPorts = 0;
+
+// Số nibble CRL/CRH và bit ODR bị lệch đã được sửa lại
+static uint32 Port_DriftCount = 0;
+
+// Cấu hình đang dùng (để tra cấu hình chân khi đổi hướng/mode lúc runtime)
+static const Port_ConfigType* Port_CurrentConfigPtr = NULL_PTR;
+
+/*
+ * Trạng thái runtime của từng chân trong bảng cấu hình.
+ * Port_PinLut[set][pin] chứa sẵn 6 nibble CNF/MODE cho mọi tổ hợp
+ * (hướng, mode): nibble thứ (Direction * PORT_NUM_PIN_MODES + Mode).
+ */
+#define PORT_NUM_PIN_MODES      3u
+typedef struct
+{
+    Port_PinDirectionType direction;        // Hướng hiện tại
+    Port_PinModeType mode;                  // Mode hiện tại
+} Port_PinRuntimeType;
+
+static Port_PinRuntimeType Port_PinRt[Pincount];
+static uint32 Port_PinLut[PORT_NUM_CONFIG_SETS][Pincount];
+
+/*
+ * Chân chung khi đổi bộ: Port_SetPinMap[from][to][j] là chỉ số trong bộ
+ * 'from' của chân thứ j của bộ 'to' nếu chân đó có cùng cấu hình ở hai bộ,
+ * PORT_PIN_NONE nếu không. Delta không ghi nibble của các chân này nên
+ * hướng/mode runtime của chúng được mang sang bộ mới.
+ */
+#define PORT_PIN_NONE           0xFFu
+static uint8 Port_SetPinMap[PORT_NUM_CONFIG_SETS][PORT_NUM_CONFIG_SETS][Pincount];
+
+#if (PORT_INIT_MEASURE == STD_ON)
+// Số chu kỳ CPU của lần Port_Init / Port_SwitchConfig gần nhất
+static uint32 Port_InitCycles = 0;
+static uint32 Port_SwitchCycles = 0;
+#endif
+
+/// Giá trị reset của CRL/CRH: mọi chân là input floating (CNF = 01, MODE = 00)
+#define PORT_CR_RESET_VALUE     0x44444444uL
+
+/// @name Giá trị CNF/MODE (4 bit) trong CRL/CRH, RM0008 mục 9.2.1
+/// @{
+#define PORT_CNF_IN_ANALOG      0x0u    ///< CNF = 00, MODE = 00
+#define PORT_CNF_IN_PULL        0x8u    ///< CNF = 10, MODE = 00 (pull chọn bằng ODR)
+#define PORT_CNF_OUT_PP         0x0u    ///< CNF = 00, MODE = tốc độ
+#define PORT_CNF_OUT_OD         0x4u    ///< CNF = 01, MODE = tốc độ
+#define PORT_CNF_AF_PP          0x8u    ///< CNF = 10, MODE = tốc độ
+/// @}
+
+/**
+ * @brief Tính nibble CNF/MODE của một chân, cùng quy tắc với Port_Deploy_pin
+ *
+ * @param Portconf Con trỏ tới cấu hình một chân GPIO
+ * @return Giá trị 4 bit ghi vào CRL/CRH
+ */
+static uint8 Port_GetPinNibble(const Port_PinConfigType *Portconf)
+{
+    // MODE của output trùng giá trị GPIO_Speed_10MHz/2MHz/50MHz của SPL (1, 2, 3)
+    uint8 speed = (uint8)(Portconf->Speed & 0x3u);
+
+    if (Portconf->PinMode == PORT_PIN_MODE_ADC)
+    {
+        return PORT_CNF_IN_ANALOG;
+    }
+    if (Portconf->PinMode == PORT_PIN_MODE_PWM)
+    {
+        return (uint8)(PORT_CNF_AF_PP | speed);
+    }
+    if (Portconf->Direction == PORT_PIN_IN)
+    {
+        return PORT_CNF_IN_PULL;
+    }
+    // Output: PULL_UP -> Push-Pull, PULL_DOWN -> Open-Drain
+    return (uint8)(((Portconf->Pull == PULL_UP) ? PORT_CNF_OUT_PP : PORT_CNF_OUT_OD) | speed);
+}
+
+/**
+ * @brief Ghi nibble CNF/MODE và bit ODR của một chân vào ảnh thanh ghi
+ */
+static void Port_ImageSetPin(Port_RegImageType *img, uint8 pin, uint8 nibble,
+                             uint8 odrUsed, uint8 odrLevel)
+{
+    uint32 shift = (uint32)(pin % 8u) * 4u;
+
+    if (pin < 8u)
+    {
+        img->crl     = (img->crl & ~(0xFuL << shift)) | ((uint32)nibble << shift);
+        img->crlMask |= 0xFuL << shift;
+    }
+    else
+    {
+        img->crh     = (img->crh & ~(0xFuL << shift)) | ((uint32)nibble << shift);
+        img->crhMask |= 0xFuL << shift;
+    }
+
+    if (odrUsed)
+    {
+        img->odr     = (uint16)((img->odr & ~(1u << pin)) | ((odrLevel ? 1u : 0u) << pin));
+        img->odrMask |= (uint16)(1u << pin);
+    }
+}
+
+/**
+ * @brief Gộp bảng cấu hình chân thành ảnh CRL/CRH/ODR của từng port
+ *
+ * @param ConfigPtr Cấu hình tổng của Port
+ * @param images    Mảng PORT_NUM_PORTS ảnh thanh ghi (kết quả)
+ */
+static void Port_BuildRegImages(const Port_ConfigType* ConfigPtr, Port_RegImageType images[])
+{
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+    {
+        images[p].crl = images[p].crlMask = 0u;
+        images[p].crh = images[p].crhMask = 0u;
+        images[p].odr = images[p].odrMask = 0u;
+    }
+
+    for (uint16 i = 0; i < ConfigPtr->PortCfg_PinsCount; i++)
+    {
+        const Port_PinConfigType *pinCfg = &ConfigPtr->PinCfgType[i];
+        uint8 odrUsed = 0;
+        uint8 odrLevel = 0;
+
+        if (pinCfg->Direction == PORT_PIN_OUT)
+        {
+            // Mức mặc định của output
+            odrUsed = 1;
+            odrLevel = (pinCfg->Level == PORT_PIN_LEVEL_HIGH);
+        }
+        else if (pinCfg->PinMode == PORT_PIN_MODE_DIO)
+        {
+            // Input pull-up/pull-down được chọn bằng bit ODR
+            odrUsed = 1;
+            odrLevel = (pinCfg->Pull == PULL_UP);
+        }
+
+        Port_ImageSetPin(&images[pinCfg->PortID], PORT_CFG_BIT(pinCfg),
+                         Port_GetPinNibble(pinCfg), odrUsed, odrLevel);
+    }
+}
+
+/**
+ * @brief Tính sẵn bảng nibble CNF/MODE cho mọi tổ hợp (hướng, mode) của các chân
+ *
+ * @param ConfigPtr Bộ cấu hình
+ * @param lut       Mảng Pincount phần tử (kết quả)
+ */
+static void Port_BuildPinLut(const Port_ConfigType* ConfigPtr, uint32 lut[])
+{
+    for (uint16 i = 0; i < ConfigPtr->PortCfg_PinsCount && i < Pincount; i++)
+    {
+        Port_PinConfigType pinCfg = ConfigPtr->PinCfgType[i];
+
+        lut[i] = 0u;
+        for (uint8 dir = 0; dir < 2u; dir++)
+        {
+            for (uint8 mode = 0; mode < PORT_NUM_PIN_MODES; mode++)
+            {
+                pinCfg.Direction = (Port_PinDirectionType)dir;
+                pinCfg.PinMode = (Port_PinModeType)mode;
+                lut[i] |= (uint32)Port_GetPinNibble(&pinCfg) << ((dir * PORT_NUM_PIN_MODES + mode) * 4u);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Nạp hướng/mode hiện tại của các chân từ bộ cấu hình
+ */
+static void Port_LoadPinState(const Port_ConfigType* ConfigPtr)
+{
+    for (uint16 i = 0; i < ConfigPtr->PortCfg_PinsCount && i < Pincount; i++)
+    {
+        Port_PinRt[i].direction = PORT_CFG_DIRECTION(&ConfigPtr->PinCfgType[i]);
+        Port_PinRt[i].mode = PORT_CFG_MODE(&ConfigPtr->PinCfgType[i]);
+    }
+}
+
+/**
+ * @brief Áp dụng hướng/mode mới cho một chân bằng một lần ghi CRL/CRH
+ * @details Nibble lấy từ bảng tính sẵn. Mức ODR (mức output mặc định hoặc
+ *          chọn pull) được ghi trước bằng BSRR/BRR, sau đó ghi nibble trong
+ *          một critical section ngắn để không xung đột với ISR cùng port.
+ *
+ * @param Pin       Chỉ số chân trong bảng cấu hình
+ * @param Direction Hướng mới
+ * @param Mode      Mode mới
+ */
+static void Port_ApplyPinFast(Port_PinType Pin, Port_PinDirectionType Direction, Port_PinModeType Mode)
+{
+    const Port_PinConfigType *pinCfg = &Port_CurrentConfigPtr->PinCfgType[Pin];
+    GPIO_TypeDef *GPIOx = PORT_GET_ID(pinCfg->PortID);
+    uint8 bit = PORT_CFG_BIT(pinCfg);
+    uint32 shift = (uint32)(bit % 8u) * 4u;
+    uint32 nibble = (Port_PinLut[Port_CurrentSet][Pin] >> ((Direction * PORT_NUM_PIN_MODES + Mode) * 4u)) & 0xFu;
+    volatile uint32 *cr;
+    uint32 primask;
+
+    if (GPIOx == NULL_PTR) return;
+    cr = (bit < 8u) ? &GPIOx->CRL : &GPIOx->CRH;
+
+    // ODR trước: mức mặc định của output hoặc chọn pull-up/pull-down cho input
+    if (Direction == PORT_PIN_OUT)
+    {
+        if (pinCfg->Level == PORT_PIN_LEVEL_HIGH) GPIOx->BSRR = 1uL << bit; else GPIOx->BRR = 1uL << bit;
+    }
+    else if (Mode == PORT_PIN_MODE_DIO)
+    {
+        if (pinCfg->Pull == PULL_UP) GPIOx->BSRR = 1uL << bit; else GPIOx->BRR = 1uL << bit;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    *cr = (*cr & ~(0xFuL << shift)) | (nibble << shift);
+    __set_PRIMASK(primask);
+
+    // Giữ ảnh thanh ghi mong muốn khớp với trạng thái mới
+    if (bit < 8u)
+        Port_RegImage[pinCfg->PortID].crl = (Port_RegImage[pinCfg->PortID].crl & ~(0xFuL << shift)) | (nibble << shift);
+    else
+        Port_RegImage[pinCfg->PortID].crh = (Port_RegImage[pinCfg->PortID].crh & ~(0xFuL << shift)) | (nibble << shift);
+
+    Port_PinRt[Pin].direction = Direction;
+    Port_PinRt[Pin].mode = Mode;
+}
+
+/**
+ * @brief Tính mặt nạ refresh: chỉ các chân không cho phép đổi hướng lúc runtime
+ *
+ * @param ConfigPtr Bộ cấu hình
+ * @param masks     Mảng PORT_NUM_PORTS mặt nạ (kết quả)
+ */
+static void Port_BuildRefreshMasks(const Port_ConfigType* ConfigPtr, Port_RefreshMaskType masks[])
+{
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+    {
+        masks[p].crlMask = 0u;
+        masks[p].crhMask = 0u;
+        masks[p].odrMask = 0u;
+    }
+
+    for (uint16 i = 0; i < ConfigPtr->PortCfg_PinsCount; i++)
+    {
+        const Port_PinConfigType *pinCfg = &ConfigPtr->PinCfgType[i];
+        uint8 bit = PORT_CFG_BIT(pinCfg);
+
+        if (pinCfg->DirectionChangeable != 0) continue;
+
+        if (bit < 8u) masks[pinCfg->PortID].crlMask |= 0xFuL << (bit * 4u);
+        else          masks[pinCfg->PortID].crhMask |= 0xFuL << ((bit - 8u) * 4u);
+
+        if (pinCfg->Direction == PORT_PIN_IN && pinCfg->PinMode == PORT_PIN_MODE_DIO)
+            masks[pinCfg->PortID].odrMask |= (uint16)(1u << bit);
+    }
+}
+
+/**
+ * @brief Mở rộng mỗi nibble khác 0 thành 0xF
+ */
+static uint32 Port_NibbleMask(uint32 diff)
+{
+    diff |= diff >> 1;
+    diff |= diff >> 2;
+    return (diff & 0x11111111uL) * 0xFu;
+}
+
+/**
+ * @brief Đếm số bit 1 (chỉ chạy khi có lệch nên không nằm trên đường nhanh)
+ */
+static uint32 Port_CountBits(uint32 value)
+{
+    uint32 n = 0u;
+
+    while (value != 0u)
+    {
+        value &= value - 1u;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Ghi ảnh thanh ghi vào một port: ODR (qua BSRR) trước, sau đó CRL, CRH
+ */
+static void Port_ApplyRegImage(GPIO_TypeDef *GPIOx, const Port_RegImageType *img)
+{
+    if (img->odrMask != 0u)
+        GPIOx->BSRR = ((uint32)(~img->odr & img->odrMask) << 16) | (uint32)(img->odr & img->odrMask);
+    if (img->crlMask != 0u) GPIOx->CRL = (GPIOx->CRL & ~img->crlMask) | img->crl;
+    if (img->crhMask != 0u) GPIOx->CRH = (GPIOx->CRH & ~img->crhMask) | img->crh;
+}
+
+/**
+ * @brief Giữ clock GPIO đúng bằng tập port trong 'ports' (bit 0 = port A)
+ * @details Xin clock các port mới, trả các port không còn dùng, tất cả trong
+ *          một pha của Clock manager nên chỉ có một lần ghi APB2ENR.
+ */
+static void Port_UpdateClocks(uint8 ports)
+{
+    Clock_BeginPhase();
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+    {
+        uint8 bit = (uint8)(1u << p);
+
+        if ((ports & bit) && !(Port_ClockPorts & bit))      Clock_Request((Clock_IdType)(CLOCK_GPIOA + p));
+        else if (!(ports & bit) && (Port_ClockPorts & bit)) Clock_Release((Clock_IdType)(CLOCK_GPIOA + p));
+    }
+    Clock_EndPhase();
+    Port_ClockPorts = ports;
+}
+
+/**
+ * @brief Tính sẵn ảnh thanh ghi, bảng nibble và mặt nạ refresh của một bộ cấu hình
+ */
+static void Port_PrepareSet(const Port_ConfigType* ConfigPtr, uint8 SetId)
+{
+    if (ConfigPtr->RegImages != NULL_PTR)
+    {
+        // Ảnh đã được generator tính sẵn, chỉ chép sang RAM
+        for (uint8 p = 0; p < PORT_NUM_PORTS; p++) Port_SetImage[SetId][p] = ConfigPtr->RegImages[p];
+    }
+    else
+    {
+        Port_BuildRegImages(ConfigPtr, Port_SetImage[SetId]);
+    }
+    Port_BuildPinLut(ConfigPtr, Port_PinLut[SetId]);
+    Port_BuildRefreshMasks(ConfigPtr, Port_RefreshMask[SetId]);
+}
+
+/**
+ * @brief Delta của một thanh ghi CRL/CRH giữa hai ảnh
+ * @details Nibble có trong cả hai ảnh: chỉ ghi khi khác nhau. Nibble chỉ có
+ *          trong ảnh đích: luôn ghi. Nibble chỉ có trong ảnh nguồn: trả chân
+ *          về trạng thái reset (input floating) để kết quả không phụ thuộc
+ *          đường đổi bộ.
+ */
+static void Port_DeltaCr(uint32 fromVal, uint32 fromMask, uint32 toVal, uint32 toMask,
+                         uint32 *val, uint32 *mask)
+{
+    *mask = (Port_NibbleMask(fromVal ^ toVal) & fromMask & toMask) | (fromMask ^ toMask);
+    *val  = ((toVal & toMask) | (PORT_CR_RESET_VALUE & fromMask & ~toMask)) & *mask;
+}
+
+/**
+ * @brief Hai cấu hình chân giống hệt nhau (cùng chân, cùng mọi trường)
+ */
+static uint8 Port_SamePinConfig(const Port_PinConfigType *a, const Port_PinConfigType *b)
+{
+    return (uint8)(a->PortID == b->PortID && a->PinID == b->PinID && a->PinMode == b->PinMode &&
+                   a->Direction == b->Direction && a->Speed == b->Speed && a->Pull == b->Pull &&
+                   a->Level == b->Level && a->DirectionChangeable == b->DirectionChangeable &&
+                   a->ModeChangeable == b->ModeChangeable);
+}
+
+/**
+ * @brief Tìm các chân chung (cùng cấu hình) của bộ 'to' trong bộ 'from'
+ */
+static void Port_BuildPinMap(uint8 from, uint8 to)
+{
+    const Port_ConfigType *a = &Port_ConfigSets[from];
+    const Port_ConfigType *b = &Port_ConfigSets[to];
+
+    for (uint16 j = 0; j < Pincount; j++)
+    {
+        Port_SetPinMap[from][to][j] = PORT_PIN_NONE;
+        if (j >= b->PortCfg_PinsCount) continue;
+
+        for (uint16 i = 0; i < a->PortCfg_PinsCount && i < Pincount; i++)
+        {
+            if (Port_SamePinConfig(&a->PinCfgType[i], &b->PinCfgType[j]))
+            {
+                Port_SetPinMap[from][to][j] = (uint8)i;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tính delta thanh ghi và bảng chân chung cho mọi cặp bộ cấu hình
+ */
+static void Port_BuildSetDeltas(void)
+{
+    for (uint8 from = 0; from < PORT_NUM_CONFIG_SETS; from++)
+    {
+        for (uint8 to = 0; to < PORT_NUM_CONFIG_SETS; to++)
+        {
+            Port_SetDeltaPorts[from][to] = 0u;
+            if (from == to) continue;
+
+            Port_BuildPinMap(from, to);
+
+            for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+            {
+                const Port_RegImageType *a = &Port_SetImage[from][p];
+                const Port_RegImageType *b = &Port_SetImage[to][p];
+                Port_RegImageType *d = &Port_SetDelta[from][to][p];
+
+                Port_DeltaCr(a->crl, a->crlMask, b->crl, b->crlMask, &d->crl, &d->crlMask);
+                Port_DeltaCr(a->crh, a->crhMask, b->crh, b->crhMask, &d->crh, &d->crhMask);
+
+                // ODR: bit khác nhau hoặc bit mới có trong bộ đích
+                d->odrMask = (uint16)(((a->odr ^ b->odr) & a->odrMask & b->odrMask) | (b->odrMask & ~a->odrMask));
+                d->odr     = (uint16)(b->odr & d->odrMask);
+
+                if ((d->crlMask | d->crhMask | d->odrMask) != 0u)
+                    Port_SetDeltaPorts[from][to] |= (uint8)(1u << p);
+            }
+        }
+    }
+}
+
 /**
  * @brief Hàm triển khai cấu hình cho từng chân GPIO theo cấu hình đã định nghĩa
  *
@@ -20,24 +465,8 @@ void Port_Deploy_pin(const Port_PinConfigType *Portconf)
     // Gán tốc độ (speed)
     GPIO_InitStruct.GPIO_Speed = Portconf->Speed;
 
-    // Bật xung clock cho Port tương ứng (A, B, C, D)
-    switch (Portconf->PortID)
-    {
-        case 0:
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_ADC1 | RCC_APB1Periph_TIM2, ENABLE);
-            break;
-        case 1:
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
-            break;
-        case 2:
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOC, ENABLE);
-            break;
-        case 3:
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOD, ENABLE);
-            break;
-        default:
-            return; // Port không hợp lệ
-    }
+    // Bật xung clock cho Port tương ứng (A, B, C, D), chỉ xin lần đầu
+    Port_UpdateClocks((uint8)(Port_ClockPorts | (1u << Portconf->PortID)));
 
     // Cấu hình mode cho chân DIO
     if (Portconf->PinMode == PORT_PIN_MODE_DIO)
@@ -96,22 +525,168 @@ void Port_Deploy_pin(const Port_PinConfigType *Portconf)
  */
 void Port_Init(const Port_ConfigType* ConfigPtr)
 {
+    uint8 clockPorts = 0u;
+
     if (ConfigPtr == NULL_PTR) return;
 
-    for (uint16_t i = 0; i < ConfigPtr->PortCfg_PinsCount; i++)
+#if (PORT_INIT_MEASURE == STD_ON)
+    CycleCounter_Init();
+    uint32 start = CycleCounter_Get();
+#endif
+
+    // Cấu hình là một phần tử của Port_ConfigSets thì chuẩn bị sẵn mọi bộ để đổi nhanh
+    Port_CurrentSet = 0;
+    Port_SetsValid = 0;
+    for (uint8 s = 0; s < PORT_NUM_CONFIG_SETS; s++)
+    {
+        if (ConfigPtr == &Port_ConfigSets[s])
+        {
+            Port_CurrentSet = s;
+            Port_SetsValid = 1;
+        }
+    }
+
+    if (Port_SetsValid)
+    {
+        for (uint8 s = 0; s < PORT_NUM_CONFIG_SETS; s++) Port_PrepareSet(&Port_ConfigSets[s], s);
+        Port_BuildSetDeltas();
+    }
+    else
+    {
+        Port_PrepareSet(ConfigPtr, 0);
+    }
+
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++) Port_RegImage[p] = Port_SetImage[Port_CurrentSet][p];
+    Port_LoadPinState(ConfigPtr);
+    Port_CurrentConfigPtr = ConfigPtr;
+
+    // Giữ clock cho tất cả các port có chân trong bất kỳ bộ cấu hình nào (một lần ghi APB2ENR)
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
     {
-        // Gọi hàm cấu hình từng chân GPIO
-        Port_Deploy_pin(&ConfigPtr->PinCfgType[i]);
+        uint32 used = 0u;
+
+        for (uint8 s = 0; s < (Port_SetsValid ? PORT_NUM_CONFIG_SETS : 1u); s++)
+            used |= Port_SetImage[s][p].crlMask | Port_SetImage[s][p].crhMask;
+        if (used != 0u) clockPorts |= (uint8)(1u << p);
     }
+    Port_UpdateClocks(clockPorts);
+
+    // Mỗi port: ODR trước để output có mức đúng ngay khi chuyển sang mode output
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+    {
+        if ((Port_RegImage[p].crlMask | Port_RegImage[p].crhMask) == 0u) continue;
+        Port_ApplyRegImage(PORT_GET_ID(p), &Port_RegImage[p]);
+    }
+
+#if (PORT_INIT_MEASURE == STD_ON)
+    Port_InitCycles = CycleCounter_Get() - start;
+#endif
 
     // Đánh dấu đã khởi tạo
     PortInitState = 1;
 }
 
+#if (PORT_INIT_MEASURE == STD_ON)
+/**
+ * @brief Trả về số chu kỳ CPU của lần Port_Init gần nhất
+ */
+uint32 Port_GetInitCycles(void)
+{
+    return Port_InitCycles;
+}
+
+/**
+ * @brief Trả về số chu kỳ CPU phần ghi thanh ghi của lần Port_SwitchConfig gần nhất
+ */
+uint32 Port_GetSwitchCycles(void)
+{
+    return Port_SwitchCycles;
+}
+#endif
+
+/**
+ * @brief Chuyển sang bộ cấu hình post-build khác
+ * @details Chỉ ghi delta tính sẵn của cặp (bộ hiện tại, bộ mới) cho các port
+ *          có thay đổi: tối đa PORT_NUM_PORTS lần (BSRR, CRL, CRH). Sau đó cập
+ *          nhật ảnh RAM, trạng thái chân và cấu hình đang dùng; chân có cùng
+ *          cấu hình ở hai bộ giữ nibble và hướng/mode runtime của nó.
+ *
+ * @param SetId Chỉ số bộ cấu hình trong Port_ConfigSets
+ * @return E_OK nếu đã chuyển, E_NOT_OK nếu chưa Port_Init bằng một phần tử
+ *         của Port_ConfigSets hoặc SetId không hợp lệ
+ */
+Std_ReturnType Port_SwitchConfig(uint8 SetId)
+{
+    const uint8 *map;
+    const Port_ConfigType *next;
+    Port_PinRuntimeType rt[Pincount];
+    uint32 keepCrl[PORT_NUM_PORTS] = { 0u };
+    uint32 keepCrh[PORT_NUM_PORTS] = { 0u };
+    uint8 ports;
+
+    if (!PortInitState || !Port_SetsValid || SetId >= PORT_NUM_CONFIG_SETS) return E_NOT_OK;
+    if (SetId == Port_CurrentSet) return E_OK;
+
+#if (PORT_INIT_MEASURE == STD_ON)
+    uint32 start = CycleCounter_Get();
+#endif
+
+    ports = Port_SetDeltaPorts[Port_CurrentSet][SetId];
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+    {
+        if (ports & (1u << p)) Port_ApplyRegImage(PORT_GET_ID(p), &Port_SetDelta[Port_CurrentSet][SetId][p]);
+    }
+
+#if (PORT_INIT_MEASURE == STD_ON)
+    Port_SwitchCycles = CycleCounter_Get() - start;
+#endif
+
+    // Chân chung: phần cứng vẫn giữ nibble runtime, mang nibble đó và
+    // hướng/mode hiện tại sang ảnh RAM của bộ mới
+    map = Port_SetPinMap[Port_CurrentSet][SetId];
+    next = &Port_ConfigSets[SetId];
+    for (uint16 j = 0; j < next->PortCfg_PinsCount && j < Pincount; j++)
+    {
+        const Port_PinConfigType *pinCfg = &next->PinCfgType[j];
+        uint8 bit = PORT_CFG_BIT(pinCfg);
+
+        if (map[j] == PORT_PIN_NONE) continue;
+
+        rt[j] = Port_PinRt[map[j]];
+        if (bit < 8u) keepCrl[pinCfg->PortID] |= 0xFuL << (bit * 4u);
+        else          keepCrh[pinCfg->PortID] |= 0xFuL << ((bit - 8u) * 4u);
+    }
+
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
+    {
+        const Port_RegImageType *img = &Port_SetImage[SetId][p];
+
+        Port_RegImage[p].crl = (img->crl & ~keepCrl[p]) | (Port_RegImage[p].crl & keepCrl[p]);
+        Port_RegImage[p].crh = (img->crh & ~keepCrh[p]) | (Port_RegImage[p].crh & keepCrh[p]);
+        Port_RegImage[p].crlMask = img->crlMask;
+        Port_RegImage[p].crhMask = img->crhMask;
+        Port_RegImage[p].odr = img->odr;
+        Port_RegImage[p].odrMask = img->odrMask;
+    }
+
+    Port_LoadPinState(next);
+    for (uint16 j = 0; j < next->PortCfg_PinsCount && j < Pincount; j++)
+    {
+        if (map[j] != PORT_PIN_NONE) Port_PinRt[j] = rt[j];
+    }
+
+    Port_CurrentSet = SetId;
+    Port_CurrentConfigPtr = next;
+
+    return E_OK;
+}
+
 /**
  * @brief Cập nhật lại hướng (direction) của một chân tại runtime nếu được phép
+ * @details Dùng nibble CNF/MODE tính sẵn trong Port_Init: một lần ghi có mặt nạ
+ *          vào CRL/CRH, không bật lại clock và không gọi GPIO_Init.
  *
- * @param Pin Mã số chân (toàn cục)
+ * @param Pin Chỉ số chân trong bảng cấu hình
  * @param Direction Hướng mong muốn: IN hoặc OUT
  */
 void Port_SetPinDirection(Port_PinType Pin, Port_PinDirectionType Direction)
@@ -120,31 +695,74 @@ void Port_SetPinDirection(Port_PinType Pin, Port_PinDirectionType Direction)
     if (!PortInitState) return;
 
     // Nếu số chân không hợp lệ
-    if (Pin >= Pincount) return;
+    if (Pin >= Port_CurrentConfigPtr->PortCfg_PinsCount || Pin >= Pincount) return;
 
     // Nếu chân không cho phép thay đổi hướng trong runtime
-    if (PortCfg_Pins[Pin].DirectionChangeable == 0) return;
+    if (Port_CurrentConfigPtr->PinCfgType[Pin].DirectionChangeable == 0) return;
 
-    // Tạo một bản sao của cấu hình pin (vì cấu hình gốc là const)
-    Port_PinConfigType pinCfg = PortCfg_Pins[Pin];
+    if (Direction != PORT_PIN_IN && Direction != PORT_PIN_OUT) return;
 
-    // Cập nhật lại hướng mới
-    pinCfg.Direction = Direction;
-
-    // Áp dụng lại cấu hình mới cho chân
-    Port_Deploy_pin(&pinCfg);
+    // Áp dụng hướng mới, giữ mode hiện tại
+    Port_ApplyPinFast(Pin, Direction, Port_PinRt[Pin].mode);
 }
 
 void Port_RefreshPortDirection(void)
 {
     // Nếu chưa khởi tạo Port thì không làm gì
     if (!PortInitState) return;
-    for (uint8_t i = 0; i < Pincount; i++)
+
+    for (uint8 p = 0; p < PORT_NUM_PORTS; p++)
     {
-        if (PortCfg_Pins[Pincount].DirectionChangeable == 0)
-                Port_Deploy_pin(&PortCfg_Pins[i]);
+        const Port_RefreshMaskType *mask = &Port_RefreshMask[Port_CurrentSet][p];
+        const Port_RegImageType *img = &Port_RegImage[p];
+        GPIO_TypeDef *GPIOx;
+        uint32 primask;
+        uint32 drift;
+        uint16 odrDrift;
+
+        if ((mask->crlMask | mask->crhMask | mask->odrMask) == 0u) continue;
+
+        GPIOx = PORT_GET_ID(p);
+
+        // Đọc - so sánh - chỉ ghi lại phần bị lệch, trong critical section ngắn
+        primask = __get_PRIMASK();
+        __disable_irq();
+
+        uint32 crl = GPIOx->CRL;
+        drift = Port_NibbleMask((crl ^ img->crl) & mask->crlMask);
+        if (drift != 0u)
+        {
+            GPIOx->CRL = (crl & ~drift) | (img->crl & drift);
+            Port_DriftCount += Port_CountBits(drift & 0x11111111uL);
+        }
+
+        uint32 crh = GPIOx->CRH;
+        drift = Port_NibbleMask((crh ^ img->crh) & mask->crhMask);
+        if (drift != 0u)
+        {
+            GPIOx->CRH = (crh & ~drift) | (img->crh & drift);
+            Port_DriftCount += Port_CountBits(drift & 0x11111111uL);
+        }
+
+        odrDrift = (uint16)((GPIOx->ODR ^ img->odr) & mask->odrMask);
+        if (odrDrift != 0u)
+        {
+            GPIOx->BSRR = ((uint32)(~img->odr & odrDrift) << 16) | (uint32)(img->odr & odrDrift);
+            Port_DriftCount += Port_CountBits(odrDrift);
+        }
+
+        __set_PRIMASK(primask);
     }
 }
+
+/**
+ * @brief Tổng số lần phát hiện lệch cấu hình (nibble CRL/CRH hoặc bit pull)
+ *        đã được Port_RefreshPortDirection sửa lại kể từ khi khởi động
+ */
+uint32 Port_GetDriftCount(void)
+{
+    return Port_DriftCount;
+}
 void Port_GetVersionInfo(Std_VersionInfoType* VersionInfo)
 {
     if (VersionInfo == NULL_PTR) return;
@@ -161,17 +779,13 @@ void Port_SetPinMode(Port_PinType Pin, Port_PinModeType Mode)
     if (!PortInitState) return;
 
     // Nếu số chân không hợp lệ
-    if (Pin >= Pincount) return;
-
-    // Nếu chân không cho phép thay đổi hướng trong runtime
-    if (PortCfg_Pins[Pin].PinMode == 0) return;
+    if (Pin >= Port_CurrentConfigPtr->PortCfg_PinsCount || Pin >= Pincount) return;
 
-    // Tạo một bản sao của cấu hình pin (vì cấu hình gốc là const)
-    Port_PinConfigType pinCfg = PortCfg_Pins[Pin];
+    // Nếu chân không cho phép thay đổi mode trong runtime
+    if (Port_CurrentConfigPtr->PinCfgType[Pin].ModeChangeable == 0) return;
 
-    // Cập nhật lại hướng mới
-    pinCfg.PinMode = Mode;
+    if ((uint32)Mode >= PORT_NUM_PIN_MODES) return;
 
-    // Áp dụng lại cấu hình mới cho chân
-    Port_Deploy_pin(&pinCfg);
+    // Áp dụng mode mới, giữ hướng hiện tại
+    Port_ApplyPinFast(Pin, Port_PinRt[Pin].direction, Mode);
 }
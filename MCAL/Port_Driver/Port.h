@@ -44,24 +44,49 @@ typedef enum {
 } Port_PinDirectionType;
 
 /// @brief Cấu hình cho một chân GPIO
+/// @details Đóng gói vào một word 32 bit trong ROM (17 bit dùng). Tên trường
+///          giữ nguyên nên bảng cấu hình vẫn viết bằng designated initializer;
+///          đọc trường qua các macro PORT_CFG_* bên dưới.
 typedef struct
 {
-    uint8 PortID;                           ///< ID của Port: A = 0, B = 1,...
-    Port_PinType PinID;                     ///< Số chân trong Port: 0–15
-    Port_PinModeType PinMode;              ///< Chế độ hoạt động: DIO/ADC/PWM
-    Port_PinDirectionType Direction;       ///< Hướng chân: Input/Output
-    uint8 Speed;                            ///< Tốc độ: GPIO_Speed_10MHz, 2MHz, 50MHz
-    uint8 Pull;                             ///< Kiểu kéo: PULL_UP hoặc PULL_DOWN
-    uint8 Level;                            ///< Mức logic mặc định nếu là Output
-    uint8 DirectionChangeable;             ///< Cho phép thay đổi hướng trong runtime
-    uint8 ModeChangeable;                  ///< Cho phép thay đổi chế độ trong runtime
+    uint32 PortID              : 2;         ///< ID của Port: A = 0, B = 1,...
+    uint32 PinID               : 6;         ///< Số chân toàn cục 0–63 (chân trong Port = PinID % 16)
+    uint32 PinMode             : 2;         ///< Chế độ hoạt động: Port_PinModeType
+    uint32 Direction           : 1;         ///< Hướng chân: Port_PinDirectionType
+    uint32 Speed               : 2;         ///< Tốc độ: GPIO_Speed_10MHz, 2MHz, 50MHz
+    uint32 Pull                : 1;         ///< Kiểu kéo: PULL_UP hoặc PULL_DOWN
+    uint32 Level               : 1;         ///< Mức logic mặc định nếu là Output
+    uint32 DirectionChangeable : 1;         ///< Cho phép thay đổi hướng trong runtime
+    uint32 ModeChangeable      : 1;         ///< Cho phép thay đổi chế độ trong runtime
 } Port_PinConfigType;
 
+/// @name Truy cập các trường của Port_PinConfigType
+/// @{
+#define PORT_CFG_PORT(Cfg)          ((uint8)(Cfg)->PortID)                          ///< Chỉ số port 0–3
+#define PORT_CFG_BIT(Cfg)           ((uint8)((Cfg)->PinID & 0xFu))                  ///< Chân trong port 0–15
+#define PORT_CFG_MODE(Cfg)          ((Port_PinModeType)(Cfg)->PinMode)
+#define PORT_CFG_DIRECTION(Cfg)     ((Port_PinDirectionType)(Cfg)->Direction)
+/// @}
+
+/// @brief Ảnh thanh ghi của một port, gộp từ bảng cấu hình chân
+/// @details Chỉ các bit thuộc mặt nạ được ghi; các chân không có trong bảng
+///          cấu hình giữ nguyên giá trị đang có trong thanh ghi.
+typedef struct
+{
+    uint32 crl;                             ///< Nibble CNF/MODE của chân 0–7
+    uint32 crlMask;                         ///< Mặt nạ các nibble CRL được cấu hình
+    uint32 crh;                             ///< Nibble CNF/MODE của chân 8–15
+    uint32 crhMask;                         ///< Mặt nạ các nibble CRH được cấu hình
+    uint16 odr;                             ///< Mức output / chọn pull-up cho input
+    uint16 odrMask;                         ///< Mặt nạ các bit ODR được cấu hình
+} Port_RegImageType;
+
 /// @brief Cấu trúc cấu hình tổng cho nhiều chân GPIO
 typedef struct
 {
     const Port_PinConfigType *PinCfgType;   ///< Mảng chứa cấu hình cho từng chân
     uint16 PortCfg_PinsCount;              ///< Tổng số chân được cấu hình
+    const Port_RegImageType *RegImages;     ///< PORT_NUM_PORTS ảnh tính sẵn bởi generator (NULL_PTR: tính lúc Port_Init)
 } Port_ConfigType;
 
 /// @name Định danh các Port
@@ -70,6 +95,7 @@ typedef struct
 #define PORT_ID_B  1   ///< GPIOB
 #define PORT_ID_C  2   ///< GPIOC
 #define PORT_ID_D  3   ///< GPIOD
+#define PORT_NUM_PORTS  4u  ///< Số port do driver quản lý
 /// @}
 
 /// @name Định nghĩa là Driver version
@@ -102,12 +128,44 @@ void Port_Deploy_pin(const Port_PinConfigType *Portconf);
 
 /**
  * @brief Khởi tạo tất cả các chân theo cấu hình toàn cục
+ * @details Bảng cấu hình được gộp thành ảnh CRL/CRH/ODR của từng port (hoặc
+ *          lấy thẳng ảnh do generator tính sẵn nếu RegImages khác NULL_PTR),
+ *          sau đó mỗi port được ghi bằng 3 lệnh store (ODR trước, rồi CRL,
+ *          CRH) nên output không bị glitch khi port đang cấu hình dở.
  * @param ConfigPtr Con trỏ đến cấu trúc tổng chứa toàn bộ cấu hình chân
  */
 void Port_Init(const Port_ConfigType* ConfigPtr);
 
+/**
+ * @brief Số chu kỳ CPU của lần gọi Port_Init gần nhất
+ * @note  Chỉ có khi PORT_INIT_MEASURE == STD_ON
+ */
+uint32 Port_GetInitCycles(void);
+
+/**
+ * @brief Chuyển sang bộ cấu hình post-build khác trong Port_ConfigSets
+ * @details Chỉ ghi delta thanh ghi tính sẵn trong Port_Init cho cặp bộ hiện
+ *          tại/bộ mới, nên thời gian chuyển bị chặn bởi số port (không
+ *          khởi tạo lại). Chân chỉ có trong bộ cũ trở về input floating.
+ *          Hướng/mode đã đổi lúc runtime của chân giống nhau ở hai bộ (cùng
+ *          chân, cùng mọi trường cấu hình) được giữ nguyên cả trên thanh ghi
+ *          lẫn trong trạng thái của driver.
+ * @param SetId Chỉ số bộ cấu hình (PORT_CONFIG_SET_xxx)
+ * @return E_OK nếu thành công, E_NOT_OK nếu Port_Init không được gọi với
+ *         một phần tử của Port_ConfigSets hoặc SetId không hợp lệ
+ */
+Std_ReturnType Port_SwitchConfig(uint8 SetId);
+
+/**
+ * @brief Số chu kỳ CPU phần ghi thanh ghi của lần Port_SwitchConfig gần nhất
+ * @note  Chỉ có khi PORT_INIT_MEASURE == STD_ON
+ */
+uint32 Port_GetSwitchCycles(void);
+
 /**
  * @brief Thay đổi hướng chân (input/output) tại runtime nếu được phép
+ * @details Đường nhanh O(1): nibble CNF/MODE được tính sẵn lúc Port_Init, chỉ
+ *          một lần ghi có mặt nạ vào CRL/CRH trong critical section ngắn.
  * @param Pin Số hiệu toàn cục của chân (theo mảng cấu hình)
  * @param Direction Hướng mới (PORT_PIN_IN hoặc PORT_PIN_OUT)
  */
@@ -120,12 +178,21 @@ void Port_SetPinDirection (Port_PinType Pin, Port_PinDirectionType Direction);
  * @details Hàm này sẽ thiết lập lại hướng (Direction) cho tất cả các chân
  *          đã được cấu hình ban đầu trong `Port_Init`, dùng trong trường hợp
  *          phần mềm có thể đã thay đổi hướng của các chân trong runtime.
+ *          Mỗi port chỉ đọc CRL/CRH/ODR một lần, so với ảnh mong muốn và chỉ
+ *          ghi lại các nibble bị lệch, nên chi phí tỉ lệ theo số port, đủ rẻ
+ *          để gọi mỗi chu kỳ.
  *
  * @note Chỉ những chân không cho phép đổi hướng (`DirectionChangeable == 0`)
  *       mới được refresh lại.
  */
 void Port_RefreshPortDirection(void);
 
+/**
+ * @brief Số lần Port_RefreshPortDirection phát hiện và sửa cấu hình bị lệch
+ * @return Tổng số nibble CRL/CRH và bit pull đã sửa kể từ khi khởi động
+ */
+uint32 Port_GetDriftCount(void);
+
 /**
  * @brief Lấy thông tin version của module Port
  *
@@ -143,6 +210,7 @@ void Port_GetVersionInfo(Std_VersionInfoType* VersionInfo);
  * @param[in] Mode Chế độ mới muốn chuyển sang (DIO/ADC/PWM,...)
  *
  * @details Chỉ áp dụng được nếu `ModeChangeable` trong cấu hình là TRUE.
+ *          Dùng cùng đường nhanh O(1) như Port_SetPinDirection.
  *
  * @note Nếu không được phép thay đổi mode, hàm sẽ bỏ qua và không thực hiện.
  */
@@ -1,9 +1,18 @@
+/**********************************************************
+ * @file    Port_Cfg.c
+ * @brief   Port Driver Configuration Source File (sinh tự động)
+ * @details File được sinh bởi MCAL/Generator/McalCfgGen.py từ
+ *          MCAL/Generator/Board.json. Không sửa tay: sửa file mô tả rồi chạy
+ *          'make gen'.
+ **********************************************************/
 #include "Port_Cfg.h"
 
-const Port_PinConfigType PortCfg_Pins[Pincount] = {
+/* ==== Bộ cấu hình DEFAULT ==== */
+static const Port_PinConfigType PortCfg_Pins_DEFAULT[] = {
+    /* PC13 */
     {
-        .PortID = 2, // port c
-        .PinID = 45,// chân 13
+        .PortID = PORT_ID_C,
+        .PinID = 45,
         .PinMode = PORT_PIN_MODE_DIO,
         .Direction = PORT_PIN_OUT,
         .Speed = GPIO_Speed_2MHz,
@@ -12,9 +21,10 @@ const Port_PinConfigType PortCfg_Pins[Pincount] = {
         .DirectionChangeable = 0,
         .ModeChangeable = 0
     },
-        {
-        .PortID = 1, // port B
-        .PinID = 24,// chân 8
+    /* PB8 */
+    {
+        .PortID = PORT_ID_B,
+        .PinID = 24,
         .PinMode = PORT_PIN_MODE_DIO,
         .Direction = PORT_PIN_IN,
         .Speed = GPIO_Speed_2MHz,
@@ -23,29 +33,125 @@ const Port_PinConfigType PortCfg_Pins[Pincount] = {
         .DirectionChangeable = 0,
         .ModeChangeable = 0
     },
-     /* PA0 - TIM2_CH1 - PWM Output */
+    /* PA3 */
     {
-        .PortID = 0, // port A
-        .PinID = 3,// chân 3
+        .PortID = PORT_ID_A,
+        .PinID = 3,
         .PinMode = PORT_PIN_MODE_PWM,
         .Direction = PORT_PIN_OUT,
         .Speed = GPIO_Speed_2MHz,
-        .Pull = 0,
-        .Level = 0,
+        .Pull = PULL_DOWN,
+        .Level = PORT_PIN_LEVEL_LOW,
         .DirectionChangeable = 0,
         .ModeChangeable = 0
     },
-     /* PA6 - TIM3_CH1 - PWM Output */
+    /* PA6 */
     {
-        .PortID = 0, // port A
-        .PinID = 6,// chân 6
+        .PortID = PORT_ID_A,
+        .PinID = 6,
         .PinMode = PORT_PIN_MODE_PWM,
         .Direction = PORT_PIN_OUT,
         .Speed = GPIO_Speed_2MHz,
-        .Pull = 0,
-        .Level = 0,
+        .Pull = PULL_DOWN,
+        .Level = PORT_PIN_LEVEL_LOW,
+        .DirectionChangeable = 0,
+        .ModeChangeable = 0
+    }
+};
+
+/* Ảnh thanh ghi tính sẵn: { crl, crlMask, crh, crhMask, odr, odrMask } */
+static const Port_RegImageType PortCfg_RegImages_DEFAULT[PORT_NUM_PORTS] = {
+    /* GPIOA */ { 0x0A00A000uL, 0x0F00F000uL, 0x00000000uL, 0x00000000uL, 0x0000u, 0x0048u },
+    /* GPIOB */ { 0x00000000uL, 0x00000000uL, 0x00000008uL, 0x0000000FuL, 0x0100u, 0x0100u },
+    /* GPIOC */ { 0x00000000uL, 0x00000000uL, 0x00200000uL, 0x00F00000uL, 0x2000u, 0x2000u },
+    /* GPIOD */ { 0x00000000uL, 0x00000000uL, 0x00000000uL, 0x00000000uL, 0x0000u, 0x0000u }
+};
+
+/* ==== Bộ cấu hình SERVICE ==== */
+static const Port_PinConfigType PortCfg_Pins_SERVICE[] = {
+    /* PC13 */
+    {
+        .PortID = PORT_ID_C,
+        .PinID = 45,
+        .PinMode = PORT_PIN_MODE_DIO,
+        .Direction = PORT_PIN_OUT,
+        .Speed = GPIO_Speed_2MHz,
+        .Pull = PULL_UP,
+        .Level = PORT_PIN_LEVEL_LOW,
+        .DirectionChangeable = 0,
+        .ModeChangeable = 0
+    },
+    /* PB8 */
+    {
+        .PortID = PORT_ID_B,
+        .PinID = 24,
+        .PinMode = PORT_PIN_MODE_DIO,
+        .Direction = PORT_PIN_IN,
+        .Speed = GPIO_Speed_2MHz,
+        .Pull = PULL_UP,
+        .Level = PORT_PIN_LEVEL_LOW,
+        .DirectionChangeable = 0,
+        .ModeChangeable = 0
+    },
+    /* PA3 */
+    {
+        .PortID = PORT_ID_A,
+        .PinID = 3,
+        .PinMode = PORT_PIN_MODE_DIO,
+        .Direction = PORT_PIN_OUT,
+        .Speed = GPIO_Speed_2MHz,
+        .Pull = PULL_UP,
+        .Level = PORT_PIN_LEVEL_LOW,
+        .DirectionChangeable = 0,
+        .ModeChangeable = 0
+    },
+    /* PA6 */
+    {
+        .PortID = PORT_ID_A,
+        .PinID = 6,
+        .PinMode = PORT_PIN_MODE_DIO,
+        .Direction = PORT_PIN_OUT,
+        .Speed = GPIO_Speed_2MHz,
+        .Pull = PULL_UP,
+        .Level = PORT_PIN_LEVEL_LOW,
+        .DirectionChangeable = 0,
+        .ModeChangeable = 0
+    },
+    /* PB9 */
+    {
+        .PortID = PORT_ID_B,
+        .PinID = 25,
+        .PinMode = PORT_PIN_MODE_DIO,
+        .Direction = PORT_PIN_IN,
+        .Speed = GPIO_Speed_2MHz,
+        .Pull = PULL_UP,
+        .Level = PORT_PIN_LEVEL_LOW,
         .DirectionChangeable = 0,
         .ModeChangeable = 0
+    }
+};
+
+/* Ảnh thanh ghi tính sẵn: { crl, crlMask, crh, crhMask, odr, odrMask } */
+static const Port_RegImageType PortCfg_RegImages_SERVICE[PORT_NUM_PORTS] = {
+    /* GPIOA */ { 0x02002000uL, 0x0F00F000uL, 0x00000000uL, 0x00000000uL, 0x0000u, 0x0048u },
+    /* GPIOB */ { 0x00000000uL, 0x00000000uL, 0x00000088uL, 0x000000FFuL, 0x0300u, 0x0300u },
+    /* GPIOC */ { 0x00000000uL, 0x00000000uL, 0x00200000uL, 0x00F00000uL, 0x0000u, 0x2000u },
+    /* GPIOD */ { 0x00000000uL, 0x00000000uL, 0x00000000uL, 0x00000000uL, 0x0000u, 0x0000u }
+};
+
+/* ==== Các bộ cấu hình post-build ==== */
+const Port_ConfigType Port_ConfigSets[PORT_NUM_CONFIG_SETS] = {
+    [PORT_CONFIG_SET_DEFAULT] = {
+        .PinCfgType = PortCfg_Pins_DEFAULT,
+        .PortCfg_PinsCount = 4,
+        .RegImages = PortCfg_RegImages_DEFAULT
     },
-    // ...
-};
\ No newline at end of file
+    [PORT_CONFIG_SET_SERVICE] = {
+        .PinCfgType = PortCfg_Pins_SERVICE,
+        .PortCfg_PinsCount = 5,
+        .RegImages = PortCfg_RegImages_SERVICE
+    }
+};
+
+/* Mỗi chân chiếm đúng một word trong ROM */
+typedef char Port_PinConfigSizeCheck[(sizeof(Port_PinConfigType) == 4u) ? 1 : -1];
@@ -15,14 +15,27 @@
 #include "Port.h"  /* Bao gồm các kiểu dữ liệu chuẩn của Port Driver */
 
 /***********************************************************
- * Số lượng chân Port được cấu hình (tùy chỉnh theo dự án)
+ * Số lượng chân và các bộ cấu hình post-build
+ * (MCAL/Generator/McalCfgGen.py sinh lại khối dưới đây)
  ***********************************************************/
-#define Pincount     64     // Tổng số chân của STM32 có trong 4 port
+/* GENERATED BEGIN ConfigSets */
+#define Pincount     5      // Số chân của bộ cấu hình lớn nhất
+#define PORT_NUM_CONFIG_SETS        2u
+#define PORT_CONFIG_SET_DEFAULT     0u
+#define PORT_CONFIG_SET_SERVICE     1u
+/* GENERATED END ConfigSets */
 
 /***********************************************************
- * Mảng cấu hình chi tiết cho từng chân GPIO
- * (khai báo extern, định nghĩa cụ thể ở port_cfg.c)
+ * Đo thời gian Port_Init (chu kỳ CPU, đọc bằng Port_GetInitCycles)
  ***********************************************************/
-extern const Port_PinConfigType PortCfg_Pins[Pincount];
+#define PORT_INIT_MEASURE   STD_ON
+
+/***********************************************************
+ * Các bộ cấu hình post-build: mỗi bộ gồm bảng cấu hình chân
+ * và ảnh CRL/CRH/ODR tính sẵn (định nghĩa ở port_cfg.c).
+ * Port_Init(&Port_ConfigSets[PORT_CONFIG_SET_xxx]) chọn bộ ban
+ * đầu, Port_SwitchConfig() chuyển giữa các bộ.
+ ***********************************************************/
+extern const Port_ConfigType Port_ConfigSets[PORT_NUM_CONFIG_SETS];
 
 #endif /* PORT_CFG_H */
@@ -0,0 +1,18 @@
+/***************************************************************************
+ * @file    Det.h (host)
+ * @brief   Default Error Tracer cho bản build host: ghi lại lỗi cuối cùng
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef DET_H
+#define DET_H
+
+#include "Std_Type.h"
+
+Std_ReturnType Det_ReportError(uint16 ModuleId, uint8 InstanceId, uint8 ApiId, uint8 ErrorId);
+
+/* Số lỗi đã báo và mã của lỗi cuối cùng (chỉ có trên host) */
+extern uint32 Det_ErrorCount;
+extern uint8 Det_LastErrorId;
+
+#endif /* DET_H */
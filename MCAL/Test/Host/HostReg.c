@@ -0,0 +1,387 @@
+/***************************************************************************
+ * @file    HostReg.c
+ * @brief   Mô hình thanh ghi STM32F103 cho test host, xem HostReg.h
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "HostReg.h"
+#include "stm32f10x.h"
+
+#define HOSTREG_LOG_SIZE    65536u
+#define HOSTREG_EFLAGS_TF   0x100uL     // Trap flag x86: dừng sau một lệnh
+#define HOSTREG_PF_WRITE    0x2uL       // Bit W của mã lỗi page fault
+#define HOSTREG_DWT_CYCCNT  0xE0001004u // DWT->CYCCNT
+
+typedef struct
+{
+    uintptr_t base;
+    size_t size;
+} HostReg_RegionType;
+
+static const HostReg_RegionType HostReg_Regions[] = {
+    { 0x40000000u, 0x00030000u },       // APB1, APB2, AHB (TIM, GPIO, EXTI, DMA, RCC)
+    { 0x42000000u, 0x02000000u },       // Alias bit-band của vùng ngoại vi
+    { 0xE0000000u, 0x00100000u },       // PPB: DWT, NVIC, SCB
+};
+#define HOSTREG_NUM_REGIONS (sizeof(HostReg_Regions) / sizeof(HostReg_Regions[0]))
+
+volatile uint32_t HostReg_Primask = 0u;
+uint32_t SystemCoreClock = 72000000u;
+
+static HostReg_AccessType HostReg_Log[HOSTREG_LOG_SIZE];
+static uint32 HostReg_LogLen = 0u;
+static uint8 HostReg_Active = 0u;
+static HostReg_HookType HostReg_Hook = NULL_PTR;
+
+// Truy cập đang chờ lệnh hoàn tất (giữa SIGSEGV và SIGTRAP)
+static uintptr_t HostReg_PendingAddr = 0u;
+static uint8 HostReg_PendingWrite = 0u;
+static uint32 HostReg_PendingOld = 0u;
+static uint8 HostReg_InAccess = 0u;
+
+// Đếm lệnh bằng single-step (HostReg_CountInstructions)
+static volatile uint8 HostReg_Stepping = 0u;
+static volatile uint32 HostReg_StepCount = 0u;
+
+static volatile uint32* HostReg_Word(uint32 addr)
+{
+    return (volatile uint32*)(uintptr_t)(addr & ~3u);
+}
+
+static void HostReg_Protect(int prot)
+{
+    for (uint32 i = 0; i < HOSTREG_NUM_REGIONS; i++)
+    {
+        mprotect((void*)HostReg_Regions[i].base, HostReg_Regions[i].size, prot);
+    }
+}
+
+static int HostReg_InRegion(uintptr_t addr)
+{
+    for (uint32 i = 0; i < HOSTREG_NUM_REGIONS; i++)
+    {
+        if (addr >= HostReg_Regions[i].base && addr < HostReg_Regions[i].base + HostReg_Regions[i].size) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Địa chỉ byte và bit trong vùng ngoại vi ứng với một word alias bit-band
+ */
+static volatile uint8* HostReg_BitBandTarget(uint32 alias, uint8 *bit)
+{
+    uint32 offset = alias - (uint32)PERIPH_BB_BASE;
+
+    *bit = (uint8)((offset >> 2) & 7u);
+    return (volatile uint8*)(uintptr_t)((uint32)PERIPH_BASE + (offset >> 5));
+}
+
+static int HostReg_IsBitBand(uint32 addr)
+{
+    return addr >= (uint32)PERIPH_BB_BASE && addr < (uint32)PERIPH_BB_BASE + 0x02000000u;
+}
+
+/**
+ * @brief Hiệu ứng phần cứng trước một lệnh đọc: alias bit-band lấy bit của thanh ghi gốc
+ */
+static void HostReg_BeforeRead(uint32 addr)
+{
+    if (HostReg_IsBitBand(addr))
+    {
+        uint8 bit;
+        volatile uint8 *target = HostReg_BitBandTarget(addr, &bit);
+
+        *HostReg_Word(addr) = (*target >> bit) & 1u;
+    }
+}
+
+/**
+ * @brief Hiệu ứng phần cứng sau một lệnh ghi
+ */
+static void HostReg_AfterWrite(uint32 addr, uint32 old, uint32 value)
+{
+    uint32 word = addr & ~3u;
+    uint32 gpio;
+
+    if (HostReg_IsBitBand(addr))
+    {
+        uint8 bit;
+        volatile uint8 *target = HostReg_BitBandTarget(addr, &bit);
+        uint32 targetWord = (uint32)(uintptr_t)target & ~3u;
+        uint32 before = *HostReg_Word(targetWord);
+
+        if (value & 1u) *target = (uint8)(*target | (1u << bit));
+        else            *target = (uint8)(*target & ~(1u << bit));
+        *HostReg_Word(addr) = value & 1u;
+        HostReg_AfterWrite(targetWord, before, *HostReg_Word(targetWord));
+        return;
+    }
+
+    // GPIOA..GPIOD: BSRR/BRR chỉ ghi, tác động lên ODR, đọc lại bằng 0
+    for (gpio = (uint32)GPIOA_BASE; gpio <= (uint32)GPIOD_BASE; gpio += 0x400u)
+    {
+        volatile uint32 *odr = HostReg_Word(gpio + 0x0Cu);
+
+        if (word == gpio + 0x10u)
+        {
+            *odr = ((*odr & ~(value >> 16)) | value) & 0xFFFFu;
+            *HostReg_Word(word) = 0u;
+        }
+        else if (word == gpio + 0x14u)
+        {
+            *odr = *odr & ~value & 0xFFFFu;
+            *HostReg_Word(word) = 0u;
+        }
+    }
+
+    // EXTI->PR: ghi 1 để xóa
+    if (word == (uint32)EXTI_BASE + 0x14u) *HostReg_Word(word) = old & ~value;
+
+    // NVIC->ISERx: ghi 1 để bật; NVIC->ICERx: ghi 1 để tắt, đọc lại bằng ISERx
+    if (word >= (uint32)NVIC_BASE && word < (uint32)NVIC_BASE + 0x20u)
+    {
+        *HostReg_Word(word) = old | value;
+    }
+    if (word >= (uint32)NVIC_BASE + 0x80u && word < (uint32)NVIC_BASE + 0xA0u)
+    {
+        *HostReg_Word(word - 0x80u) &= ~value;
+        *HostReg_Word(word) = *HostReg_Word(word - 0x80u);
+    }
+
+    // DMA1->IFCR: ghi 1 để xóa cờ trong ISR
+    if (word == (uint32)DMA1_BASE + 0x04u)
+    {
+        *HostReg_Word((uint32)DMA1_BASE) &= ~value;
+        *HostReg_Word(word) = 0u;
+    }
+
+    // TIMx->SR: ghi 0 để xóa; TIMx->EGR: tự xóa
+    if (word == (uint32)TIM1_BASE + 0x10u || word == (uint32)TIM2_BASE + 0x10u ||
+        word == (uint32)TIM3_BASE + 0x10u || word == (uint32)TIM4_BASE + 0x10u)
+    {
+        *HostReg_Word(word) = old & value;
+    }
+
+    if (HostReg_Hook != NULL_PTR) HostReg_Hook(word, 1u, old, value);
+
+    if (word == (uint32)TIM1_BASE + 0x14u || word == (uint32)TIM2_BASE + 0x14u ||
+        word == (uint32)TIM3_BASE + 0x14u || word == (uint32)TIM4_BASE + 0x14u)
+    {
+        *HostReg_Word(word) = 0u;
+    }
+}
+
+static void HostReg_OnFault(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t*)context;
+    uintptr_t addr = (uintptr_t)info->si_addr;
+
+    (void)sig;
+    if (!HostReg_Active || !HostReg_InRegion(addr))
+    {
+        // Lỗi thật của chương trình: trả về hành vi mặc định (core dump)
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    HostReg_Protect(PROT_READ | PROT_WRITE);
+    HostReg_InAccess = 1u;
+    HostReg_PendingAddr = addr;
+    HostReg_PendingWrite = (uc->uc_mcontext.gregs[REG_ERR] & HOSTREG_PF_WRITE) != 0;
+    HostReg_PendingOld = *HostReg_Word((uint32)addr);
+    if (!HostReg_PendingWrite) HostReg_BeforeRead((uint32)addr);
+
+    // Chạy lại đúng lệnh vừa lỗi rồi dừng ở SIGTRAP
+    uc->uc_mcontext.gregs[REG_EFL] |= HOSTREG_EFLAGS_TF;
+}
+
+static void HostReg_OnTrap(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t*)context;
+    uint32 addr = (uint32)HostReg_PendingAddr;
+
+    (void)sig;
+    (void)info;
+    if (HostReg_Stepping && !HostReg_InAccess)
+    {
+        // Giữ TF: dừng lại sau lệnh kế tiếp
+        HostReg_StepCount++;
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~HOSTREG_EFLAGS_TF;
+
+    if (HostReg_LogLen < HOSTREG_LOG_SIZE)
+    {
+        HostReg_AccessType *a = &HostReg_Log[HostReg_LogLen++];
+
+        a->addr = addr;
+        a->value = *HostReg_Word(addr);
+        a->write = HostReg_PendingWrite;
+        a->primask = (uint8)HostReg_Primask;
+    }
+    // Hook và hiệu ứng phụ truy cập mô hình trực tiếp (vùng nhớ đang mở khóa)
+    if (HostReg_PendingWrite) HostReg_AfterWrite(addr, HostReg_PendingOld, *HostReg_Word(addr));
+    else if (HostReg_Hook != NULL_PTR) HostReg_Hook(addr & ~3u, 0u, HostReg_PendingOld, *HostReg_Word(addr));
+
+    HostReg_InAccess = 0u;
+    HostReg_Protect(PROT_NONE);
+}
+
+void HostReg_Init(void)
+{
+    struct sigaction sa;
+
+    for (uint32 i = 0; i < HOSTREG_NUM_REGIONS; i++)
+    {
+        void *p = mmap((void*)HostReg_Regions[i].base, HostReg_Regions[i].size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE | MAP_NORESERVE, -1, 0);
+
+        if (p != (void*)HostReg_Regions[i].base)
+        {
+            fprintf(stderr, "HostReg: cannot map 0x%08lx\n", (unsigned long)HostReg_Regions[i].base);
+            exit(2);
+        }
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_sigaction = HostReg_OnFault;
+    sigaction(SIGSEGV, &sa, NULL);
+    sa.sa_sigaction = HostReg_OnTrap;
+    sigaction(SIGTRAP, &sa, NULL);
+
+    HostReg_Reset();
+}
+
+void HostReg_Reset(void)
+{
+    HostReg_Stop();
+    for (uint32 i = 0; i < HOSTREG_NUM_REGIONS; i++)
+    {
+        // Bộ nhớ ẩn danh sau MADV_DONTNEED đọc lại bằng 0
+        madvise((void*)HostReg_Regions[i].base, HostReg_Regions[i].size, MADV_DONTNEED);
+    }
+
+    // Giá trị reset khác 0: CRL/CRH của GPIO = input floating
+    for (uint32 gpio = (uint32)GPIOA_BASE; gpio <= (uint32)GPIOD_BASE; gpio += 0x400u)
+    {
+        *HostReg_Word(gpio + 0x00u) = 0x44444444u;
+        *HostReg_Word(gpio + 0x04u) = 0x44444444u;
+    }
+    *HostReg_Word((uint32)RCC_BASE + 0x14u) = 0x00000014u;     // AHBENR: SRAM, FLITF
+
+    HostReg_Hook = NULL_PTR;
+    HostReg_Primask = 0u;
+    HostReg_LogLen = 0u;
+}
+
+void HostReg_Start(void)
+{
+    HostReg_Active = 1u;
+    HostReg_Protect(PROT_NONE);
+}
+
+void HostReg_Stop(void)
+{
+    HostReg_Protect(PROT_READ | PROT_WRITE);
+    HostReg_Active = 0u;
+}
+
+void HostReg_ClearLog(void)
+{
+    HostReg_LogLen = 0u;
+}
+
+void HostReg_SetHook(HostReg_HookType hook)
+{
+    HostReg_Hook = hook;
+}
+
+uint32 HostReg_Peek(uint32 addr)
+{
+    uint32 value;
+
+    if (HostReg_Active && !HostReg_InAccess) HostReg_Protect(PROT_READ | PROT_WRITE);
+    value = *HostReg_Word(addr);
+    if (HostReg_Active && !HostReg_InAccess) HostReg_Protect(PROT_NONE);
+    return value;
+}
+
+void HostReg_Poke(uint32 addr, uint32 value)
+{
+    if (HostReg_Active && !HostReg_InAccess) HostReg_Protect(PROT_READ | PROT_WRITE);
+    *HostReg_Word(addr) = value;
+    if (HostReg_Active && !HostReg_InAccess) HostReg_Protect(PROT_NONE);
+}
+
+void HostReg_TickCycleCounter(void)
+{
+    HostReg_Poke(HOSTREG_DWT_CYCCNT, HostReg_Peek(HOSTREG_DWT_CYCCNT) + 1u);
+}
+
+void HostReg_CycleHook(uint32 addr, uint8 write, uint32 old, uint32 value)
+{
+    (void)addr;
+    (void)write;
+    (void)old;
+    (void)value;
+    HostReg_TickCycleCounter();
+}
+
+uint32 HostReg_LogLength(void)
+{
+    return HostReg_LogLen;
+}
+
+const HostReg_AccessType* HostReg_LogAt(uint32 i)
+{
+    return (i < HostReg_LogLen) ? &HostReg_Log[i] : NULL_PTR;
+}
+
+uint32 HostReg_Count(uint32 addr, uint32 size, uint8 write)
+{
+    uint32 n = 0u;
+
+    for (uint32 i = 0; i < HostReg_LogLen; i++)
+    {
+        const HostReg_AccessType *a = &HostReg_Log[i];
+
+        if (a->addr < addr || a->addr >= addr + size) continue;
+        if (write == 2u || a->write == write) n++;
+    }
+    return n;
+}
+
+uint32 HostReg_CountUnmasked(uint32 addr, uint32 size)
+{
+    uint32 n = 0u;
+
+    for (uint32 i = 0; i < HostReg_LogLen; i++)
+    {
+        const HostReg_AccessType *a = &HostReg_Log[i];
+
+        if (a->addr >= addr && a->addr < addr + size && a->primask == 0u) n++;
+    }
+    return n;
+}
+
+uint32 HostReg_CountInstructions(void (*fn)(void))
+{
+    HostReg_StepCount = 0u;
+    HostReg_Stepping = 1u;
+    __asm__ volatile ("pushfq; orq $0x100, (%%rsp); popfq" ::: "memory", "cc");
+    fn();
+    __asm__ volatile ("pushfq; andq $~0x100, (%%rsp); popfq" ::: "memory", "cc");
+    HostReg_Stepping = 0u;
+    return HostReg_StepCount;
+}
@@ -0,0 +1,97 @@
+/***************************************************************************
+ * @file    HostReg.h
+ * @brief   Mô hình thanh ghi STM32F103 cho test chạy trên PC (Linux x86-64)
+ * @details Vùng ngoại vi (0x40000000), alias bit-band (0x42000000) và PPB
+ *          (0xE0000000) được ánh xạ đúng địa chỉ thật bằng mmap. Khi đang
+ *          ghi log, các vùng này bị khóa (PROT_NONE): mỗi lệnh load/store
+ *          của driver gây SIGSEGV, trình xử lý mở khóa, chạy đúng một lệnh
+ *          (cờ trap TF) rồi ghi lại địa chỉ, giá trị, chiều truy cập và
+ *          PRIMASK. Số truy cập đếm được vì vậy đúng bằng số truy cập
+ *          volatile mà driver thực hiện.
+ *
+ *          Hiệu ứng phần cứng được mô phỏng sau mỗi lệnh ghi: BSRR/BRR cập
+ *          nhật ODR, PR của EXTI và IFCR của DMA xóa khi ghi 1, SR của TIM
+ *          xóa khi ghi 0, ISER/ICER của NVIC bật/tắt khi ghi 1, alias
+ *          bit-band đọc/ghi đúng một bit của thanh ghi gốc. Test có thể gắn thêm hook để mô phỏng ngoại vi (timer, DMA).
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef HOST_REG_H
+#define HOST_REG_H
+
+#include "Std_Type.h"
+
+/// @brief Một truy cập bus đã ghi lại
+typedef struct
+{
+    uint32 addr;        ///< Địa chỉ byte mà lệnh truy cập
+    uint32 value;       ///< Giá trị word (căn 4 byte) sau lệnh ghi / lúc đọc
+    uint8 write;        ///< 1 = ghi, 0 = đọc
+    uint8 primask;      ///< PRIMASK lúc truy cập (1 = trong critical section)
+} HostReg_AccessType;
+
+/**
+ * @brief Hook của test, gọi sau mỗi truy cập của driver (addr căn 4 byte).
+ * @details Với lệnh ghi, 'old' là word trước khi ghi và 'value' là giá trị
+ *          vừa ghi; với lệnh đọc, 'value' là giá trị driver nhận được. Hook
+ *          chạy như một ngắt xen giữa hai lệnh của driver: nó có thể đổi
+ *          thanh ghi bằng HostReg_Poke (ví dụ timer đếm, ISR ghi ODR).
+ */
+typedef void (*HostReg_HookType)(uint32 addr, uint8 write, uint32 old, uint32 value);
+
+/// Ánh xạ bộ nhớ và cài trình xử lý tín hiệu (gọi một lần đầu test)
+void HostReg_Init(void);
+
+/// Đưa mọi thanh ghi về giá trị reset (RM0008), xóa log và hook
+void HostReg_Reset(void);
+
+/// Bắt đầu / dừng ghi log truy cập của driver
+void HostReg_Start(void);
+void HostReg_Stop(void);
+
+/// Xóa log (giữ nguyên trạng thái ghi log)
+void HostReg_ClearLog(void);
+
+/// Gắn hook mô phỏng ngoại vi (NULL_PTR: bỏ)
+void HostReg_SetHook(HostReg_HookType hook);
+
+/// Đọc/ghi một word của mô hình, không ghi log và không có hiệu ứng phụ
+uint32 HostReg_Peek(uint32 addr);
+void HostReg_Poke(uint32 addr, uint32 value);
+
+/**
+ * @brief Tăng DWT CYCCNT một đơn vị, gọi từ hook sau mỗi truy cập bus
+ * @details Khi đó các số đo bằng CycleCounter_Get của driver (Pwm_GetInitCycles,
+ *          Pwm_GetIsrMaxCycles, ...) có đơn vị là truy cập bus của mô hình,
+ *          không phải chu kỳ Cortex-M3.
+ */
+void HostReg_TickCycleCounter(void);
+
+/// Hook chỉ tăng CYCCNT (HostReg_TickCycleCounter), cho test không cần mô phỏng ngoại vi
+void HostReg_CycleHook(uint32 addr, uint8 write, uint32 old, uint32 value);
+
+/// Số truy cập trong log và truy cập thứ i
+uint32 HostReg_LogLength(void);
+const HostReg_AccessType* HostReg_LogAt(uint32 i);
+
+/**
+ * @brief Đếm truy cập trong log vào [addr, addr + size)
+ * @param write 1 = chỉ lệnh ghi, 0 = chỉ lệnh đọc, 2 = cả hai
+ */
+uint32 HostReg_Count(uint32 addr, uint32 size, uint8 write);
+
+/// Số truy cập (đọc + ghi) vào [addr, addr + size) xảy ra khi PRIMASK = 0
+uint32 HostReg_CountUnmasked(uint32 addr, uint32 size);
+
+/**
+ * @brief Số lệnh máy (x86-64) chạy từ lúc gọi tới lúc fn trả về, đếm bằng
+ *        single-step; gồm cả lệnh call/ret và vài lệnh cố định của phép đo,
+ *        trừ đi số đếm của một hàm rỗng để có số lệnh của thân hàm
+ * @note  Gọi khi không ghi log (sau HostReg_Stop)
+ */
+uint32 HostReg_CountInstructions(void (*fn)(void));
+
+/// Địa chỉ một thanh ghi của mô hình dưới dạng số 32 bit
+#define HOST_ADDR(reg)      ((uint32)(uintptr_t)&(reg))
+
+#endif /* HOST_REG_H */
@@ -0,0 +1,331 @@
+/***************************************************************************
+ * @file    HostSpl.c
+ * @brief   Các hàm SPL (GPIO, RCC, TIM, misc) mà driver MCAL gọi, cho test host
+ * @details Mỗi hàm truy cập thanh ghi theo đúng trình tự của SPL 3.5 nên số
+ *          truy cập và giá trị cuối cùng trong mô hình HostReg khớp với bản
+ *          build trên chip.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "stm32f10x.h"
+#include "Det.h"
+#include "timer.h"
+
+uint32 Det_ErrorCount = 0u;
+uint8 Det_LastErrorId = 0u;
+
+Std_ReturnType Det_ReportError(uint16 ModuleId, uint8 InstanceId, uint8 ApiId, uint8 ErrorId)
+{
+    (void)ModuleId;
+    (void)InstanceId;
+    (void)ApiId;
+    Det_ErrorCount++;
+    Det_LastErrorId = ErrorId;
+    return E_OK;
+}
+
+void Delay_Init(void)
+{
+}
+
+void Delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/*==================================== RCC ====================================*/
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState)
+{
+    if (NewState != DISABLE) RCC->APB2ENR |= RCC_APB2Periph;
+    else                     RCC->APB2ENR &= ~RCC_APB2Periph;
+}
+
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState)
+{
+    if (NewState != DISABLE) RCC->APB1ENR |= RCC_APB1Periph;
+    else                     RCC->APB1ENR &= ~RCC_APB1Periph;
+}
+
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState)
+{
+    if (NewState != DISABLE) RCC->AHBENR |= RCC_AHBPeriph;
+    else                     RCC->AHBENR &= ~RCC_AHBPeriph;
+}
+
+/* HSE 8 MHz x PLL 9, APB1 /2, APB2 /1, ADC /6 */
+RCC_ClocksTypeDef HostSpl_Clocks = {
+    .SYSCLK_Frequency = 72000000u,
+    .HCLK_Frequency   = 72000000u,
+    .PCLK1_Frequency  = 36000000u,
+    .PCLK2_Frequency  = 72000000u,
+    .ADCCLK_Frequency = 12000000u
+};
+
+void RCC_GetClocksFreq(RCC_ClocksTypeDef* RCC_Clocks)
+{
+    *RCC_Clocks = HostSpl_Clocks;
+}
+
+/*==================================== GPIO ===================================*/
+
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct)
+{
+    uint32_t currentmode = (uint32_t)GPIO_InitStruct->GPIO_Mode & 0x0Fu;
+
+    if (((uint32_t)GPIO_InitStruct->GPIO_Mode & 0x10u) != 0u) currentmode |= (uint32_t)GPIO_InitStruct->GPIO_Speed;
+
+    if ((GPIO_InitStruct->GPIO_Pin & 0x00FFu) != 0u)
+    {
+        uint32_t tmpreg = GPIOx->CRL;
+
+        for (uint32_t pinpos = 0; pinpos < 8u; pinpos++)
+        {
+            if ((GPIO_InitStruct->GPIO_Pin & (1u << pinpos)) == 0u) continue;
+            tmpreg &= ~(0x0FuL << (pinpos * 4u));
+            tmpreg |= currentmode << (pinpos * 4u);
+            if (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_IPD) GPIOx->BRR = 1uL << pinpos;
+            if (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_IPU) GPIOx->BSRR = 1uL << pinpos;
+        }
+        GPIOx->CRL = tmpreg;
+    }
+
+    if (GPIO_InitStruct->GPIO_Pin > 0x00FFu)
+    {
+        uint32_t tmpreg = GPIOx->CRH;
+
+        for (uint32_t pinpos = 0; pinpos < 8u; pinpos++)
+        {
+            if ((GPIO_InitStruct->GPIO_Pin & (1u << (pinpos + 8u))) == 0u) continue;
+            tmpreg &= ~(0x0FuL << (pinpos * 4u));
+            tmpreg |= currentmode << (pinpos * 4u);
+            if (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_IPD) GPIOx->BRR = 1uL << (pinpos + 8u);
+            if (GPIO_InitStruct->GPIO_Mode == GPIO_Mode_IPU) GPIOx->BSRR = 1uL << (pinpos + 8u);
+        }
+        GPIOx->CRH = tmpreg;
+    }
+}
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->IDR & GPIO_Pin) != 0u) ? (uint8_t)Bit_SET : (uint8_t)Bit_RESET;
+}
+
+uint16_t GPIO_ReadInputData(GPIO_TypeDef* GPIOx)
+{
+    return (uint16_t)GPIOx->IDR;
+}
+
+uint16_t GPIO_ReadOutputData(GPIO_TypeDef* GPIOx)
+{
+    return (uint16_t)GPIOx->ODR;
+}
+
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->BSRR = GPIO_Pin;
+}
+
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->BRR = GPIO_Pin;
+}
+
+void GPIO_WriteBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, BitAction BitVal)
+{
+    if (BitVal != Bit_RESET) GPIOx->BSRR = GPIO_Pin;
+    else                     GPIOx->BRR = GPIO_Pin;
+}
+
+void GPIO_Write(GPIO_TypeDef* GPIOx, uint16_t PortVal)
+{
+    GPIOx->ODR = PortVal;
+}
+
+/*==================================== TIM ====================================*/
+
+static int HostSpl_IsAdvanced(const TIM_TypeDef* TIMx)
+{
+    return TIMx == TIM1;
+}
+
+void TIM_TimeBaseInit(TIM_TypeDef* TIMx, TIM_TimeBaseInitTypeDef* TIM_TimeBaseInitStruct)
+{
+    uint16_t tmpcr1 = TIMx->CR1;
+
+    tmpcr1 &= (uint16_t)~(TIM_CR1_DIR | TIM_CR1_CMS);
+    tmpcr1 |= TIM_TimeBaseInitStruct->TIM_CounterMode;
+    tmpcr1 &= (uint16_t)~0x0300u;
+    tmpcr1 |= TIM_TimeBaseInitStruct->TIM_ClockDivision;
+    TIMx->CR1 = tmpcr1;
+
+    TIMx->ARR = TIM_TimeBaseInitStruct->TIM_Period;
+    TIMx->PSC = TIM_TimeBaseInitStruct->TIM_Prescaler;
+    if (HostSpl_IsAdvanced(TIMx)) TIMx->RCR = TIM_TimeBaseInitStruct->TIM_RepetitionCounter;
+
+    // Sự kiện update nạp PSC (và RCR) ngay
+    TIMx->EGR = TIM_EGR_UG;
+}
+
+/**
+ * @brief Phần chung của TIM_OCxInit: kênh ch (0..3), CCMR là CCMR1/CCMR2,
+ *        byteShift = 0 (kênh lẻ) hoặc 8 (kênh chẵn)
+ */
+static void HostSpl_OCInit(TIM_TypeDef* TIMx, const TIM_OCInitTypeDef* oc, uint8_t ch)
+{
+    uint16_t ccerShift = (uint16_t)(ch * 4u);
+    uint16_t ccmrShift = (uint16_t)((ch & 1u) * 8u);
+    volatile uint16_t *ccmr = (ch < 2u) ? &TIMx->CCMR1 : &TIMx->CCMR2;
+    volatile uint16_t *ccr = (ch == 0u) ? &TIMx->CCR1 : (ch == 1u) ? &TIMx->CCR2 :
+                             (ch == 2u) ? &TIMx->CCR3 : &TIMx->CCR4;
+    uint16_t tmpccer;
+    uint16_t tmpcr2;
+    uint16_t tmpccmr;
+
+    TIMx->CCER &= (uint16_t)~(TIM_CCER_CC1E << ccerShift);
+    tmpccer = TIMx->CCER;
+    tmpcr2 = TIMx->CR2;
+    tmpccmr = *ccmr;
+
+    tmpccmr &= (uint16_t)~(0x0073u << ccmrShift);       // OCxM, CCxS
+    tmpccmr |= (uint16_t)(oc->TIM_OCMode << ccmrShift);
+
+    tmpccer &= (uint16_t)~(TIM_CCER_CC1P << ccerShift);
+    tmpccer |= (uint16_t)(oc->TIM_OCPolarity << ccerShift);
+    tmpccer |= (uint16_t)(oc->TIM_OutputState << ccerShift);
+
+    if (HostSpl_IsAdvanced(TIMx))
+    {
+        if (ch < 3u)
+        {
+            tmpccer &= (uint16_t)~((TIM_CCER_CC1NP | TIM_CCER_CC1NE) << ccerShift);
+            tmpccer |= (uint16_t)(oc->TIM_OCNPolarity << ccerShift);
+            tmpccer |= (uint16_t)(oc->TIM_OutputNState << ccerShift);
+            tmpcr2 &= (uint16_t)~(0x0300u << (ch * 2u));    // OISx, OISxN
+            tmpcr2 |= (uint16_t)(oc->TIM_OCIdleState << (ch * 2u));
+            tmpcr2 |= (uint16_t)(oc->TIM_OCNIdleState << (ch * 2u));
+        }
+        else
+        {
+            tmpcr2 &= (uint16_t)~0x4000u;                   // OIS4
+            tmpcr2 |= (uint16_t)(oc->TIM_OCIdleState << 6);
+        }
+    }
+
+    TIMx->CR2 = tmpcr2;
+    *ccmr = tmpccmr;
+    *ccr = oc->TIM_Pulse;
+    TIMx->CCER = tmpccer;
+}
+
+void TIM_OC1Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct) { HostSpl_OCInit(TIMx, TIM_OCInitStruct, 0u); }
+void TIM_OC2Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct) { HostSpl_OCInit(TIMx, TIM_OCInitStruct, 1u); }
+void TIM_OC3Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct) { HostSpl_OCInit(TIMx, TIM_OCInitStruct, 2u); }
+void TIM_OC4Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct) { HostSpl_OCInit(TIMx, TIM_OCInitStruct, 3u); }
+
+void TIM_OCStructInit(TIM_OCInitTypeDef* TIM_OCInitStruct)
+{
+    TIM_OCInitStruct->TIM_OCMode = TIM_OCMode_Timing;
+    TIM_OCInitStruct->TIM_OutputState = TIM_OutputState_Disable;
+    TIM_OCInitStruct->TIM_OutputNState = TIM_OutputNState_Disable;
+    TIM_OCInitStruct->TIM_Pulse = 0x0000u;
+    TIM_OCInitStruct->TIM_OCPolarity = TIM_OCPolarity_High;
+    TIM_OCInitStruct->TIM_OCNPolarity = TIM_OCPolarity_High;
+    TIM_OCInitStruct->TIM_OCIdleState = TIM_OCIdleState_Reset;
+    TIM_OCInitStruct->TIM_OCNIdleState = TIM_OCNIdleState_Reset;
+}
+
+void TIM_OC1PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload)
+{
+    TIMx->CCMR1 = (uint16_t)((TIMx->CCMR1 & ~0x0008u) | TIM_OCPreload);
+}
+
+void TIM_OC2PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload)
+{
+    TIMx->CCMR1 = (uint16_t)((TIMx->CCMR1 & ~0x0800u) | (TIM_OCPreload << 8));
+}
+
+void TIM_OC3PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload)
+{
+    TIMx->CCMR2 = (uint16_t)((TIMx->CCMR2 & ~0x0008u) | TIM_OCPreload);
+}
+
+void TIM_OC4PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload)
+{
+    TIMx->CCMR2 = (uint16_t)((TIMx->CCMR2 & ~0x0800u) | (TIM_OCPreload << 8));
+}
+
+void TIM_ARRPreloadConfig(TIM_TypeDef* TIMx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->CR1 |= TIM_CR1_ARPE;
+    else                     TIMx->CR1 &= (uint16_t)~TIM_CR1_ARPE;
+}
+
+void TIM_Cmd(TIM_TypeDef* TIMx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->CR1 |= TIM_CR1_CEN;
+    else                     TIMx->CR1 &= (uint16_t)~TIM_CR1_CEN;
+}
+
+void TIM_CtrlPWMOutputs(TIM_TypeDef* TIMx, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->BDTR |= TIM_BDTR_MOE;
+    else                     TIMx->BDTR &= (uint16_t)~TIM_BDTR_MOE;
+}
+
+void TIM_ITConfig(TIM_TypeDef* TIMx, uint16_t TIM_IT, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->DIER |= TIM_IT;
+    else                     TIMx->DIER &= (uint16_t)~TIM_IT;
+}
+
+void TIM_DMACmd(TIM_TypeDef* TIMx, uint16_t TIM_DMASource, FunctionalState NewState)
+{
+    if (NewState != DISABLE) TIMx->DIER |= TIM_DMASource;
+    else                     TIMx->DIER &= (uint16_t)~TIM_DMASource;
+}
+
+void TIM_SelectOutputTrigger(TIM_TypeDef* TIMx, uint16_t TIM_TRGOSource)
+{
+    TIMx->CR2 &= (uint16_t)~0x0070u;
+    TIMx->CR2 |= TIM_TRGOSource;
+}
+
+void TIM_SelectMasterSlaveMode(TIM_TypeDef* TIMx, uint16_t TIM_MasterSlaveMode)
+{
+    TIMx->SMCR &= (uint16_t)~0x0080u;
+    TIMx->SMCR |= TIM_MasterSlaveMode;
+}
+
+void TIM_SelectSlaveMode(TIM_TypeDef* TIMx, uint16_t TIM_SlaveMode)
+{
+    TIMx->SMCR &= (uint16_t)~0x0007u;
+    TIMx->SMCR |= TIM_SlaveMode;
+}
+
+void TIM_SelectInputTrigger(TIM_TypeDef* TIMx, uint16_t TIM_InputTriggerSource)
+{
+    uint16_t tmpsmcr = TIMx->SMCR;
+
+    tmpsmcr &= (uint16_t)~0x0070u;
+    tmpsmcr |= TIM_InputTriggerSource;
+    TIMx->SMCR = tmpsmcr;
+}
+
+/*==================================== misc ===================================*/
+
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct)
+{
+    uint8_t ch = NVIC_InitStruct->NVIC_IRQChannel;
+
+    if (NVIC_InitStruct->NVIC_IRQChannelCmd != DISABLE)
+    {
+        // NVIC_PriorityGroup_4: 4 bit preemption, không có subpriority
+        NVIC->IP[ch] = (uint8_t)((NVIC_InitStruct->NVIC_IRQChannelPreemptionPriority << 4) & 0xF0u);
+        NVIC->ISER[ch >> 5] = 1uL << (ch & 0x1Fu);
+    }
+    else
+    {
+        NVIC->ICER[ch >> 5] = 1uL << (ch & 0x1Fu);
+    }
+}
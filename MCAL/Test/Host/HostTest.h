@@ -0,0 +1,38 @@
+/***************************************************************************
+ * @file    HostTest.h
+ * @brief   Macro kiểm tra tối giản cho các test host của MCAL
+ * @details Mỗi test là một chương trình riêng, trả về số lần kiểm tra sai
+ *          (0 = đạt). Lỗi in ra theo dạng file:dòng để dễ nhảy tới.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int HostTest_Failures = 0;
+
+#define HOST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #cond); \
+            HostTest_Failures++; \
+        } \
+    } while (0)
+
+#define HOST_CHECK_EQ(actual, expected) \
+    do { \
+        unsigned long host_a_ = (unsigned long)(actual); \
+        unsigned long host_e_ = (unsigned long)(expected); \
+        if (host_a_ != host_e_) { \
+            printf("%s:%d: FAIL: %s = %lu (0x%lx), expected %lu (0x%lx)\n", __FILE__, __LINE__, \
+                   #actual, host_a_, host_a_, host_e_, host_e_); \
+            HostTest_Failures++; \
+        } \
+    } while (0)
+
+#define HOST_TEST_RESULT(name) \
+    (printf("%s: %s\n", (name), (HostTest_Failures == 0) ? "PASS" : "FAIL"), HostTest_Failures)
+
+#endif /* HOST_TEST_H */
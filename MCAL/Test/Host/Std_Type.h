@@ -0,0 +1,45 @@
+/***************************************************************************
+ * @file    Std_Type.h (host)
+ * @brief   Kiểu dữ liệu chuẩn AUTOSAR cho bản build host của driver MCAL
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef STD_TYPE_H
+#define STD_TYPE_H
+
+#include <stdint.h>
+
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef int8_t   sint8;
+typedef int16_t  sint16;
+typedef int32_t  sint32;
+typedef uint8    boolean;
+
+typedef uint8 Std_ReturnType;
+#define E_OK        0u
+#define E_NOT_OK    1u
+
+#define STD_ON      1u
+#define STD_OFF     0u
+
+#ifndef TRUE
+#define TRUE        1u
+#endif
+#ifndef FALSE
+#define FALSE       0u
+#endif
+
+#define NULL_PTR    ((void *)0)
+
+typedef struct
+{
+    uint16 vendorID;
+    uint16 moduleID;
+    uint8  sw_major_version;
+    uint8  sw_minor_version;
+    uint8  sw_patch_version;
+} Std_VersionInfoType;
+
+#endif /* STD_TYPE_H */
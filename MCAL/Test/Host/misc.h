@@ -0,0 +1,22 @@
+/***************************************************************************
+ * @file    misc.h (host)
+ * @brief   NVIC_Init của SPL cho bản build host
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef MISC_H
+#define MISC_H
+
+#include "stm32f10x.h"
+
+typedef struct
+{
+    uint8_t NVIC_IRQChannel;
+    uint8_t NVIC_IRQChannelPreemptionPriority;
+    uint8_t NVIC_IRQChannelSubPriority;
+    FunctionalState NVIC_IRQChannelCmd;
+} NVIC_InitTypeDef;
+
+void NVIC_Init(NVIC_InitTypeDef* NVIC_InitStruct);
+
+#endif /* MISC_H */
@@ -0,0 +1,7 @@
+/***************************************************************************
+ * @file    std_type.h (host)
+ * @brief   Tên viết thường mà Pwm.h include, trỏ về Std_Type.h
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Std_Type.h"
@@ -0,0 +1,222 @@
+/***************************************************************************
+ * @file    stm32f10x.h (host)
+ * @brief   Bản thay thế stm32f10x.h/core_cm3.h để build driver MCAL trên PC
+ * @details Chỉ khai báo phần driver dùng tới. Địa chỉ ngoại vi giữ đúng như
+ *          STM32F103 (RM0008); HostReg_Init() ánh xạ bộ nhớ tại các địa chỉ
+ *          này và ghi lại mọi truy cập. PRIMASK được mô phỏng bằng biến
+ *          HostReg_Primask để test kiểm tra được critical section.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef STM32F10X_H
+#define STM32F10X_H
+
+#include <stdint.h>
+
+#define __IO volatile
+
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+
+typedef enum
+{
+    EXTI0_IRQn          = 6,
+    EXTI1_IRQn          = 7,
+    EXTI2_IRQn          = 8,
+    EXTI3_IRQn          = 9,
+    EXTI4_IRQn          = 10,
+    DMA1_Channel1_IRQn  = 11,
+    DMA1_Channel2_IRQn  = 12,
+    DMA1_Channel3_IRQn  = 13,
+    DMA1_Channel4_IRQn  = 14,
+    DMA1_Channel5_IRQn  = 15,
+    DMA1_Channel6_IRQn  = 16,
+    DMA1_Channel7_IRQn  = 17,
+    EXTI9_5_IRQn        = 23,
+    TIM1_BRK_IRQn       = 24,
+    TIM1_UP_IRQn        = 25,
+    TIM1_TRG_COM_IRQn   = 26,
+    TIM1_CC_IRQn        = 27,
+    TIM2_IRQn           = 28,
+    TIM3_IRQn           = 29,
+    TIM4_IRQn           = 30,
+    EXTI15_10_IRQn      = 40
+} IRQn_Type;
+
+typedef struct { __IO uint32_t CRL, CRH, IDR, ODR, BSRR, BRR, LCKR; } GPIO_TypeDef;
+typedef struct { __IO uint32_t EVCR, MAPR, EXTICR[4]; } AFIO_TypeDef;
+typedef struct { __IO uint32_t IMR, EMR, RTSR, FTSR, SWIER, PR; } EXTI_TypeDef;
+typedef struct { __IO uint32_t CR, CFGR, CIR, APB2RSTR, APB1RSTR, AHBENR, APB2ENR, APB1ENR, BDCR, CSR; } RCC_TypeDef;
+typedef struct { __IO uint32_t CCR, CNDTR, CPAR, CMAR; } DMA_Channel_TypeDef;
+typedef struct { __IO uint32_t ISR, IFCR; } DMA_TypeDef;
+
+typedef struct
+{
+    __IO uint16_t CR1;   uint16_t RESERVED0;
+    __IO uint16_t CR2;   uint16_t RESERVED1;
+    __IO uint16_t SMCR;  uint16_t RESERVED2;
+    __IO uint16_t DIER;  uint16_t RESERVED3;
+    __IO uint16_t SR;    uint16_t RESERVED4;
+    __IO uint16_t EGR;   uint16_t RESERVED5;
+    __IO uint16_t CCMR1; uint16_t RESERVED6;
+    __IO uint16_t CCMR2; uint16_t RESERVED7;
+    __IO uint16_t CCER;  uint16_t RESERVED8;
+    __IO uint16_t CNT;   uint16_t RESERVED9;
+    __IO uint16_t PSC;   uint16_t RESERVED10;
+    __IO uint16_t ARR;   uint16_t RESERVED11;
+    __IO uint16_t RCR;   uint16_t RESERVED12;
+    __IO uint16_t CCR1;  uint16_t RESERVED13;
+    __IO uint16_t CCR2;  uint16_t RESERVED14;
+    __IO uint16_t CCR3;  uint16_t RESERVED15;
+    __IO uint16_t CCR4;  uint16_t RESERVED16;
+    __IO uint16_t BDTR;  uint16_t RESERVED17;
+    __IO uint16_t DCR;   uint16_t RESERVED18;
+    __IO uint16_t DMAR;  uint16_t RESERVED19;
+} TIM_TypeDef;
+
+typedef struct
+{
+    __IO uint32_t ISER[8]; uint32_t RESERVED0[24];
+    __IO uint32_t ICER[8]; uint32_t RESERVED1[24];
+    __IO uint32_t ISPR[8]; uint32_t RESERVED2[24];
+    __IO uint32_t ICPR[8]; uint32_t RESERVED3[24];
+    __IO uint32_t IABR[8]; uint32_t RESERVED4[56];
+    __IO uint8_t  IP[240];
+} NVIC_Type;
+
+/* Địa chỉ 64 bit (UL) để phép ép sang con trỏ không cảnh báo trên host LP64 */
+#define PERIPH_BASE         0x40000000UL
+#define PERIPH_BB_BASE      0x42000000UL
+#define APB1PERIPH_BASE     PERIPH_BASE
+#define APB2PERIPH_BASE     (PERIPH_BASE + 0x10000UL)
+#define AHBPERIPH_BASE      (PERIPH_BASE + 0x20000UL)
+
+#define TIM2_BASE           (APB1PERIPH_BASE + 0x0000UL)
+#define TIM3_BASE           (APB1PERIPH_BASE + 0x0400UL)
+#define TIM4_BASE           (APB1PERIPH_BASE + 0x0800UL)
+#define AFIO_BASE           (APB2PERIPH_BASE + 0x0000UL)
+#define EXTI_BASE           (APB2PERIPH_BASE + 0x0400UL)
+#define GPIOA_BASE          (APB2PERIPH_BASE + 0x0800UL)
+#define GPIOB_BASE          (APB2PERIPH_BASE + 0x0C00UL)
+#define GPIOC_BASE          (APB2PERIPH_BASE + 0x1000UL)
+#define GPIOD_BASE          (APB2PERIPH_BASE + 0x1400UL)
+#define TIM1_BASE           (APB2PERIPH_BASE + 0x2C00UL)
+#define DMA1_BASE           (AHBPERIPH_BASE + 0x0000UL)
+#define DMA1_Channel1_BASE  (AHBPERIPH_BASE + 0x0008UL)
+#define DMA1_Channel2_BASE  (AHBPERIPH_BASE + 0x001CUL)
+#define DMA1_Channel3_BASE  (AHBPERIPH_BASE + 0x0030UL)
+#define DMA1_Channel4_BASE  (AHBPERIPH_BASE + 0x0044UL)
+#define DMA1_Channel5_BASE  (AHBPERIPH_BASE + 0x0058UL)
+#define DMA1_Channel6_BASE  (AHBPERIPH_BASE + 0x006CUL)
+#define DMA1_Channel7_BASE  (AHBPERIPH_BASE + 0x0080UL)
+#define RCC_BASE            (AHBPERIPH_BASE + 0x1000UL)
+#define NVIC_BASE           0xE000E100UL
+
+#define TIM2                ((TIM_TypeDef *) TIM2_BASE)
+#define TIM3                ((TIM_TypeDef *) TIM3_BASE)
+#define TIM4                ((TIM_TypeDef *) TIM4_BASE)
+#define TIM1                ((TIM_TypeDef *) TIM1_BASE)
+#define AFIO                ((AFIO_TypeDef *) AFIO_BASE)
+#define EXTI                ((EXTI_TypeDef *) EXTI_BASE)
+#define GPIOA               ((GPIO_TypeDef *) GPIOA_BASE)
+#define GPIOB               ((GPIO_TypeDef *) GPIOB_BASE)
+#define GPIOC               ((GPIO_TypeDef *) GPIOC_BASE)
+#define GPIOD               ((GPIO_TypeDef *) GPIOD_BASE)
+#define DMA1                ((DMA_TypeDef *) DMA1_BASE)
+#define DMA1_Channel1       ((DMA_Channel_TypeDef *) DMA1_Channel1_BASE)
+#define DMA1_Channel2       ((DMA_Channel_TypeDef *) DMA1_Channel2_BASE)
+#define DMA1_Channel3       ((DMA_Channel_TypeDef *) DMA1_Channel3_BASE)
+#define DMA1_Channel4       ((DMA_Channel_TypeDef *) DMA1_Channel4_BASE)
+#define DMA1_Channel5       ((DMA_Channel_TypeDef *) DMA1_Channel5_BASE)
+#define DMA1_Channel6       ((DMA_Channel_TypeDef *) DMA1_Channel6_BASE)
+#define DMA1_Channel7       ((DMA_Channel_TypeDef *) DMA1_Channel7_BASE)
+#define RCC                 ((RCC_TypeDef *) RCC_BASE)
+#define NVIC                ((NVIC_Type *) NVIC_BASE)
+
+/// @name Bit thanh ghi dùng trực tiếp trong driver (RM0008)
+/// @{
+#define TIM_CR1_CEN         0x0001
+#define TIM_CR1_UDIS        0x0002
+#define TIM_CR1_DIR         0x0010
+#define TIM_CR1_CMS_0       0x0020
+#define TIM_CR1_CMS_1       0x0040
+#define TIM_CR1_CMS         0x0060
+#define TIM_CR1_ARPE        0x0080
+#define TIM_CR2_MMS         0x0070
+#define TIM_SMCR_SMS        0x0007
+#define TIM_SMCR_TS         0x0070
+#define TIM_SMCR_MSM        0x0080
+#define TIM_EGR_UG          0x0001
+#define TIM_SR_UIF          0x0001
+#define TIM_SR_CC1IF        0x0002
+#define TIM_SR_BIF          0x0080
+#define TIM_DIER_UIE        0x0001
+#define TIM_DIER_UDE        0x0100
+#define TIM_CCER_CC1E       0x0001
+#define TIM_CCER_CC1P       0x0002
+#define TIM_CCER_CC1NE      0x0004
+#define TIM_CCER_CC1NP      0x0008
+#define TIM_CCER_CC2E       0x0010
+#define TIM_CCER_CC3E       0x0100
+#define TIM_CCER_CC4E       0x1000
+#define TIM_BDTR_DTG        0x00FF
+#define TIM_BDTR_LOCK       0x0300
+#define TIM_BDTR_OSSI       0x0400
+#define TIM_BDTR_OSSR       0x0800
+#define TIM_BDTR_BKE        0x1000
+#define TIM_BDTR_BKP        0x2000
+#define TIM_BDTR_AOE        0x4000
+#define TIM_BDTR_MOE        0x8000
+#define DMA_CCR1_EN         0x0001
+#define DMA_CCR1_TCIE       0x0002
+#define DMA_CCR1_HTIE       0x0004
+#define DMA_CCR1_TEIE       0x0008
+#define DMA_CCR1_DIR        0x0010
+#define DMA_CCR1_CIRC       0x0020
+#define DMA_CCR1_PINC       0x0040
+#define DMA_CCR1_MINC       0x0080
+#define DMA_CCR1_PSIZE_0    0x0100
+#define DMA_CCR1_PSIZE_1    0x0200
+#define DMA_CCR1_MSIZE_0    0x0400
+#define DMA_CCR1_MSIZE_1    0x0800
+#define DMA_CCR1_PL         0x3000
+#define DMA_CCR1_PL_0       0x1000
+#define DMA_CCR1_PL_1       0x2000
+#define RCC_APB2ENR_IOPAEN  0x0004
+/// @}
+
+/// @name Lõi Cortex-M3 (core_cm3.h) mô phỏng trên host
+/// @{
+extern volatile uint32_t HostReg_Primask;
+
+static inline void __disable_irq(void) { HostReg_Primask = 1u; }
+static inline void __enable_irq(void) { HostReg_Primask = 0u; }
+static inline uint32_t __get_PRIMASK(void) { return HostReg_Primask; }
+static inline void __set_PRIMASK(uint32_t priMask) { HostReg_Primask = priMask & 1u; }
+static inline uint32_t __CLZ(uint32_t value) { return (value == 0u) ? 32u : (uint32_t)__builtin_clz(value); }
+
+static inline void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    NVIC->ISER[(uint32_t)IRQn >> 5] = 1uL << ((uint32_t)IRQn & 0x1Fu);
+}
+
+static inline void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    NVIC->ICER[(uint32_t)IRQn >> 5] = 1uL << ((uint32_t)IRQn & 0x1Fu);
+}
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+    NVIC->IP[(uint32_t)IRQn] = (uint8_t)((priority << 4) & 0xFFu);
+}
+/// @}
+
+extern uint32_t SystemCoreClock;
+
+#include "stm32f10x_gpio.h"
+#include "stm32f10x_rcc.h"
+#include "stm32f10x_tim.h"
+#include "stm32f10x_dma.h"
+#include "misc.h"
+
+#endif /* STM32F10X_H */
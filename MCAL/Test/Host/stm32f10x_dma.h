@@ -0,0 +1,12 @@
+/***************************************************************************
+ * @file    stm32f10x_dma.h (host)
+ * @brief   Driver DMA ghi thanh ghi trực tiếp, header chỉ để giữ include
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef STM32F10X_DMA_H
+#define STM32F10X_DMA_H
+
+#include "stm32f10x.h"
+
+#endif /* STM32F10X_DMA_H */
@@ -0,0 +1,54 @@
+/***************************************************************************
+ * @file    stm32f10x_gpio.h (host)
+ * @brief   Phần API GPIO của SPL mà driver MCAL dùng
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef STM32F10X_GPIO_H
+#define STM32F10X_GPIO_H
+
+#include "stm32f10x.h"
+
+typedef enum
+{
+    GPIO_Speed_10MHz = 1,
+    GPIO_Speed_2MHz,
+    GPIO_Speed_50MHz
+} GPIOSpeed_TypeDef;
+
+typedef enum
+{
+    GPIO_Mode_AIN         = 0x00,
+    GPIO_Mode_IN_FLOATING = 0x04,
+    GPIO_Mode_IPD         = 0x28,
+    GPIO_Mode_IPU         = 0x48,
+    GPIO_Mode_Out_OD      = 0x14,
+    GPIO_Mode_Out_PP      = 0x10,
+    GPIO_Mode_AF_OD       = 0x1C,
+    GPIO_Mode_AF_PP       = 0x18
+} GPIOMode_TypeDef;
+
+typedef struct
+{
+    uint16_t GPIO_Pin;
+    GPIOSpeed_TypeDef GPIO_Speed;
+    GPIOMode_TypeDef GPIO_Mode;
+} GPIO_InitTypeDef;
+
+typedef enum { Bit_RESET = 0, Bit_SET } BitAction;
+
+#define GPIO_Pin_0      ((uint16_t)0x0001)
+#define GPIO_Pin_8      ((uint16_t)0x0100)
+#define GPIO_Pin_13     ((uint16_t)0x2000)
+#define GPIO_Pin_All    ((uint16_t)0xFFFF)
+
+void GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_InitStruct);
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+uint16_t GPIO_ReadInputData(GPIO_TypeDef* GPIOx);
+uint16_t GPIO_ReadOutputData(GPIO_TypeDef* GPIOx);
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void GPIO_WriteBit(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, BitAction BitVal);
+void GPIO_Write(GPIO_TypeDef* GPIOx, uint16_t PortVal);
+
+#endif /* STM32F10X_GPIO_H */
@@ -0,0 +1,43 @@
+/***************************************************************************
+ * @file    stm32f10x_rcc.h (host)
+ * @brief   Phần API RCC của SPL mà driver MCAL dùng
+ * @details RCC_GetClocksFreq trên host trả về cấu hình 72 MHz của board
+ *          (HCLK 72 MHz, PCLK1 36 MHz, PCLK2 72 MHz) lấy từ HostSpl_Clocks;
+ *          test đổi được biến này để thử clock khác.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef STM32F10X_RCC_H
+#define STM32F10X_RCC_H
+
+#include "stm32f10x.h"
+
+#define RCC_APB2Periph_AFIO     0x00000001u
+#define RCC_APB2Periph_GPIOA    0x00000004u
+#define RCC_APB2Periph_GPIOB    0x00000008u
+#define RCC_APB2Periph_GPIOC    0x00000010u
+#define RCC_APB2Periph_GPIOD    0x00000020u
+#define RCC_APB2Periph_ADC1     0x00000200u
+#define RCC_APB2Periph_TIM1     0x00000800u
+#define RCC_APB1Periph_TIM2     0x00000001u
+#define RCC_APB1Periph_TIM3     0x00000002u
+#define RCC_APB1Periph_TIM4     0x00000004u
+#define RCC_AHBPeriph_DMA1      0x00000001u
+
+typedef struct
+{
+    uint32_t SYSCLK_Frequency;
+    uint32_t HCLK_Frequency;
+    uint32_t PCLK1_Frequency;
+    uint32_t PCLK2_Frequency;
+    uint32_t ADCCLK_Frequency;
+} RCC_ClocksTypeDef;
+
+extern RCC_ClocksTypeDef HostSpl_Clocks;
+
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState);
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState);
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState);
+void RCC_GetClocksFreq(RCC_ClocksTypeDef* RCC_Clocks);
+
+#endif /* STM32F10X_RCC_H */
@@ -0,0 +1,105 @@
+/***************************************************************************
+ * @file    stm32f10x_tim.h (host)
+ * @brief   Phần API TIM của SPL mà driver MCAL dùng (giá trị như SPL 3.5)
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef STM32F10X_TIM_H
+#define STM32F10X_TIM_H
+
+#include "stm32f10x.h"
+
+typedef struct
+{
+    uint16_t TIM_Prescaler;
+    uint16_t TIM_CounterMode;
+    uint16_t TIM_Period;
+    uint16_t TIM_ClockDivision;
+    uint8_t  TIM_RepetitionCounter;
+} TIM_TimeBaseInitTypeDef;
+
+typedef struct
+{
+    uint16_t TIM_OCMode;
+    uint16_t TIM_OutputState;
+    uint16_t TIM_OutputNState;
+    uint16_t TIM_Pulse;
+    uint16_t TIM_OCPolarity;
+    uint16_t TIM_OCNPolarity;
+    uint16_t TIM_OCIdleState;
+    uint16_t TIM_OCNIdleState;
+} TIM_OCInitTypeDef;
+
+#define TIM_CKD_DIV1                    0x0000
+#define TIM_CounterMode_Up              0x0000
+#define TIM_CounterMode_Down            0x0010
+#define TIM_CounterMode_CenterAligned1  0x0020
+#define TIM_CounterMode_CenterAligned2  0x0040
+#define TIM_CounterMode_CenterAligned3  0x0060
+#define TIM_OCMode_Timing               0x0000
+#define TIM_OCMode_PWM1                 0x0060
+#define TIM_OCMode_PWM2                 0x0070
+#define TIM_OutputState_Disable         0x0000
+#define TIM_OutputState_Enable          0x0001
+#define TIM_OutputNState_Disable        0x0000
+#define TIM_OutputNState_Enable         0x0004
+#define TIM_OCPolarity_High             0x0000
+#define TIM_OCPolarity_Low              0x0002
+#define TIM_OCNPolarity_High            0x0000
+#define TIM_OCNPolarity_Low             0x0008
+#define TIM_OCIdleState_Set             0x0100
+#define TIM_OCIdleState_Reset           0x0000
+#define TIM_OCNIdleState_Set            0x0200
+#define TIM_OCNIdleState_Reset          0x0000
+#define TIM_OCPreload_Enable            0x0008
+#define TIM_OCPreload_Disable           0x0000
+#define TIM_ForcedAction_Active         0x0050
+#define TIM_ForcedAction_InActive       0x0040
+#define TIM_IT_Update                   0x0001
+#define TIM_IT_CC1                      0x0002
+#define TIM_IT_CC2                      0x0004
+#define TIM_IT_CC3                      0x0008
+#define TIM_IT_CC4                      0x0010
+#define TIM_IT_Break                    0x0080
+#define TIM_FLAG_Break                  0x0080
+#define TIM_DMA_Update                  0x0100
+#define TIM_TRGOSource_Reset            0x0000
+#define TIM_TRGOSource_Enable           0x0010
+#define TIM_TRGOSource_Update           0x0020
+#define TIM_MasterSlaveMode_Enable      0x0080
+#define TIM_MasterSlaveMode_Disable     0x0000
+#define TIM_SlaveMode_Reset             0x0004
+#define TIM_SlaveMode_Gated             0x0005
+#define TIM_SlaveMode_Trigger           0x0006
+#define TIM_TS_ITR0                     0x0000
+#define TIM_TS_ITR1                     0x0010
+#define TIM_TS_ITR2                     0x0020
+#define TIM_TS_ITR3                     0x0030
+#define TIM_LOCKLevel_OFF               0x0000
+#define TIM_LOCKLevel_1                 0x0100
+#define TIM_LOCKLevel_2                 0x0200
+#define TIM_LOCKLevel_3                 0x0300
+#define TIM_BreakPolarity_Low           0x0000
+#define TIM_BreakPolarity_High          0x2000
+
+void TIM_TimeBaseInit(TIM_TypeDef* TIMx, TIM_TimeBaseInitTypeDef* TIM_TimeBaseInitStruct);
+void TIM_OC1Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct);
+void TIM_OC2Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct);
+void TIM_OC3Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct);
+void TIM_OC4Init(TIM_TypeDef* TIMx, TIM_OCInitTypeDef* TIM_OCInitStruct);
+void TIM_OCStructInit(TIM_OCInitTypeDef* TIM_OCInitStruct);
+void TIM_OC1PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload);
+void TIM_OC2PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload);
+void TIM_OC3PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload);
+void TIM_OC4PreloadConfig(TIM_TypeDef* TIMx, uint16_t TIM_OCPreload);
+void TIM_ARRPreloadConfig(TIM_TypeDef* TIMx, FunctionalState NewState);
+void TIM_Cmd(TIM_TypeDef* TIMx, FunctionalState NewState);
+void TIM_CtrlPWMOutputs(TIM_TypeDef* TIMx, FunctionalState NewState);
+void TIM_ITConfig(TIM_TypeDef* TIMx, uint16_t TIM_IT, FunctionalState NewState);
+void TIM_DMACmd(TIM_TypeDef* TIMx, uint16_t TIM_DMASource, FunctionalState NewState);
+void TIM_SelectOutputTrigger(TIM_TypeDef* TIMx, uint16_t TIM_TRGOSource);
+void TIM_SelectMasterSlaveMode(TIM_TypeDef* TIMx, uint16_t TIM_MasterSlaveMode);
+void TIM_SelectSlaveMode(TIM_TypeDef* TIMx, uint16_t TIM_SlaveMode);
+void TIM_SelectInputTrigger(TIM_TypeDef* TIMx, uint16_t TIM_InputTriggerSource);
+
+#endif /* STM32F10X_TIM_H */
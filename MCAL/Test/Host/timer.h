@@ -0,0 +1,15 @@
+/***************************************************************************
+ * @file    timer.h (host)
+ * @brief   Hàm delay của thư mục Timer, trên host không làm gì
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+void Delay_Init(void);
+void Delay_ms(uint32_t ms);
+
+#endif /* TIMER_H */
@@ -0,0 +1,101 @@
+/***************************************************************************
+ * @file    Test_ConfigSize.c
+ * @brief   Kích thước các bảng cấu hình Port/PWM trong ROM
+ * @details Kiểm tra lại các kiểm tra lúc biên dịch trong Port_Cfg.c và
+ *          Pwm_cfg.c, kích thước bảng theo số phần tử thật, và so với layout
+ *          gốc (chép lại dưới đây thành typedef cục bộ, bảng cố định 64 chân
+ *          và 12 kênh). Con số in ra là của Cortex-M3 (ILP32: con trỏ 4
+ *          byte): layout PWM cũ là 2 con trỏ + 24 byte, mới là 3 con trỏ + 16
+ *          byte, nên cùng một biểu thức đúng cho cả máy chạy test (LP64) và
+ *          target. Port không có con trỏ nên kích thước như nhau ở cả hai.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Port_Cfg.h"
+#include "Pwm_cfg.h"
+#include "HostTest.h"
+
+#define TARGET_POINTER_SIZE     4u
+
+/* Layout gốc trước khi gộp bitfield (Port.h, Pwm.h bản đầu tiên) */
+#define OLD_PINCOUNT            64u
+#define OLD_PINPWM              12u
+
+typedef struct
+{
+    uint8 PortID;
+    uint16 PinID;
+    Port_PinModeType PinMode;
+    Port_PinDirectionType Direction;
+    uint8 Speed;
+    uint8 Pull;
+    uint8 Level;
+    uint8 DirectionChangeable;
+    uint8 ModeChangeable;
+} Old_Port_PinConfigType;
+
+typedef struct {
+    TIM_TypeDef*              TIMx;
+    uint8                     channel;
+    Pwm_ChannelClassType      classType;
+    uint16                    defaultPeriod;
+    uint16                    defaultDutyCycle;
+    Pwm_OutputStateType       polarity;
+    Pwm_OutputStateType       idleState;
+    uint16                    CompareVal;
+    uint8                     notificationEnable;
+    void (*NotificationCb)(void);
+} Old_Pwm_ChannelConfigType;
+
+static void Test_PortSize(void)
+{
+    uint32 oldTable = OLD_PINCOUNT * sizeof(Old_Port_PinConfigType);
+
+    HOST_CHECK_EQ(sizeof(Port_PinConfigType), 4u);
+    HOST_CHECK_EQ(sizeof(Old_Port_PinConfigType), 20u);
+    HOST_CHECK(Pincount * sizeof(Port_PinConfigType) < oldTable);
+
+    printf("Port_PinConfigType: old %u B -> new %u B; pin table: old %u x %u B = %u B -> new %u x %u B = %u B\n",
+           (unsigned)sizeof(Old_Port_PinConfigType), (unsigned)sizeof(Port_PinConfigType),
+           (unsigned)OLD_PINCOUNT, (unsigned)sizeof(Old_Port_PinConfigType), (unsigned)oldTable,
+           (unsigned)Pincount, (unsigned)sizeof(Port_PinConfigType),
+           (unsigned)(Pincount * sizeof(Port_PinConfigType)));
+
+    for (uint32 i = 0; i < PORT_NUM_CONFIG_SETS; i++)
+    {
+        const Port_ConfigType *set = &Port_ConfigSets[i];
+
+        HOST_CHECK(set->PortCfg_PinsCount > 0u && set->PortCfg_PinsCount <= Pincount);
+        printf("Port config set %u: %u pins, %u B pin table\n", (unsigned)i,
+               (unsigned)set->PortCfg_PinsCount,
+               (unsigned)(set->PortCfg_PinsCount * sizeof(Port_PinConfigType)));
+    }
+}
+
+static void Test_PwmSize(void)
+{
+    uint32 target = (3u * TARGET_POINTER_SIZE) + 16u;
+    uint32 oldTarget = (2u * TARGET_POINTER_SIZE) + 24u;
+
+    HOST_CHECK_EQ(sizeof(Pwm_ChannelConfigType), (3u * sizeof(void*)) + 16u);
+    HOST_CHECK_EQ(sizeof(Old_Pwm_ChannelConfigType), (2u * sizeof(void*)) + 24u);
+    HOST_CHECK_EQ(sizeof(pwmChannelscfg), PinPWM * sizeof(Pwm_ChannelConfigType));
+    HOST_CHECK_EQ(target, 28u);
+    HOST_CHECK_EQ(oldTarget, 32u);
+    // Thêm CcrAddr, defaultFrequencyHz và phase mà kênh vẫn nhỏ hơn layout gốc
+    HOST_CHECK(target < oldTarget);
+    HOST_CHECK(PinPWM * target < OLD_PINPWM * oldTarget);
+
+    printf("Pwm_ChannelConfigType on Cortex-M3: old %u B -> new %u B (%u B here); "
+           "pwmChannelscfg: old %u x %u B = %u B -> new %u x %u B = %u B\n",
+           (unsigned)oldTarget, (unsigned)target, (unsigned)sizeof(Pwm_ChannelConfigType),
+           (unsigned)OLD_PINPWM, (unsigned)oldTarget, (unsigned)(OLD_PINPWM * oldTarget),
+           (unsigned)PinPWM, (unsigned)target, (unsigned)(PinPWM * target));
+}
+
+int main(void)
+{
+    Test_PortSize();
+    Test_PwmSize();
+    return HOST_TEST_RESULT("Test_ConfigSize");
+}
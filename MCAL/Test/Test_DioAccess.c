@@ -0,0 +1,186 @@
+/***************************************************************************
+ * @file    Test_DioAccess.c
+ * @brief   Đếm số truy cập thanh ghi GPIO của từng API DIO
+ * @details Mỗi API ghi phải là đúng một lệnh store vào BSRR/BRR, không đọc
+ *          ODR. Test cũng chạy lại cách ghi cũ (GPIO_ReadOutputData -> mask
+ *          -> GPIO_Write) với một "ISR" chạy ngay sau truy cập GPIOA đầu tiên:
+ *          ở cách cũ là giữa lệnh đọc và lệnh ghi ODR nên lệnh ghi của ISR bị
+ *          mất; ở đường BSRR là sau lệnh store duy nhất, không có lệnh ghi nào
+ *          của driver theo sau để ghi đè nó.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Dio.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define GPIO_SPAN       ((uint32)sizeof(GPIO_TypeDef))
+
+/* Chân do "ISR" ghi (PA0) và nhóm do vòng lặp chính ghi (PA4..PA7) */
+#define ISR_PIN_MASK    0x0001u
+
+static const Dio_ChannelGroupType Test_Group = { .mask = 0xF0u, .offset = 4u, .port = GPIO_PORT_A };
+
+static uint32 Test_Reads(GPIO_TypeDef *port)  { return HostReg_Count(HOST_ADDR(*port), GPIO_SPAN, 0u); }
+static uint32 Test_Writes(GPIO_TypeDef *port) { return HostReg_Count(HOST_ADDR(*port), GPIO_SPAN, 1u); }
+static uint16 Test_Odr(GPIO_TypeDef *port)    { return (uint16)HostReg_Peek(HOST_ADDR(port->ODR)); }
+
+/* "ISR" chạy ngay sau truy cập GPIOA đầu tiên của driver: set PA0 */
+static uint8 Test_IsrArmed = 0u;
+static void Test_IsrAfterFirstAccess(uint32 addr, uint8 write, uint32 old, uint32 value)
+{
+    (void)write;
+    (void)old;
+    (void)value;
+    if (Test_IsrArmed && addr >= HOST_ADDR(*GPIOA) && addr < HOST_ADDR(*GPIOA) + GPIO_SPAN)
+    {
+        Test_IsrArmed = 0u;
+        HostReg_Poke(HOST_ADDR(GPIOA->ODR), HostReg_Peek(HOST_ADDR(GPIOA->ODR)) | ISR_PIN_MASK);
+    }
+}
+
+/* Cách ghi nhóm trước khi chuyển sang BSRR (giữ lại để so sánh) */
+static void Test_LegacyWriteChannelGroup(const Dio_ChannelGroupType *grp, Dio_PortLevelType Level)
+{
+    GPIO_TypeDef *port = DIO_GET_PORT_BASE(grp->port);
+    uint16 odr = GPIO_ReadOutputData(port);
+
+    odr = (uint16)((odr & ~grp->mask) | (((uint32)Level << grp->offset) & grp->mask));
+    GPIO_Write(port, odr);
+}
+
+static void Test_Begin(void)
+{
+    HostReg_ClearLog();
+}
+
+static void Test_WriteApis(void)
+{
+    // Dio_WriteChannel: một store vào BSRR (HIGH) hoặc BRR (LOW)
+    Test_Begin();
+    Dio_WriteChannel(5, STD_HIGH);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+    HOST_CHECK_EQ(Test_Writes(GPIOA), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(GPIOA->BSRR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(Test_Odr(GPIOA) & 0x20u, 0x20u);
+
+    Test_Begin();
+    Dio_WriteChannel(5, STD_LOW);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(GPIOA->BRR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(Test_Odr(GPIOA) & 0x20u, 0u);
+
+    // Dio_FlipChannel: một load ODR + một store BSRR/BRR
+    Test_Begin();
+    HOST_CHECK_EQ(Dio_FlipChannel(21), STD_HIGH);
+    HOST_CHECK_EQ(Test_Reads(GPIOB), 1u);
+    HOST_CHECK_EQ(Test_Writes(GPIOB), 1u);
+    HOST_CHECK_EQ(HostReg_LogLength(), 2u);
+    HOST_CHECK_EQ(Test_Odr(GPIOB), 0x0020u);
+
+    // Dio_WritePort: cả 16 bit bằng một store BSRR
+    Test_Begin();
+    Dio_WritePort(GPIO_PORT_C, 0xA5A5u);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+    HOST_CHECK_EQ(Test_Writes(GPIOC), 1u);
+    HOST_CHECK_EQ(HostReg_LogAt(0)->value, 0x5A5AA5A5u);
+    HOST_CHECK_EQ(Test_Odr(GPIOC), 0xA5A5u);
+
+    // Dio_MaskedWritePort: bit ngoài mặt nạ giữ nguyên, không đọc ODR
+    Test_Begin();
+    Dio_MaskedWritePort(GPIO_PORT_C, 0x00FFu, 0x0F0Fu);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+    HOST_CHECK_EQ(Test_Reads(GPIOC), 0u);
+    HOST_CHECK_EQ(Test_Odr(GPIOC), 0xA0AFu);
+
+    // Dio_WriteChannelGroup: set/reset tính từ mask/offset
+    Test_Begin();
+    Dio_WriteChannelGroup(&Test_Group, 0x9u);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+    HOST_CHECK_EQ(HostReg_LogAt(0)->value, 0x00600090u);
+}
+
+static void Test_ReadApis(void)
+{
+    HostReg_Poke(HOST_ADDR(GPIOD->IDR), 0x8001u);
+    HostReg_Poke(HOST_ADDR(GPIOA->IDR), 0x00B0u);
+
+    Test_Begin();
+    HOST_CHECK_EQ(Dio_ReadChannel(63), STD_HIGH);
+    HOST_CHECK_EQ(Dio_ReadChannel(62), STD_LOW);
+    HOST_CHECK_EQ(Test_Reads(GPIOD), 2u);
+    HOST_CHECK_EQ(HostReg_LogLength(), 2u);
+
+    Test_Begin();
+    HOST_CHECK_EQ(Dio_ReadPort(GPIO_PORT_D), 0x8001u);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+
+    Test_Begin();
+    HOST_CHECK_EQ(Dio_ReadChannelGroup(&Test_Group), 0xBu);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+}
+
+static void Test_DeferredWrites(void)
+{
+    // Ở chế độ trễ các API ghi không chạm bus; Dio_Commit ghi một BSRR mỗi port có thay đổi
+    Dio_SetWriteMode(DIO_WRITE_DEFERRED);
+    Test_Begin();
+    Dio_WriteChannel(1, STD_HIGH);
+    Dio_WriteChannel(2, STD_HIGH);
+    Dio_WriteChannelGroup(&Test_Group, 0x3u);
+    Dio_WriteChannel(48, STD_HIGH);
+    HOST_CHECK_EQ(HostReg_LogLength(), 0u);
+
+    Dio_Commit();
+    HOST_CHECK_EQ(HostReg_LogLength(), 2u);
+    HOST_CHECK_EQ(Test_Writes(GPIOA), 1u);
+    HOST_CHECK_EQ(Test_Writes(GPIOD), 1u);
+    HOST_CHECK_EQ(Test_Writes(GPIOB) + Test_Writes(GPIOC), 0u);
+    Dio_SetWriteMode(DIO_WRITE_IMMEDIATE);
+}
+
+static void Test_IsrInterleave(void)
+{
+    uint32 legacy;
+    uint32 bsrr;
+
+    HostReg_SetHook(Test_IsrAfterFirstAccess);
+
+    // Cách cũ: ISR set PA0 giữa lần đọc và lần ghi ODR -> bị ghi đè
+    HostReg_Poke(HOST_ADDR(GPIOA->ODR), 0u);
+    Test_Begin();
+    Test_IsrArmed = 1u;
+    Test_LegacyWriteChannelGroup(&Test_Group, 0xFu);
+    legacy = HostReg_LogLength();
+    HOST_CHECK_EQ(Test_IsrArmed, 0u);
+    HOST_CHECK_EQ(Test_Odr(GPIOA) & ISR_PIN_MASK, 0u);
+
+    // Đường BSRR: ISR chạy sau lệnh store duy nhất, PA0 của ISR giữ nguyên
+    HostReg_Poke(HOST_ADDR(GPIOA->ODR), 0u);
+    Test_Begin();
+    Test_IsrArmed = 1u;
+    Dio_WriteChannelGroup(&Test_Group, 0xFu);
+    bsrr = HostReg_LogLength();
+    HOST_CHECK_EQ(Test_IsrArmed, 0u);
+    HOST_CHECK_EQ(Test_Odr(GPIOA), 0x00F1u);
+    HOST_CHECK_EQ(bsrr, 1u);
+
+    Test_IsrArmed = 0u;
+    HostReg_SetHook(NULL_PTR);
+    printf("Dio_WriteChannelGroup: %u bus access(es), read-modify-write version: %u\n",
+           (unsigned)bsrr, (unsigned)legacy);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    HostReg_Start();
+
+    Test_WriteApis();
+    Test_ReadApis();
+    Test_DeferredWrites();
+    Test_IsrInterleave();
+
+    HostReg_Stop();
+    return HOST_TEST_RESULT("Test_DioAccess");
+}
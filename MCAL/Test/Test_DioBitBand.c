@@ -0,0 +1,107 @@
+/***************************************************************************
+ * @file    Test_DioBitBand.c
+ * @brief   Kiểm tra địa chỉ alias bit-band của IDR/ODR cho cả 64 kênh DIO
+ * @details Build với DIO_BITBAND_ACCESS = STD_ON. Địa chỉ trong Dio_ChannelCfg
+ *          và DIO_CFG_IDR_BIT/DIO_CFG_ODR_BIT được so với bảng địa chỉ alias
+ *          bit 0 của từng port tính tay theo RM0008 mục 3.3.3 (không dùng lại
+ *          DIO_BITBAND_ALIAS), cùng vài địa chỉ quen thuộc (PC13 ODR =
+ *          0x422201B4). Sau đó chạy Dio_ReadChannel/WriteChannel/FlipChannel
+ *          trên mô hình thanh ghi: mỗi API chỉ chạm word alias, không chạm
+ *          vùng GPIO, và bit IDR/ODR tương ứng đổi đúng.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Dio.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#if (DIO_BITBAND_ACCESS != STD_ON)
+#error "Test_DioBitBand cần DIO_BITBAND_ACCESS = STD_ON (xem makefile)"
+#endif
+
+#define GPIO_SPAN       ((uint32)sizeof(GPIO_TypeDef))
+
+/* Alias của bit 0 IDR theo port: 0x42000000 + (GPIOx_IDR - 0x40000000) * 32 */
+static const uint32 Test_IdrBit0[DIO_NUM_PORTS] = {
+    0x42210100u,    // GPIOA_IDR 0x40010808
+    0x42218100u,    // GPIOB_IDR 0x40010C08
+    0x42220100u,    // GPIOC_IDR 0x40011008
+    0x42228100u     // GPIOD_IDR 0x40011408
+};
+
+/* ODR nằm sau IDR 4 byte -> alias cách 4 * 32 = 0x80 */
+#define TEST_ODR_FROM_IDR   0x80u
+
+static uint32 Test_Addr(volatile uint32 *p) { return (uint32)(uintptr_t)p; }
+
+static void Test_AliasTable(void)
+{
+    uint32 ch;
+
+    for (ch = 0; ch < DIO_NUM_CHANNELS; ch++)
+    {
+        uint32 idr = Test_IdrBit0[ch >> 4] + (ch & 15u) * 4u;
+
+        HOST_CHECK_EQ(Test_Addr(Dio_ChannelCfg[ch].idrBit), idr);
+        HOST_CHECK_EQ(Test_Addr(Dio_ChannelCfg[ch].odrBit), idr + TEST_ODR_FROM_IDR);
+    }
+
+    // Địa chỉ quen thuộc trong tài liệu/ví dụ STM32F103
+    HOST_CHECK_EQ(Test_Addr(Dio_ChannelCfg[0].idrBit), 0x42210100u);     // PA0 IDR
+    HOST_CHECK_EQ(Test_Addr(Dio_ChannelCfg[24].idrBit), 0x42218120u);    // PB8 IDR
+    HOST_CHECK_EQ(Test_Addr(Dio_ChannelCfg[45].odrBit), 0x422201B4u);    // PC13 ODR
+    HOST_CHECK_EQ(Test_Addr(Dio_ChannelCfg[63].odrBit), 0x422281BCu);    // PD15 ODR
+
+    // Macro lúc biên dịch (dùng bởi hàm truy cập inline) trùng với bảng
+    HOST_CHECK_EQ(Test_Addr(DIO_CFG_IDR_BIT(DIO_CHANEL_24)), Test_Addr(Dio_ChannelCfg[24].idrBit));
+    HOST_CHECK_EQ(Test_Addr(DIO_CFG_ODR_BIT(DIO_CHANEL_45)), Test_Addr(Dio_ChannelCfg[45].odrBit));
+}
+
+static void Test_AliasAccess(void)
+{
+    const uint32 pc13 = Test_Addr(Dio_ChannelCfg[45].odrBit);
+
+    // Dio_WriteChannel: một store vào word alias, ODR đổi đúng bit 13
+    HostReg_Poke(HOST_ADDR(GPIOC->ODR), 0x0001u);
+    HostReg_ClearLog();
+    Dio_WriteChannel(45, STD_HIGH);
+    HOST_CHECK_EQ(HostReg_LogLength(), 1u);
+    HOST_CHECK_EQ(HostReg_Count(pc13, 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOC), GPIO_SPAN, 2u), 0u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOC->ODR)), 0x2001u);
+
+    // Dio_FlipChannel: một load + một store vào cùng word alias
+    HostReg_ClearLog();
+    HOST_CHECK_EQ(Dio_FlipChannel(45), STD_LOW);
+    HOST_CHECK_EQ(HostReg_LogLength(), 2u);
+    HOST_CHECK_EQ(HostReg_Count(pc13, 4u, 2u), 2u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOC->ODR)), 0x0001u);
+
+    // Dio_ReadChannel: một load alias IDR trả về đúng 0/1
+    HostReg_Poke(HOST_ADDR(GPIOB->IDR), 0x0100u);
+    HostReg_ClearLog();
+    HOST_CHECK_EQ(Dio_ReadChannel(24), STD_HIGH);
+    HOST_CHECK_EQ(Dio_ReadChannel(25), STD_LOW);
+    HOST_CHECK_EQ(HostReg_LogLength(), 2u);
+    HOST_CHECK_EQ(HostReg_Count(0x42218120u, 4u, 0u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOB), GPIO_SPAN, 2u), 0u);
+
+    // Hàm truy cập inline của kênh đặt tên đi cùng đường alias
+    HostReg_ClearLog();
+    HOST_CHECK_EQ(Dio_ReadChannel_24(), STD_HIGH);
+    Dio_WriteChannel_45(STD_HIGH);
+    HOST_CHECK_EQ(HostReg_LogLength(), 2u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOC->ODR)), 0x2001u);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Test_AliasTable();
+
+    HostReg_Start();
+    Test_AliasAccess();
+    HostReg_Stop();
+
+    return HOST_TEST_RESULT("Test_DioBitBand");
+}
@@ -0,0 +1,189 @@
+/***************************************************************************
+ * @file    Test_DioDebounce.c
+ * @brief   Bộ debounce đếm dọc so với vòng lặp đếm theo từng chân
+ * @details Chạy Dio_DebounceMainFunction và một bản tham chiếu đếm riêng
+ *          từng chân (cách làm thông thường: mỗi chân một bộ đếm uint8) trên
+ *          cùng chuỗi đầu vào nhiễu giả ngẫu nhiên, với ngưỡng 0..7 trải đều
+ *          cho 64 kênh. Hai bên phải cho cùng mức đã lọc và cùng mặt nạ thay
+ *          đổi ở mọi mẫu. Sau đó đo thời gian mỗi lần gọi của hai cách trên
+ *          máy chạy test (build -O2, chỉ để so tương đối, không phải số chu kỳ
+ *          Cortex-M3) và số truy cập bus của một lượt trên mô hình thanh ghi.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include <time.h>
+
+/*
+ * Test dùng bảng ngưỡng riêng thay cho bảng của board: Dio_Cfg.c được include
+ * trực tiếp với tên bảng ngưỡng đổi đi, bảng Dio_DebounceThreshold thật được
+ * định nghĩa bên dưới (makefile không link Dio_Cfg.c cho test này).
+ */
+#define Dio_DebounceThreshold   Test_BoardDebounceThreshold
+#include "../DIO_Driver/Dio_Cfg.c"
+#undef Dio_DebounceThreshold
+
+#include "Dio.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_SAMPLES        20000u
+#define TEST_BENCH_CALLS    200000u
+
+/* Ngưỡng theo kênh: 0..7 lặp lại, 0 được driver coi như 1 */
+const uint8 Dio_DebounceThreshold[DIO_NUM_CHANNELS] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7,
+    1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0,
+    2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1,
+    7, 6, 5, 4, 3, 2, 1, 0, 7, 6, 5, 4, 3, 2, 1, 0
+};
+
+/* Bản tham chiếu: mỗi chân một bộ đếm */
+typedef struct
+{
+    uint8 count[16];
+    uint8 threshold[16];
+    uint16 state;
+    uint16 changed;
+} Test_PinLoopPortType;
+
+static Test_PinLoopPortType Test_PinLoop[DIO_NUM_PORTS];
+
+static void Test_PinLoopInit(void)
+{
+    for (uint32 p = 0; p < DIO_NUM_PORTS; p++)
+    {
+        for (uint32 pin = 0; pin < 16u; pin++)
+        {
+            uint8 thr = Dio_DebounceThreshold[p * 16u + pin];
+
+            Test_PinLoop[p].threshold[pin] = (thr == 0u) ? 1u : thr;
+            Test_PinLoop[p].count[pin] = 0u;
+        }
+        Test_PinLoop[p].state = (uint16)DIO_GET_PORT_BASE(p)->IDR;
+        Test_PinLoop[p].changed = 0u;
+    }
+}
+
+static void Test_PinLoopMainFunction(void)
+{
+    for (uint32 p = 0; p < DIO_NUM_PORTS; p++)
+    {
+        Test_PinLoopPortType *d = &Test_PinLoop[p];
+        uint16 raw = (uint16)DIO_GET_PORT_BASE(p)->IDR;
+
+        for (uint32 pin = 0; pin < 16u; pin++)
+        {
+            uint16 bit = (uint16)(1u << pin);
+
+            if (((raw ^ d->state) & bit) == 0u)
+            {
+                d->count[pin] = 0u;
+            }
+            else if (++d->count[pin] >= d->threshold[pin])
+            {
+                d->count[pin] = 0u;
+                d->state ^= bit;
+                d->changed |= bit;
+            }
+        }
+    }
+}
+
+/* LCG cố định để kết quả lặp lại được */
+static uint32 Test_Seed = 12345u;
+static uint32 Test_Random(void)
+{
+    Test_Seed = Test_Seed * 1103515245u + 12345u;
+    return Test_Seed >> 8;
+}
+
+/* Mức "thật" đổi thỉnh thoảng, cộng nhiễu xung ngắn ở vài chân mỗi mẫu */
+static uint16 Test_Level[DIO_NUM_PORTS];
+static void Test_NextSample(void)
+{
+    for (uint32 p = 0; p < DIO_NUM_PORTS; p++)
+    {
+        uint16 noise = (uint16)(Test_Random() & Test_Random() & Test_Random());
+
+        if ((Test_Random() & 0x1Fu) == 0u) Test_Level[p] ^= (uint16)Test_Random();
+        DIO_GET_PORT_BASE(p)->IDR = (uint16)(Test_Level[p] ^ noise);
+    }
+}
+
+static void Test_Equivalence(void)
+{
+    uint32 mismatches = 0u;
+    uint32 changes = 0u;
+
+    Test_NextSample();
+    Dio_DebounceInit();
+    Test_PinLoopInit();
+
+    for (uint32 n = 0; n < TEST_SAMPLES; n++)
+    {
+        Test_NextSample();
+        Dio_DebounceMainFunction();
+        Test_PinLoopMainFunction();
+
+        for (Dio_PortType p = 0; p < DIO_NUM_PORTS; p++)
+        {
+            Dio_PortLevelType changed = Dio_GetDebounceChanges(p);
+
+            if (changed != Test_PinLoop[p].changed) mismatches++;
+            changes += __builtin_popcount(changed);
+            Test_PinLoop[p].changed = 0u;
+
+            for (uint32 pin = 0; pin < 16u; pin++)
+            {
+                Dio_LevelType ref = ((Test_PinLoop[p].state >> pin) & 1u) ? STD_HIGH : STD_LOW;
+
+                if (Dio_ReadChannelDebounced((Dio_ChannelType)(p * 16u + pin)) != ref) mismatches++;
+            }
+        }
+    }
+    HOST_CHECK_EQ(mismatches, 0u);
+    HOST_CHECK(changes > 0u);
+}
+
+static double Test_NsPerCall(void (*fn)(void))
+{
+    struct timespec t0;
+    struct timespec t1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32 n = 0; n < TEST_BENCH_CALLS; n++)
+    {
+        // Đổi một chân mỗi lượt để cả hai cách đều phải đếm
+        GPIOA->IDR = n & 0x0101u;
+        fn();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / TEST_BENCH_CALLS;
+}
+
+static void Test_Benchmark(void)
+{
+    double vertical = Test_NsPerCall(Dio_DebounceMainFunction);
+    double pinLoop = Test_NsPerCall(Test_PinLoopMainFunction);
+    uint32 accesses;
+
+    // Trên bus cả hai cách đều đọc IDR một lần mỗi port
+    HostReg_Start();
+    Dio_DebounceMainFunction();
+    accesses = HostReg_LogLength();
+    HostReg_Stop();
+    HOST_CHECK_EQ(accesses, DIO_NUM_PORTS);
+
+    printf("Dio_DebounceMainFunction (64 ch): %.1f ns/call, per-pin loop: %.1f ns/call (host, x%.1f), "
+           "%u IDR reads\n", vertical, pinLoop, pinLoop / vertical, (unsigned)accesses);
+}
+
+int main(void)
+{
+    HostReg_Init();
+
+    Test_Equivalence();
+    Test_Benchmark();
+
+    return HOST_TEST_RESULT("Test_DioDebounce");
+}
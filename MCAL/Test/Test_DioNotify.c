@@ -0,0 +1,181 @@
+/***************************************************************************
+ * @file    Test_DioNotify.c
+ * @brief   Thông báo EXTI của DIO: critical section, NVIC và hàng đợi sự kiện
+ * @details - Dio_EnableNotification/Dio_DisableNotification: mọi truy cập vào
+ *            EXTI và AFIO phải xảy ra khi PRIMASK = 1 (đếm bằng
+ *            HostReg_CountUnmasked), vector EXTI0..4 tắt cùng line, vector
+ *            dùng chung chỉ tắt khi line cuối cùng của nhóm tắt.
+ *          - Độ dài ISR: số truy cập bus của Dio_ExtiIsr theo số line đang chờ.
+ *          - Mô hình hàng đợi: ISR sinh một sự kiện mỗi lần, vòng lặp chính
+ *            lấy theo lô sau mỗi K ngắt; in tỉ lệ sự kiện bị bỏ theo K.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Dio.h"
+#include "Clock.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_EVENTS         1024u
+
+/* Các vector ngắt trong Dio.c (bảng vector gọi trực tiếp, không có ở Dio.h) */
+void EXTI0_IRQHandler(void);
+void EXTI9_5_IRQHandler(void);
+
+static uint32 Test_ExtiUnmasked(void)
+{
+    return HostReg_CountUnmasked(HOST_ADDR(*EXTI), (uint32)sizeof(EXTI_TypeDef)) +
+           HostReg_CountUnmasked(HOST_ADDR(*AFIO), (uint32)sizeof(AFIO_TypeDef));
+}
+
+static uint8 Test_IrqEnabled(IRQn_Type irq)
+{
+    return (uint8)((HostReg_Peek(HOST_ADDR(NVIC->ISER[irq >> 5])) >> (irq & 0x1Fu)) & 1u);
+}
+
+static void Test_EnableDisable(void)
+{
+    HostReg_ClearLog();
+    HOST_CHECK_EQ(Dio_EnableNotification(0, DIO_EDGE_RISING), E_OK);             // PA0
+    HOST_CHECK_EQ(Dio_EnableNotification(24, DIO_EDGE_BOTH), E_OK);              // PB8
+    HOST_CHECK_EQ(Dio_EnableNotification(5, DIO_EDGE_FALLING), E_OK);            // PA5
+    HOST_CHECK(HostReg_Count(HOST_ADDR(*EXTI), (uint32)sizeof(EXTI_TypeDef), 2u) > 0u);
+    HOST_CHECK_EQ(Test_ExtiUnmasked(), 0u);
+    HOST_CHECK_EQ(HostReg_Primask, 0u);
+
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(EXTI->IMR)), 0x0121u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(EXTI->RTSR)), 0x0101u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(EXTI->FTSR)), 0x0120u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(AFIO->EXTICR[2])) & 0xFu, 1u);       // EXTI8 = port B
+    HOST_CHECK_EQ(Test_IrqEnabled(EXTI0_IRQn), 1u);
+    HOST_CHECK_EQ(Test_IrqEnabled(EXTI9_5_IRQn), 1u);
+    HOST_CHECK_EQ(Clock_GetRefCount(CLOCK_AFIO), 1u);
+
+    // Line 8 đang nối với port B: PC8 bị từ chối, PRIMASK được trả lại
+    HostReg_ClearLog();
+    HOST_CHECK_EQ(Dio_EnableNotification(40, DIO_EDGE_RISING), E_NOT_OK);
+    HOST_CHECK_EQ(HostReg_Primask, 0u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*EXTI), (uint32)sizeof(EXTI_TypeDef), 1u), 0u);
+
+    // EXTI0 dùng riêng: tắt line là tắt vector
+    HostReg_ClearLog();
+    Dio_DisableNotification(0);
+    HOST_CHECK_EQ(Test_ExtiUnmasked(), 0u);
+    HOST_CHECK_EQ(Test_IrqEnabled(EXTI0_IRQn), 0u);
+
+    // EXTI9_5 dùng chung: còn PA5 thì vector vẫn bật, tắt nốt PA5 thì tắt
+    Dio_DisableNotification(24);
+    HOST_CHECK_EQ(Test_IrqEnabled(EXTI9_5_IRQn), 1u);
+    HOST_CHECK_EQ(Clock_GetRefCount(CLOCK_AFIO), 1u);
+    Dio_DisableNotification(5);
+    HOST_CHECK_EQ(Test_IrqEnabled(EXTI9_5_IRQn), 0u);
+    HOST_CHECK_EQ(Test_ExtiUnmasked(), 0u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(EXTI->IMR)), 0u);
+    HOST_CHECK_EQ(Clock_GetRefCount(CLOCK_AFIO), 0u);
+}
+
+static void Test_IsrLength(void)
+{
+    Dio_EventType ev[DIO_EVENT_QUEUE_SIZE];
+    uint32 one;
+    uint32 five;
+
+    // Một line, cạnh cố định: CYCCNT, PR, IMR, ghi PR, CYCCNT
+    HOST_CHECK_EQ(Dio_EnableNotification(0, DIO_EDGE_RISING), E_OK);
+    HostReg_Poke(HOST_ADDR(EXTI->PR), 0x0001u);
+    HostReg_ClearLog();
+    EXTI0_IRQHandler();
+    one = HostReg_LogLength();
+    HOST_CHECK_EQ(one, 5u);
+    HOST_CHECK_EQ(Dio_ReadEvents(ev, DIO_EVENT_QUEUE_SIZE), 1u);
+    HOST_CHECK_EQ(ev[0].channel, 0u);
+    HOST_CHECK_EQ(ev[0].edge, DIO_EDGE_RISING);
+
+    // Năm line cả hai cạnh cùng chờ trên EXTI9_5: thêm một lần đọc IDR mỗi line
+    for (Dio_ChannelType ch = 5; ch <= 9; ch++)
+    {
+        HOST_CHECK_EQ(Dio_EnableNotification(ch, DIO_EDGE_BOTH), E_OK);
+    }
+    HostReg_Poke(HOST_ADDR(GPIOA->IDR), 0x0140u);
+    HostReg_Poke(HOST_ADDR(EXTI->PR), 0x03E0u);
+    HostReg_ClearLog();
+    EXTI9_5_IRQHandler();
+    five = HostReg_LogLength();
+    HOST_CHECK_EQ(five, one + 5u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(EXTI->PR)), 0u);
+    HOST_CHECK_EQ(Dio_ReadEvents(ev, DIO_EVENT_QUEUE_SIZE), 5u);
+    HOST_CHECK_EQ(ev[0].channel, 9u);                       // line cao nhất trước
+    HOST_CHECK_EQ(ev[0].edge, DIO_EDGE_FALLING);
+    HOST_CHECK_EQ(ev[2].channel, 7u);
+    HOST_CHECK_EQ(ev[3].edge, DIO_EDGE_RISING);             // PA6 đang mức cao
+
+    for (Dio_ChannelType ch = 5; ch <= 9; ch++) Dio_DisableNotification(ch);
+
+    printf("Dio_ExtiIsr: %u bus accesses for 1 line, %u for 5 lines (both edges)\n",
+           (unsigned)one, (unsigned)five);
+}
+
+/**
+ * @brief Chạy TEST_EVENTS ngắt EXTI0, consumer lấy hết hàng đợi sau mỗi Batch ngắt
+ * @return Số sự kiện bị bỏ
+ */
+static uint32 Test_RingRun(uint32 Batch)
+{
+    Dio_EventType ev[DIO_EVENT_QUEUE_SIZE];
+    uint32 dropped = Dio_GetDroppedEvents();
+    uint32 received = 0u;
+
+    for (uint32 n = 1; n <= TEST_EVENTS; n++)
+    {
+        HostReg_Poke(HOST_ADDR(EXTI->PR), 0x0001u);
+        EXTI0_IRQHandler();
+        if ((n % Batch) == 0u || n == TEST_EVENTS)
+        {
+            uint8 got;
+
+            while ((got = Dio_ReadEvents(ev, DIO_EVENT_QUEUE_SIZE)) != 0u) received += got;
+        }
+    }
+
+    dropped = Dio_GetDroppedEvents() - dropped;
+    HOST_CHECK_EQ(received + dropped, TEST_EVENTS);
+    return dropped;
+}
+
+static void Test_RingDropRate(void)
+{
+    static const uint32 batches[] = { 1u, 16u, DIO_EVENT_QUEUE_SIZE, DIO_EVENT_QUEUE_SIZE + 8u, 2u * DIO_EVENT_QUEUE_SIZE };
+
+    printf("Event ring (%u entries), %u interrupts:\n", (unsigned)DIO_EVENT_QUEUE_SIZE, (unsigned)TEST_EVENTS);
+    for (uint32 i = 0; i < sizeof(batches) / sizeof(batches[0]); i++)
+    {
+        uint32 dropped = Test_RingRun(batches[i]);
+
+        // Đầy đúng khi có DIO_EVENT_QUEUE_SIZE phần tử chưa lấy
+        if (batches[i] <= DIO_EVENT_QUEUE_SIZE)
+        {
+            HOST_CHECK_EQ(dropped, 0u);
+        }
+        else
+        {
+            HOST_CHECK_EQ(dropped, (TEST_EVENTS / batches[i]) * (batches[i] - DIO_EVENT_QUEUE_SIZE) +
+                                   ((TEST_EVENTS % batches[i] > DIO_EVENT_QUEUE_SIZE) ?
+                                    (TEST_EVENTS % batches[i]) - DIO_EVENT_QUEUE_SIZE : 0u));
+        }
+        printf("  drain every %3u interrupts: %4u dropped (%.1f %%)\n",
+               (unsigned)batches[i], (unsigned)dropped, 100.0 * dropped / TEST_EVENTS);
+    }
+}
+
+int main(void)
+{
+    HostReg_Init();
+    HostReg_Start();
+
+    Test_EnableDisable();
+    Test_IsrLength();
+    Test_RingDropRate();
+
+    HostReg_Stop();
+    return HOST_TEST_RESULT("Test_DioNotify");
+}
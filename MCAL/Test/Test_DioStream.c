@@ -0,0 +1,217 @@
+/***************************************************************************
+ * @file    Test_DioStream.c
+ * @brief   Mô phỏng timer + DMA cho Dio_StreamPort
+ * @details Sau khi Dio_StreamPort cấu hình TIM4/DMA1_Channel7 trên mô hình
+ *          thanh ghi, test đóng vai phần cứng: mỗi sự kiện Update của TIM4
+ *          (khi CEN và UDE bật) là một request DMA, kênh DMA ghi word tiếp
+ *          theo của buffer vào BSRR (ODR đổi theo luật set/reset), giảm
+ *          CNDTR, bật cờ HT/TC, nạp lại khi CIRC và gọi ISR của kênh nếu
+ *          ngắt được cho phép trong CCR và NVIC. Kiểm tra PSC/ARR, chuỗi giá
+ *          trị ODR, cờ và việc dừng/trả clock sau one-shot.
+ *
+ *          CMAR là địa chỉ 32 bit nên mô phỏng DMA đọc thẳng buffer của test
+ *          (trên PC con trỏ 64 bit), chỉ so 32 bit thấp của CMAR.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Dio.h"
+#include "Clock.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_TIMER_CLOCK    72000000u   // TIM4: PCLK1 36 MHz x2 (HostSpl)
+
+#define TEST_FLAG_GL        (0x1uL << ((DIO_STREAM_DMA_CHANNEL_NUM - 1u) * 4u))
+#define TEST_FLAG_TC        (0x2uL << ((DIO_STREAM_DMA_CHANNEL_NUM - 1u) * 4u))
+#define TEST_FLAG_HT        (0x4uL << ((DIO_STREAM_DMA_CHANNEL_NUM - 1u) * 4u))
+
+/* Mẫu 4 bước trên PA0..PA3, PA8 do "ứng dụng" giữ ở mức cao (ngoài mặt nạ) */
+#define TEST_MASK           0x000Fu
+static const uint32 Test_Pattern[4] = {
+    DIO_BSRR_VALUE(0x1u, TEST_MASK),
+    DIO_BSRR_VALUE(0x3u, TEST_MASK),
+    DIO_BSRR_VALUE(0x6u, TEST_MASK),
+    DIO_BSRR_VALUE(0xCu, TEST_MASK)
+};
+static const uint16 Test_Expected[4] = { 0x0101u, 0x0103u, 0x0106u, 0x010Cu };
+
+static uint32 Test_IsrCount;
+static uint32 Test_IsrAccesses;
+
+/* Thanh ghi TIM là 16 bit, DMA/NVIC 32 bit: đọc/ghi cả word qua mô hình */
+#define Test_Rd(reg)        HostReg_Peek(HOST_ADDR(*(reg)))
+#define Test_Wr(reg, value) HostReg_Poke(HOST_ADDR(*(reg)), (value))
+
+/* Vector ngắt của kênh DMA stream (trong Dio.c, không khai báo ở Dio.h) */
+void DIO_STREAM_DMA_IRQHandler(void);
+
+/**
+ * @brief Một sự kiện Update của timer stream, trả 1 nếu DMA đã ghi một word
+ */
+static uint8 Test_UpdateEvent(const uint32 *buffer, uint16 length)
+{
+    DMA_Channel_TypeDef *dma = DIO_STREAM_DMA_CHANNEL;
+    TIM_TypeDef *tim = DIO_STREAM_TIMER;
+    uint32 ccr = Test_Rd(&dma->CCR);
+    uint32 remaining = Test_Rd(&dma->CNDTR);
+    uint32 flags = 0u;
+    uint32 word;
+    uint32 odrAddr;
+    uint32 odr;
+
+    if ((Test_Rd(&tim->CR1) & TIM_CR1_CEN) == 0u) return 0u;
+    if ((Test_Rd(&tim->DIER) & TIM_DIER_UDE) == 0u) return 0u;
+    if ((ccr & DMA_CCR1_EN) == 0u || remaining == 0u) return 0u;
+
+    // Ghi word vào BSRR: bit set thắng bit reset (RM0008 9.2.5)
+    word = buffer[length - remaining];
+    odrAddr = Test_Rd(&dma->CPAR) - 0x10u + 0x0Cu;
+    odr = HostReg_Peek(odrAddr);
+    odr = ((odr & ~(word >> 16)) | word) & 0xFFFFu;
+    HostReg_Poke(odrAddr, odr);
+
+    remaining--;
+    if (remaining == (uint32)(length - length / 2u)) flags |= TEST_FLAG_HT;
+    if (remaining == 0u)
+    {
+        flags |= TEST_FLAG_TC;
+        if ((ccr & DMA_CCR1_CIRC) != 0u) remaining = length;
+    }
+    Test_Wr(&dma->CNDTR, remaining);
+
+    if (flags != 0u)
+    {
+        Test_Wr(&DMA1->ISR, Test_Rd(&DMA1->ISR) | flags | TEST_FLAG_GL);
+
+        if ((((flags & TEST_FLAG_HT) != 0u && (ccr & DMA_CCR1_HTIE) != 0u) ||
+             ((flags & TEST_FLAG_TC) != 0u && (ccr & DMA_CCR1_TCIE) != 0u)) &&
+            (Test_Rd(&NVIC->ISER[DIO_STREAM_DMA_IRQn >> 5]) & (1uL << (DIO_STREAM_DMA_IRQn & 0x1Fu))) != 0u)
+        {
+            uint32 before = HostReg_LogLength();
+
+            DIO_STREAM_DMA_IRQHandler();
+            Test_IsrAccesses += HostReg_LogLength() - before;
+            Test_IsrCount++;
+        }
+    }
+    return 1u;
+}
+
+static void Test_TimeBase(void)
+{
+    static const uint32 rates[] = { 1000000u, 100000u, 1000u, 50u, 10u };
+    TIM_TypeDef *tim = DIO_STREAM_TIMER;
+
+    for (uint32 i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        uint32 psc;
+        uint32 arr;
+        uint32 actual;
+
+        HOST_CHECK_EQ(Dio_StreamPort(GPIO_PORT_A, Test_Pattern, 4u, rates[i], DIO_STREAM_CIRCULAR), E_OK);
+        psc = Test_Rd(&tim->PSC);
+        arr = Test_Rd(&tim->ARR);
+        actual = TEST_TIMER_CLOCK / ((psc + 1u) * (arr + 1u));
+
+        // Sai số chỉ do làm tròn xuống số tick nguyên: < 0.1 %
+        HOST_CHECK(arr > 0u && arr <= 0xFFFFu && psc <= 0xFFFFu);
+        HOST_CHECK(actual >= rates[i] && (actual - rates[i]) * 1000u <= rates[i]);
+        printf("  %7u Hz: PSC=%5u ARR=%5u -> %u Hz\n",
+               (unsigned)rates[i], (unsigned)psc, (unsigned)arr, (unsigned)actual);
+        Dio_StopStream();
+    }
+
+    // Tần số quá cao (ARR = 0) bị từ chối
+    HOST_CHECK_EQ(Dio_StreamPort(GPIO_PORT_A, Test_Pattern, 4u, TEST_TIMER_CLOCK, DIO_STREAM_CIRCULAR), E_NOT_OK);
+}
+
+static void Test_OneShot(void)
+{
+    DMA_Channel_TypeDef *dma = DIO_STREAM_DMA_CHANNEL;
+    uint32 i;
+
+    HostReg_Poke(HOST_ADDR(GPIOA->ODR), 0x0100u);
+    Test_IsrCount = 0u;
+    HOST_CHECK_EQ(Dio_StreamPort(GPIO_PORT_A, Test_Pattern, 4u, 100000u, DIO_STREAM_ONE_SHOT), E_OK);
+
+    // Cấu hình DMA: mem -> BSRR 32 bit, tăng địa chỉ bộ nhớ, NVIC đúng mức ưu tiên
+    HOST_CHECK_EQ(Test_Rd(&dma->CPAR), HOST_ADDR(GPIOA->BSRR));
+    HOST_CHECK_EQ(Test_Rd(&dma->CMAR), (uint32)(uintptr_t)Test_Pattern);
+    HOST_CHECK_EQ(Test_Rd(&dma->CNDTR), 4u);
+    HOST_CHECK((Test_Rd(&dma->CCR) & (DMA_CCR1_EN | DMA_CCR1_DIR | DMA_CCR1_MINC | DMA_CCR1_TCIE)) ==
+               (DMA_CCR1_EN | DMA_CCR1_DIR | DMA_CCR1_MINC | DMA_CCR1_TCIE));
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(NVIC->IP[DIO_STREAM_DMA_IRQn])) >> ((DIO_STREAM_DMA_IRQn & 3u) * 8u) & 0xFFu,
+                  DIO_STREAM_IRQ_PRIORITY << 4);
+    HOST_CHECK_EQ(Clock_GetRefCount(DIO_STREAM_TIMER_CLOCK), 1u);
+
+    for (i = 0; i < 4u; i++)
+    {
+        HOST_CHECK_EQ(Test_UpdateEvent(Test_Pattern, 4u), 1u);
+        HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOA->ODR)), Test_Expected[i]);
+    }
+
+    // TC -> ISR dừng timer/DMA, xóa cờ và trả clock; không còn word nào được ghi
+    HOST_CHECK_EQ(Test_IsrCount, 1u);
+    HOST_CHECK_EQ(Test_UpdateEvent(Test_Pattern, 4u), 0u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(DMA1->ISR)) & (TEST_FLAG_GL | TEST_FLAG_TC | TEST_FLAG_HT), 0u);
+    HOST_CHECK_EQ(Clock_GetRefCount(DIO_STREAM_TIMER_CLOCK), 0u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOA->ODR)), 0x010Cu);
+}
+
+static void Test_Circular(void)
+{
+    uint32 i;
+
+    HostReg_Poke(HOST_ADDR(GPIOA->ODR), 0x0100u);
+    Test_IsrCount = 0u;
+    HOST_CHECK_EQ(Dio_StreamPort(GPIO_PORT_A, Test_Pattern, 4u, 100000u, DIO_STREAM_CIRCULAR), E_OK);
+
+    // Vòng lặp không cần CPU: 3 vòng buffer, không ngắt nào (không có callback)
+    for (i = 0; i < 12u; i++)
+    {
+        HOST_CHECK_EQ(Test_UpdateEvent(Test_Pattern, 4u), 1u);
+        HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOA->ODR)), Test_Expected[i % 4u]);
+    }
+    HOST_CHECK_EQ(Test_IsrCount, 0u);
+    Dio_StopStream();
+    HOST_CHECK_EQ(Test_UpdateEvent(Test_Pattern, 4u), 0u);
+}
+
+static void Test_DoubleBuffer(void)
+{
+    uint32 i;
+
+    HostReg_Poke(HOST_ADDR(GPIOA->ODR), 0x0100u);
+    Test_IsrCount = 0u;
+    Test_IsrAccesses = 0u;
+    HOST_CHECK_EQ(Dio_StreamPort(GPIO_PORT_A, Test_Pattern, 4u, 100000u, DIO_STREAM_DOUBLE_BUFFER), E_OK);
+
+    // Hai vòng: ngắt ở nửa buffer và cuối buffer mỗi vòng
+    for (i = 0; i < 8u; i++)
+    {
+        HOST_CHECK_EQ(Test_UpdateEvent(Test_Pattern, 4u), 1u);
+        HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOA->ODR)), Test_Expected[i % 4u]);
+    }
+    HOST_CHECK_EQ(Test_IsrCount, 4u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(DMA1->ISR)) & (TEST_FLAG_GL | TEST_FLAG_TC | TEST_FLAG_HT), 0u);
+    Dio_StopStream();
+
+    // ISR không có callback: một lần đọc ISR + một lần ghi IFCR
+    HOST_CHECK_EQ(Test_IsrAccesses, 2u * Test_IsrCount);
+    printf("Dio_StreamPort: 8 words, %u DMA interrupts, %u bus accesses per interrupt\n",
+           (unsigned)Test_IsrCount, (unsigned)(Test_IsrAccesses / Test_IsrCount));
+}
+
+int main(void)
+{
+    HostReg_Init();
+    HostReg_Start();
+
+    Test_TimeBase();
+    Test_OneShot();
+    Test_Circular();
+    Test_DoubleBuffer();
+
+    HostReg_Stop();
+    return HOST_TEST_RESULT("Test_DioStream");
+}
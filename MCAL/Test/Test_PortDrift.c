@@ -0,0 +1,135 @@
+/***************************************************************************
+ * @file    Test_PortDrift.c
+ * @brief   Port_RefreshPortDirection: phát hiện, sửa và đếm cấu hình bị lệch
+ * @details Sau Port_Init, test làm hỏng trực tiếp trên mô hình thanh ghi
+ *          (không qua driver) một nibble CRL (PA1), một nibble CRH (PA9) và
+ *          bit chọn pull trong ODR của một input (PA10), cùng với nibble và
+ *          bit ODR của PA0 là chân DirectionChangeable (không được giám
+ *          sát). Refresh phải ghi lại đúng ba chỗ đó, mỗi thanh ghi một lệnh
+ *          ghi, để nguyên PA0, không chạm GPIOB (không lệch) và tăng
+ *          Port_GetDriftCount đúng 3. Lần refresh sau không ghi gì nữa.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Port.h"
+#include "Port_Cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+/* Nibble CNF/MODE (RM0008 9.2.1) với tốc độ 2 MHz */
+#define NIB_IN_PULL         0x8u    // CNF = 10, MODE = 00
+#define NIB_OUT_PP          0x2u    // CNF = 00, MODE = 10
+#define NIB_OUT_OD_50       0x7u    // CNF = 01, MODE = 11 (giá trị làm hỏng)
+
+#define TEST_PIN(Port, Id, Dir, Pl, Chg) \
+    { .PortID = (Port), .PinID = (Id), .PinMode = PORT_PIN_MODE_DIO, .Direction = (Dir), .Speed = GPIO_Speed_2MHz, \
+      .Pull = (Pl), .Level = PORT_PIN_LEVEL_LOW, .DirectionChangeable = (Chg), .ModeChangeable = (Chg) }
+
+static const Port_PinConfigType Test_Pins[] = {
+    TEST_PIN(PORT_ID_A, 0,  PORT_PIN_IN,  PULL_UP,   1),    // PA0: đổi hướng được, không giám sát
+    TEST_PIN(PORT_ID_A, 1,  PORT_PIN_OUT, PULL_UP,   0),    // PA1: output push-pull
+    TEST_PIN(PORT_ID_A, 9,  PORT_PIN_IN,  PULL_UP,   0),    // PA9: input pull-up
+    TEST_PIN(PORT_ID_A, 10, PORT_PIN_IN,  PULL_DOWN, 0),    // PA10: input pull-down
+    TEST_PIN(PORT_ID_B, 28, PORT_PIN_OUT, PULL_UP,   0)     // PB12: output, không bị làm hỏng
+};
+
+const Port_ConfigType Port_ConfigSets[PORT_NUM_CONFIG_SETS] = {
+    { .PinCfgType = Test_Pins, .PortCfg_PinsCount = 5, .RegImages = NULL_PTR },
+    { .PinCfgType = Test_Pins, .PortCfg_PinsCount = 5, .RegImages = NULL_PTR }
+};
+
+#define GPIO_SPAN       ((uint32)sizeof(GPIO_TypeDef))
+
+static uint32 Test_Nibble(GPIO_TypeDef *port, uint8 bit)
+{
+    uint32 cr = HostReg_Peek((bit < 8u) ? HOST_ADDR(port->CRL) : HOST_ADDR(port->CRH));
+
+    return (cr >> ((bit % 8u) * 4u)) & 0xFu;
+}
+
+static void Test_SetNibble(GPIO_TypeDef *port, uint8 bit, uint32 nibble)
+{
+    uint32 addr = (bit < 8u) ? HOST_ADDR(port->CRL) : HOST_ADDR(port->CRH);
+    uint32 shift = (bit % 8u) * 4u;
+
+    HostReg_Poke(addr, (HostReg_Peek(addr) & ~(0xFuL << shift)) | (nibble << shift));
+}
+
+static uint32 Test_Odr(GPIO_TypeDef *port)
+{
+    return HostReg_Peek(HOST_ADDR(port->ODR)) & 0xFFFFu;
+}
+
+/* Giá trị của lệnh ghi đầu tiên vào addr trong log, 0 nếu không có */
+static uint32 Test_WrittenValue(uint32 addr)
+{
+    for (uint32 i = 0; i < HostReg_LogLength(); i++)
+    {
+        const HostReg_AccessType* a = HostReg_LogAt(i);
+
+        if (a->write && a->addr == addr) return a->value;
+    }
+    return 0u;
+}
+
+int main(void)
+{
+    uint32 before;
+
+    HostReg_Init();
+    HostReg_Start();
+    Port_Init(&Port_ConfigSets[0]);
+    HostReg_Stop();
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 1), NIB_OUT_PP);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 9), NIB_IN_PULL);
+    HOST_CHECK_EQ(Test_Odr(GPIOA) & 0x0601u, 0x0201u);
+
+    // Không lệch: chỉ đọc, không ghi, không đếm
+    before = Port_GetDriftCount();
+    HostReg_ClearLog();
+    HostReg_Start();
+    Port_RefreshPortDirection();
+    HostReg_Stop();
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOA), 2u * 0x400u, 1u), 0u);
+    HOST_CHECK_EQ(Port_GetDriftCount(), before);
+
+    // Làm hỏng PA1 (CRL), PA9 (CRH), bit pull-down của PA10 (ODR), và cả PA0 (được phép đổi)
+    Test_SetNibble(GPIOA, 1, NIB_OUT_OD_50);
+    Test_SetNibble(GPIOA, 9, NIB_OUT_OD_50);
+    Test_SetNibble(GPIOA, 0, NIB_OUT_PP);
+    HostReg_Poke(HOST_ADDR(GPIOA->ODR), (Test_Odr(GPIOA) | 0x0400u) & ~0x0001u);
+
+    HostReg_ClearLog();
+    HostReg_Start();
+    Port_RefreshPortDirection();
+    HostReg_Stop();
+
+    // Đúng ba chỗ được sửa, mỗi thanh ghi một lệnh ghi
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 1), NIB_OUT_PP);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 9), NIB_IN_PULL);
+    HOST_CHECK_EQ(Test_Odr(GPIOA) & 0x0400u, 0u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(GPIOA->CRL), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(GPIOA->CRH), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(GPIOA->BSRR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOA), GPIO_SPAN, 1u), 3u);
+    // Mỗi lệnh ghi chỉ đổi nibble/bit bị lệch: CRL giữ nibble PA0, BSRR chỉ reset bit 10
+    HOST_CHECK_EQ(Test_WrittenValue(HOST_ADDR(GPIOA->CRL)) & 0xFFu, (NIB_OUT_PP << 4) | NIB_OUT_PP);
+    HOST_CHECK_EQ(Test_WrittenValue(HOST_ADDR(GPIOA->CRH)) & 0xFF0u, (NIB_IN_PULL << 8) | (NIB_IN_PULL << 4));
+    HOST_CHECK_EQ(Test_WrittenValue(HOST_ADDR(GPIOA->BSRR)), 0x04000000u);
+    // PA0 đổi hướng được: giữ nguyên giá trị bị đổi
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_OUT_PP);
+    HOST_CHECK_EQ(Test_Odr(GPIOA) & 0x0001u, 0u);
+    // GPIOB không lệch: chỉ đọc
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOB), GPIO_SPAN, 1u), 0u);
+    HOST_CHECK_EQ(Port_GetDriftCount(), before + 3u);
+
+    // Đã sửa: lần sau không ghi gì
+    HostReg_ClearLog();
+    HostReg_Start();
+    Port_RefreshPortDirection();
+    HostReg_Stop();
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOA), 2u * 0x400u, 1u), 0u);
+    HOST_CHECK_EQ(Port_GetDriftCount(), before + 3u);
+
+    return HOST_TEST_RESULT("Test_PortDrift");
+}
@@ -0,0 +1,117 @@
+/***************************************************************************
+ * @file    Test_PortInit.c
+ * @brief   Port_Init: số truy cập bus trước và sau khi gộp ảnh thanh ghi
+ * @details Dùng bộ cấu hình DEFAULT của board (Port_Cfg.c sinh tự động).
+ *          Trước: vòng Port_Deploy_pin cũ, mỗi chân một GPIO_Init (đọc-sửa-
+ *          ghi CRL/CRH) và một GPIO_WriteBit. Sau: Port_Init ghi mỗi port
+ *          bằng ảnh tính sẵn, BSRR rồi CRL, CRH. Cả hai chạy trên mô hình
+ *          thanh ghi; chỉ đếm truy cập vào GPIOA..GPIOD (clock GPIO đã được
+ *          vòng cũ xin trước nên lần ghi APB2ENR không được so).
+ *          Kiểm tra thêm thanh ghi cuối cùng giống nhau ở hai cách, và ở mỗi
+ *          port có ghi ODR thì BSRR đứng trước CRL/CRH (output có mức đúng
+ *          ngay khi chuyển sang mode output). Port không có bit ODR nào thì
+ *          không có lệnh ghi BSRR.
+ *          Đơn vị là truy cập bus của mô hình, không phải chu kỳ Cortex-M3.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Port.h"
+#include "Port_Cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_NUM_PORTS      4u
+#define TEST_PORT_SPAN      0x400u
+
+static GPIO_TypeDef* const Test_Ports[TEST_NUM_PORTS] = { GPIOA, GPIOB, GPIOC, GPIOD };
+
+/* Số truy cập GPIO (mọi port) trong log */
+static uint32 Test_GpioAccesses(void)
+{
+    return HostReg_Count(HOST_ADDR(*GPIOA), TEST_NUM_PORTS * TEST_PORT_SPAN, 2u);
+}
+
+/* CRL, CRH, ODR của mọi port sau một lần khởi tạo */
+static void Test_Snapshot(uint32 regs[TEST_NUM_PORTS][3])
+{
+    for (uint32 p = 0; p < TEST_NUM_PORTS; p++)
+    {
+        regs[p][0] = HostReg_Peek(HOST_ADDR(Test_Ports[p]->CRL));
+        regs[p][1] = HostReg_Peek(HOST_ADDR(Test_Ports[p]->CRH));
+        regs[p][2] = HostReg_Peek(HOST_ADDR(Test_Ports[p]->ODR)) & 0xFFFFu;
+    }
+}
+
+/* Vị trí đầu tiên trong log của lệnh ghi vào reg, 0xFFFFFFFF nếu không có */
+static uint32 Test_FirstWrite(uint32 addr)
+{
+    for (uint32 i = 0; i < HostReg_LogLength(); i++)
+    {
+        const HostReg_AccessType* a = HostReg_LogAt(i);
+
+        if (a->write && a->addr == addr) return i;
+    }
+    return 0xFFFFFFFFu;
+}
+
+static void Test_BsrrFirst(const Port_ConfigType* cfg)
+{
+    for (uint32 p = 0; p < TEST_NUM_PORTS; p++)
+    {
+        const Port_RegImageType* img = &cfg->RegImages[p];
+        uint32 bsrr = Test_FirstWrite(HOST_ADDR(Test_Ports[p]->BSRR));
+        uint32 crl = Test_FirstWrite(HOST_ADDR(Test_Ports[p]->CRL));
+        uint32 crh = Test_FirstWrite(HOST_ADDR(Test_Ports[p]->CRH));
+
+        if (img->odrMask == 0u)
+        {
+            HOST_CHECK_EQ(bsrr, 0xFFFFFFFFu);
+            continue;
+        }
+        HOST_CHECK(bsrr != 0xFFFFFFFFu);
+        HOST_CHECK(bsrr < crl || crl == 0xFFFFFFFFu);
+        HOST_CHECK(bsrr < crh || crh == 0xFFFFFFFFu);
+    }
+}
+
+int main(void)
+{
+    const Port_ConfigType* cfg = &Port_ConfigSets[PORT_CONFIG_SET_DEFAULT];
+    uint32 legacyRegs[TEST_NUM_PORTS][3], initRegs[TEST_NUM_PORTS][3];
+    uint32 legacy, init;
+
+    HostReg_Init();
+
+    // Trước: từng chân qua SPL
+    HostReg_Start();
+    for (uint16 i = 0; i < cfg->PortCfg_PinsCount; i++) Port_Deploy_pin(&cfg->PinCfgType[i]);
+    HostReg_Stop();
+    legacy = Test_GpioAccesses();
+    Test_Snapshot(legacyRegs);
+
+    // Sau: ảnh thanh ghi theo port, từ trạng thái reset
+    HostReg_Reset();
+    HostReg_Start();
+    Port_Init(cfg);
+    HostReg_Stop();
+    init = Test_GpioAccesses();
+    Test_Snapshot(initRegs);
+
+    for (uint32 p = 0; p < TEST_NUM_PORTS; p++)
+    {
+        HOST_CHECK_EQ(initRegs[p][0], legacyRegs[p][0]);
+        HOST_CHECK_EQ(initRegs[p][1], legacyRegs[p][1]);
+        HOST_CHECK_EQ(initRegs[p][2], legacyRegs[p][2]);
+    }
+    Test_BsrrFirst(cfg);
+
+    // Cũ: mỗi chân đọc-ghi CRL/CRH (8) + BSRR/BRR của 3 output và 1 input pull-up (4)
+    HOST_CHECK_EQ(legacy, 12u);
+    // Mới: GPIOA BSRR + CRL, GPIOB và GPIOC BSRR + CRH, mỗi CRL/CRH một đọc và một ghi
+    HOST_CHECK_EQ(init, 9u);
+
+    printf("Port_Init (%u pins, DEFAULT set): %u GPIO bus accesses; Port_Deploy_pin loop: %u\n",
+           (unsigned)cfg->PortCfg_PinsCount, (unsigned)init, (unsigned)legacy);
+
+    return HOST_TEST_RESULT("Test_PortInit");
+}
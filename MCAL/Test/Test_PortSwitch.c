@@ -0,0 +1,124 @@
+/***************************************************************************
+ * @file    Test_PortSwitch.c
+ * @brief   Port_SwitchConfig giữ hướng/mode runtime của chân chung
+ * @details Test dùng hai bộ cấu hình riêng (thay cho Port_Cfg.c của board):
+ *          PA0 có cùng cấu hình ở hai bộ nhưng nằm ở chỉ số khác nhau và
+ *          được phép đổi hướng/mode lúc runtime; PA1 đổi cấu hình giữa hai
+ *          bộ; PB8 chỉ có ở bộ 0, PC13 chỉ có ở bộ 1. Sau khi đổi hướng PA0
+ *          rồi đổi bộ, nibble của PA0 trên thanh ghi và trạng thái runtime
+ *          của driver (dùng bởi Port_SetPinMode/Port_SetPinDirection) phải
+ *          còn nguyên, các chân khác theo bộ mới.
+ *          Đếm số truy cập GPIO của Port_SwitchConfig theo cả hai chiều
+ *          (đơn vị là truy cập bus của mô hình, không phải chu kỳ Cortex-M3).
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Port.h"
+#include "Port_Cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+/* Nibble CNF/MODE (RM0008 9.2.1) với tốc độ 2 MHz */
+#define NIB_IN_PULL         0x8u    // CNF = 10, MODE = 00
+#define NIB_IN_FLOATING     0x4u    // Giá trị reset
+#define NIB_OUT_PP          0x2u    // CNF = 00, MODE = 10
+#define NIB_AF_PP           0xAu    // CNF = 10, MODE = 10
+
+#define TEST_PIN(Port, Id, Mode, Dir, Lvl, Chg) \
+    { .PortID = (Port), .PinID = (Id), .PinMode = (Mode), .Direction = (Dir), .Speed = GPIO_Speed_2MHz, \
+      .Pull = PULL_UP, .Level = (Lvl), .DirectionChangeable = (Chg), .ModeChangeable = (Chg) }
+
+static const Port_PinConfigType Test_Pins0[] = {
+    TEST_PIN(PORT_ID_A, 0,  PORT_PIN_MODE_DIO, PORT_PIN_IN,  PORT_PIN_LEVEL_LOW, 1),    // PA0 chung
+    TEST_PIN(PORT_ID_A, 1,  PORT_PIN_MODE_DIO, PORT_PIN_OUT, PORT_PIN_LEVEL_LOW, 0),    // PA1 đổi cấu hình
+    TEST_PIN(PORT_ID_B, 24, PORT_PIN_MODE_DIO, PORT_PIN_IN,  PORT_PIN_LEVEL_LOW, 0)     // PB8 chỉ bộ 0
+};
+
+static const Port_PinConfigType Test_Pins1[] = {
+    TEST_PIN(PORT_ID_C, 45, PORT_PIN_MODE_DIO, PORT_PIN_OUT, PORT_PIN_LEVEL_HIGH, 0),   // PC13 chỉ bộ 1
+    TEST_PIN(PORT_ID_A, 1,  PORT_PIN_MODE_PWM, PORT_PIN_OUT, PORT_PIN_LEVEL_LOW, 0),
+    TEST_PIN(PORT_ID_A, 0,  PORT_PIN_MODE_DIO, PORT_PIN_IN,  PORT_PIN_LEVEL_LOW, 1)
+};
+
+const Port_ConfigType Port_ConfigSets[PORT_NUM_CONFIG_SETS] = {
+    { .PinCfgType = Test_Pins0, .PortCfg_PinsCount = 3, .RegImages = NULL_PTR },
+    { .PinCfgType = Test_Pins1, .PortCfg_PinsCount = 3, .RegImages = NULL_PTR }
+};
+
+static uint32 Test_Nibble(GPIO_TypeDef *port, uint8 bit)
+{
+    uint32 cr = HostReg_Peek((bit < 8u) ? HOST_ADDR(port->CRL) : HOST_ADDR(port->CRH));
+
+    return (cr >> ((bit % 8u) * 4u)) & 0xFu;
+}
+
+/* Port_SwitchConfig(SetId), trả về số truy cập GPIO (GPIOA..GPIOD) của nó */
+static uint32 Test_Switch(uint8 SetId)
+{
+    HostReg_ClearLog();
+    HOST_CHECK_EQ(Port_SwitchConfig(SetId), E_OK);
+    return HostReg_Count(HOST_ADDR(*GPIOA), PORT_NUM_PORTS * 0x400u, 2u);
+}
+
+int main(void)
+{
+    uint32 toSet1, toSet0;
+
+    HostReg_Init();
+    HostReg_Start();
+
+    Port_Init(&Port_ConfigSets[0]);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_IN_PULL);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 1), NIB_OUT_PP);
+    HOST_CHECK_EQ(Test_Nibble(GPIOB, 8), NIB_IN_PULL);
+
+    // Runtime: PA0 chuyển sang output
+    Port_SetPinDirection(0, PORT_PIN_OUT);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_OUT_PP);
+
+    // Đổi bộ: PA0 giữ output, PA1 -> AF, PB8 về reset, PC13 output mức cao
+    toSet1 = Test_Switch(1);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_OUT_PP);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 1), NIB_AF_PP);
+    HOST_CHECK_EQ(Test_Nibble(GPIOB, 8), NIB_IN_FLOATING);
+    HOST_CHECK_EQ(Test_Nibble(GPIOC, 13), NIB_OUT_PP);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(GPIOC->ODR)) & 0x2000u, 0x2000u);
+
+    // PA0 là chân 2 của bộ 1: đổi mode phải giữ hướng output runtime
+    Port_SetPinMode(2, PORT_PIN_MODE_DIO);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_OUT_PP);
+    Port_SetPinMode(2, PORT_PIN_MODE_PWM);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_AF_PP);
+
+    // Ảnh RAM khớp phần cứng: PA1 (AF) và PC13 là chân được giám sát của bộ 1,
+    // refresh không thấy lệch và không ghi gì (PA0 đổi hướng được, không giám sát)
+    HostReg_ClearLog();
+    Port_RefreshPortDirection();
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*GPIOA), PORT_NUM_PORTS * 0x400u, 1u), 0u);
+    HOST_CHECK_EQ(Port_GetDriftCount(), 0u);
+
+    // Mặt nạ giám sát là của bộ 1: làm hỏng PC13 thì refresh sửa đúng nibble đó
+    HostReg_Poke(HOST_ADDR(GPIOC->CRH), HostReg_Peek(HOST_ADDR(GPIOC->CRH)) & ~(0xFuL << 20));
+    Port_RefreshPortDirection();
+    HOST_CHECK_EQ(Test_Nibble(GPIOC, 13), NIB_OUT_PP);
+    HOST_CHECK_EQ(Port_GetDriftCount(), 1u);
+
+    // Quay lại bộ 0: PA0 vẫn AF output, giữ mode khi đổi hướng về input
+    toSet0 = Test_Switch(0);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_AF_PP);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 1), NIB_OUT_PP);
+    Port_SetPinDirection(0, PORT_PIN_IN);
+    Port_SetPinMode(0, PORT_PIN_MODE_DIO);
+    HOST_CHECK_EQ(Test_Nibble(GPIOA, 0), NIB_IN_PULL);
+
+    HostReg_Stop();
+
+    // Delta 0 -> 1: GPIOA CRL (PA1), GPIOB CRH (PB8), GPIOC BSRR + CRH (PC13);
+    // 1 -> 0: GPIOA CRL, GPIOB BSRR + CRH, GPIOC CRH. Mỗi CRL/CRH một đọc và một ghi
+    HOST_CHECK_EQ(toSet1, 7u);
+    HOST_CHECK_EQ(toSet0, 7u);
+    printf("Port_SwitchConfig: set 0 -> 1 %u GPIO bus accesses, set 1 -> 0 %u\n",
+           (unsigned)toSet1, (unsigned)toSet0);
+
+    return HOST_TEST_RESULT("Test_PortSwitch");
+}
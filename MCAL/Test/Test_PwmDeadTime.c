@@ -0,0 +1,123 @@
+/***************************************************************************
+ * @file    Test_PwmDeadTime.c
+ * @brief   Mã hóa dead-time Pwm_DeadTimeToDtg và kiểm tra trong Pwm_Init
+ * @details Quét 0 .. 200 us từng 1 ns trên clock 72, 64, 36 và 8 MHz. Trong
+ *          dải 1008 tDTS: E_OK, dead-time giải mã không ngắn hơn yêu cầu, là
+ *          giá trị mã hóa được nhỏ nhất thỏa điều đó, và không giảm khi yêu
+ *          cầu tăng. Ngoài dải: E_NOT_OK với Dtg = 0xFF.
+ *          Pwm_Init với TIM1 phải từ chối dead-time ngoài dải (không xin
+ *          clock, không ghi thanh ghi TIM1) thay vì ghi DTG bão hòa.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_MAX_NS     200000u
+#define TEST_MAX_TICKS  1008u
+
+/* Dead-time (tDTS) của một giá trị DTG, RM0008 TIMx_BDTR */
+static uint32 Test_DecodeDtg(uint8 dtg)
+{
+    if ((dtg & 0x80u) == 0u)    return dtg;
+    if ((dtg & 0xC0u) == 0x80u) return (64u + (dtg & 0x3Fu)) * 2u;
+    if ((dtg & 0xE0u) == 0xC0u) return (32u + (dtg & 0x1Fu)) * 8u;
+    return (32u + (dtg & 0x1Fu)) * 16u;
+}
+
+/* Giá trị giải mã nhỏ nhất không ngắn hơn need, 0xFFFFFFFF nếu không có */
+static uint32 Test_MinEncodable(uint32 need)
+{
+    uint32 best = 0xFFFFFFFFu;
+
+    for (uint32 d = 0; d < 256u; d++)
+    {
+        uint32 t = Test_DecodeDtg((uint8)d);
+
+        if (t >= need && t < best) best = t;
+    }
+    return best;
+}
+
+static void Test_Range(uint32 clk)
+{
+    uint32 khz = clk / 1000u;
+    uint32 prev = 0u, maxNs = 0u;
+
+    for (uint32 ns = 0; ns <= TEST_MAX_NS; ns++)
+    {
+        uint64_t need = ((uint64_t)ns * khz + 999999u) / 1000000u;
+        uint8 dtg = 0u;
+        Std_ReturnType ret = Pwm_DeadTimeToDtg(clk, ns, &dtg);
+
+        if (need > TEST_MAX_TICKS)
+        {
+            HOST_CHECK_EQ(ret, E_NOT_OK);
+            HOST_CHECK_EQ(dtg, 0xFFu);
+            continue;
+        }
+
+        uint32 t = Test_DecodeDtg(dtg);
+
+        HOST_CHECK_EQ(ret, E_OK);
+        HOST_CHECK_EQ(t, Test_MinEncodable((uint32)need));
+        HOST_CHECK(t >= prev);
+        prev = t;
+        maxNs = ns;
+    }
+
+    printf("Timer clock %8u Hz: dead-time 0 .. %u ns encodable\n", (unsigned)clk, (unsigned)maxNs);
+}
+
+static const Pwm_ChannelConfigType Test_Channels[] = {
+    { .TIMx = TIM1, .CcrAddr = NULL_PTR, .channel = 1, .classType = PWM_VARIABLE_PERIOD,
+      .defaultFrequencyHz = 20000u, .defaultDutyCycle = 0x4000, .polarity = PWM_HIGH, .idleState = PWM_LOW,
+      .complementary = 1, .nPolarity = PWM_HIGH }
+};
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = sizeof(Test_Channels) / sizeof(Test_Channels[0])
+};
+
+static void Test_InitRejects(void)
+{
+    RCC_ClocksTypeDef board = HostSpl_Clocks;
+    uint8 dtg;
+
+    // PWM_DEADTIME_NS quá 1008 tDTS khi clock TIM1 đủ cao
+    HostSpl_Clocks.HCLK_Frequency = HostSpl_Clocks.PCLK2_Frequency =
+        (uint32)(((uint64_t)(TEST_MAX_TICKS + 1u) * 1000000000u + PWM_DEADTIME_NS - 1u) / PWM_DEADTIME_NS);
+    HOST_CHECK_EQ(Pwm_DeadTimeToDtg(HostSpl_Clocks.PCLK2_Frequency, PWM_DEADTIME_NS, &dtg), E_NOT_OK);
+
+    HostReg_Reset();
+    HostReg_Start();
+    Pwm_Init(&Test_Config);
+    HostReg_Stop();
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*TIM1), (uint32)sizeof(TIM_TypeDef), 1u), 0u);
+    HOST_CHECK_EQ(RCC->APB2ENR & RCC_APB2Periph_TIM1, 0u);
+
+    // Clock của board: Init chạy và BDTR mang DTG đúng
+    HostSpl_Clocks = board;
+    HOST_CHECK_EQ(Pwm_DeadTimeToDtg(board.PCLK2_Frequency, PWM_DEADTIME_NS, &dtg), E_OK);
+    Pwm_Init(&Test_Config);
+    HOST_CHECK(RCC->APB2ENR & RCC_APB2Periph_TIM1);
+    HOST_CHECK_EQ(TIM1->BDTR & TIM_BDTR_DTG, dtg);
+    HOST_CHECK(TIM1->BDTR & TIM_BDTR_MOE);
+    Pwm_DeInit();
+}
+
+int main(void)
+{
+    HostReg_Init();
+
+    Test_Range(72000000u);
+    Test_Range(64000000u);
+    Test_Range(36000000u);
+    Test_Range(8000000u);
+    Test_InitRejects();
+
+    return HOST_TEST_RESULT("Test_PwmDeadTime");
+}
@@ -0,0 +1,151 @@
+/***************************************************************************
+ * @file    Test_PwmDuty.c
+ * @brief   Số lệnh và số truy cập bus của một lần cập nhật duty PWM
+ * @details Sau Pwm_Init với bảng kênh của board, so sánh ba cách đặt duty:
+ *          - Pwm_SetDutyCycleFast: bảng {CCR, period} trong RAM
+ *          - Pwm_SetDutyCycle: kiểm tra tham số rồi gọi đường nhanh
+ *          - bản tham chiếu theo cách cũ: đọc ARR, nhân 32 bit, switch
+ *            chọn CCR1..CCR4 ở mỗi lần gọi
+ *          Số lệnh đếm bằng single-step (HostReg_CountInstructions) trên
+ *          bản build -O2 của máy chạy test (x86-64): đó là số lệnh máy của
+ *          host, chỉ để so tương đối, không phải số lệnh Thumb-2 hay chu kỳ
+ *          Cortex-M3. Số truy cập bus lấy từ log của mô hình thanh ghi.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+/* Vòng điều khiển: 8 kênh mỗi chu kỳ */
+#define TEST_LOOP_CHANNELS  8u
+
+static const Pwm_ConfigType Test_PwmConfig = {
+    .Channels    = pwmChannelscfg,
+    .NumChannels = PinPWM
+};
+
+/* Tham số của các hàm đo (toàn cục để compiler không gộp hằng) */
+Pwm_ChannelType Test_Channel = 0;
+uint16 Test_Duty = 0x4000;
+uint16 Test_Duties[TEST_LOOP_CHANNELS] = { 0x1000, 0x2000, 0x3000, 0x4000, 0x5000, 0x6000, 0x7000, 0x8000 };
+
+/* Bản tham chiếu: cách chọn CCR và tính compare trước khi có bảng runtime */
+static void __attribute__((noinline)) Test_SetDutySwitch(Pwm_ChannelType ChannelNumber, uint16 DutyCycle)
+{
+    const Pwm_ChannelConfigType* ch = &pwmChannelscfg[ChannelNumber];
+    uint16 compare = (uint16)(((uint32)ch->TIMx->ARR * DutyCycle) >> 15);
+
+    switch (ch->channel)
+    {
+        case 1: ch->TIMx->CCR1 = compare; break;
+        case 2: ch->TIMx->CCR2 = compare; break;
+        case 3: ch->TIMx->CCR3 = compare; break;
+        case 4: ch->TIMx->CCR4 = compare; break;
+        default: break;
+    }
+}
+
+static void __attribute__((noinline)) Test_Empty(void)
+{
+    __asm__ volatile ("" ::: "memory");
+}
+
+static void __attribute__((noinline)) Test_Fast(void)
+{
+    Pwm_SetDutyCycleFast(Test_Channel, Test_Duty);
+}
+
+static void __attribute__((noinline)) Test_Checked(void)
+{
+    Pwm_SetDutyCycle(Test_Channel, Test_Duty);
+}
+
+static void __attribute__((noinline)) Test_Switch(void)
+{
+    Test_SetDutySwitch(Test_Channel, Test_Duty);
+}
+
+static void __attribute__((noinline)) Test_FastLoop(void)
+{
+    for (Pwm_ChannelType i = 0; i < TEST_LOOP_CHANNELS; i++) Pwm_SetDutyCycleFast(i, Test_Duties[i]);
+}
+
+static void Test_Values(void)
+{
+    uint32 period = Pwm_ChannelRt[0].period;
+
+    // TIM2 72 MHz, 1 kHz: PSC = 1, ARR + 1 = 36000
+    HOST_CHECK_EQ(period, 36000u);
+    HOST_CHECK_EQ(Pwm_ChannelRt[0].ccr, &TIM2->CCR4);
+
+    Pwm_SetDutyCycleFast(0, 0x4000);
+    HOST_CHECK_EQ(TIM2->CCR4, period / 2u);
+    Pwm_SetDutyCycleFast(0, 0x8000);
+    HOST_CHECK_EQ(TIM2->CCR4, period);
+    Pwm_SetDutyCycle(0, 0x2000);
+    HOST_CHECK_EQ(TIM2->CCR4, period / 4u);
+
+    // Kênh chưa cấu hình ghi vào thanh ghi giả, không chạm timer nào
+    HostReg_Start();
+    Pwm_SetDutyCycleFast(7, 0x4000);
+    HOST_CHECK_EQ(HostReg_LogLength(), 0u);
+    HostReg_Stop();
+}
+
+static void Test_BusAccesses(void)
+{
+    uint32 fast, checked, ref;
+
+    HostReg_Start();
+    Test_Fast();
+    fast = HostReg_LogLength();
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM2->CCR4), 4u, 1u), 1u);
+    HostReg_ClearLog();
+    Test_Checked();
+    checked = HostReg_LogLength();
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(TIM2->CCR4)), Pwm_DutyToCompare(0, Test_Duty));
+    HostReg_ClearLog();
+    Test_Switch();
+    ref = HostReg_LogLength();
+    HostReg_Stop();
+
+    // Đường nhanh: chỉ một lệnh ghi CCR, không đọc ARR
+    HOST_CHECK_EQ(fast, 1u);
+    HOST_CHECK_EQ(checked, 1u);
+    HOST_CHECK_EQ(ref, 2u);
+
+    printf("Bus accesses per update: fast %u, checked %u, ARR read + switch %u\n",
+           (unsigned)fast, (unsigned)checked, (unsigned)ref);
+}
+
+static void Test_Instructions(void)
+{
+    uint32 empty = HostReg_CountInstructions(Test_Empty);
+    uint32 fast = HostReg_CountInstructions(Test_Fast) - empty;
+    uint32 checked = HostReg_CountInstructions(Test_Checked) - empty;
+    uint32 ref = HostReg_CountInstructions(Test_Switch) - empty;
+    uint32 loop = HostReg_CountInstructions(Test_FastLoop) - empty;
+
+    HOST_CHECK(fast > 0u && fast < checked);
+    HOST_CHECK(fast < ref);
+    HOST_CHECK(loop < TEST_LOOP_CHANNELS * ref);
+
+    printf("Host x86-64 -O2 instructions per update (incl. loading the 2 arguments): fast %u, checked %u, "
+           "ARR read + switch %u; %u channels in a loop: %u (%.1f per channel)\n",
+           (unsigned)fast, (unsigned)checked, (unsigned)ref, (unsigned)TEST_LOOP_CHANNELS, (unsigned)loop,
+           (double)loop / TEST_LOOP_CHANNELS);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Pwm_Init(&Test_PwmConfig);
+
+    Test_Values();
+    Test_BusAccesses();
+    Test_Instructions();
+
+    return HOST_TEST_RESULT("Test_PwmDuty");
+}
@@ -0,0 +1,122 @@
+/***************************************************************************
+ * @file    Test_PwmIsr.c
+ * @brief   Thời gian ngắt timer PWM trong trường hợp xấu nhất
+ * @details Trường hợp xấu nhất của một timer: cả bốn kênh đang chạy ramp
+ *          gamma và có notification cả hai cạnh, SR có đủ UIF và CC1IF..
+ *          CC4IF. Đo ba con số của TIM2_IRQHandler (build -O2):
+ *          - số truy cập bus trên mô hình thanh ghi,
+ *          - Pwm_GetIsrMaxCycles, với hook tăng DWT CYCCNT một đơn vị mỗi
+ *            truy cập bus (nên cũng tính bằng truy cập bus),
+ *          - số lệnh máy x86-64 đếm bằng single-step (callback rỗng).
+ *          Không có số chu kỳ Cortex-M3: cần chạy trên chip, đọc
+ *          Pwm_GetIsrMaxCycles. Kiểm tra thêm mức ưu tiên NVIC lấy từ
+ *          PWM_IRQ_PRIORITY và mọi cờ được xóa bằng một lệnh ghi SR.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_FLAGS      (TIM_SR_UIF | TIM_IT_CC1 | TIM_IT_CC2 | TIM_IT_CC3 | TIM_IT_CC4)
+
+/* Vector ngắt trong Pwm.c */
+void TIM2_IRQHandler(void);
+
+static uint32 Test_Calls = 0u;
+
+static void Test_Callback(void)
+{
+    Test_Calls++;
+}
+
+#define TEST_CH(Ch) \
+    { .TIMx = TIM2, .CcrAddr = NULL_PTR, .channel = (Ch), .classType = PWM_VARIABLE_PERIOD, \
+      .defaultFrequencyHz = 20000u, .defaultDutyCycle = 0, .polarity = PWM_HIGH, .idleState = PWM_LOW, \
+      .notificationEnable = 1, .NotificationCb = Test_Callback }
+
+static const Pwm_ChannelConfigType Test_Channels[] = { TEST_CH(1), TEST_CH(2), TEST_CH(3), TEST_CH(4) };
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = sizeof(Test_Channels) / sizeof(Test_Channels[0])
+};
+
+/* Chạy ngắt với các cờ Flags và các kênh đang có ramp (bit theo kênh) */
+static void Test_Setup(uint32 Flags, uint32 RampChannels)
+{
+    for (Pwm_ChannelType ch = 0; ch < 4u; ch++)
+    {
+        Pwm_SetDutyCycleFast(ch, 0);
+        // 10 s ở 20 kHz: ramp còn chạy suốt phép đo
+        if (RampChannels & (1u << ch)) HOST_CHECK_EQ(Pwm_StartRamp(ch, 0x8000, 10000, PWM_RAMP_GAMMA), E_OK);
+        else (void)Pwm_StartRamp(ch, 0, 0, PWM_RAMP_LINEAR);
+    }
+    HostReg_Poke(HOST_ADDR(TIM2->SR), Flags);
+}
+
+static void Test_Priority(void)
+{
+    // Pwm_EnableNotification bật TIM2_IRQn với ưu tiên PWM_IRQ_PRIORITY (4 bit cao của IP)
+    HOST_CHECK_EQ((HostReg_Peek(HOST_ADDR(NVIC->IP[TIM2_IRQn & ~3u])) >> ((TIM2_IRQn & 3u) * 8u)) & 0xFFu,
+                  (PWM_IRQ_PRIORITY << 4) & 0xF0u);
+    HOST_CHECK((HostReg_Peek(HOST_ADDR(NVIC->ISER[0])) >> TIM2_IRQn) & 1u);
+}
+
+static void Test_WorstCase(void)
+{
+    uint32 one, worst, worstCycles, insnOne, insnWorst;
+
+    // Một kênh: chỉ CC1, không ramp
+    Test_Setup(TIM_IT_CC1, 0u);
+    HostReg_SetHook(HostReg_CycleHook);
+    HostReg_Start();
+    TIM2_IRQHandler();
+    one = HostReg_LogLength();
+
+    // Xấu nhất: 4 CC + update, 4 kênh ramp gamma, 4 callback update
+    HostReg_Stop();
+    Test_Setup(TEST_FLAGS, 0xFu);
+    Test_Calls = 0u;
+    HostReg_ClearLog();
+    HostReg_Start();
+    TIM2_IRQHandler();
+    worst = HostReg_LogLength();
+    HostReg_Stop();
+    HostReg_SetHook(NULL_PTR);
+    worstCycles = Pwm_GetIsrMaxCycles();
+
+    HOST_CHECK_EQ(Test_Calls, 8u);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(TIM2->SR)) & TEST_FLAGS, 0u);
+    // SR đọc một lần và ghi một lần; mỗi kênh ramp đúng một lệnh ghi CCR
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM2->SR), 4u, 0u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM2->SR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM2->CCR1), 16u, 1u), 4u);
+    // Chỉ kiểm tra phần đo có chạy: CYCCNT do hook tăng nên không đo tốc độ
+    HOST_CHECK(worstCycles > 0u);
+
+    // Số lệnh host: ngắt chạy thẳng, không ghi log
+    Test_Setup(TIM_IT_CC1, 0u);
+    insnOne = HostReg_CountInstructions(TIM2_IRQHandler);
+    Test_Setup(TEST_FLAGS, 0xFu);
+    insnWorst = HostReg_CountInstructions(TIM2_IRQHandler);
+    HOST_CHECK(insnOne < insnWorst);
+
+    printf("TIM2 IRQ, 1 CC flag: %u bus accesses, %u host instructions\n", (unsigned)one, (unsigned)insnOne);
+    printf("TIM2 IRQ worst case (UIF + 4 CC, 4 gamma ramps, 8 callbacks): %u bus accesses, "
+           "Pwm_GetIsrMaxCycles %u (model: 1 per access), %u host x86-64 instructions\n",
+           (unsigned)worst, (unsigned)worstCycles, (unsigned)insnWorst);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Pwm_Init(&Test_Config);
+    for (Pwm_ChannelType ch = 0; ch < 4u; ch++) Pwm_EnableNotification(ch, PWM_BOTH_EDGES);
+
+    Test_Priority();
+    Test_WorstCase();
+
+    return HOST_TEST_RESULT("Test_PwmIsr");
+}
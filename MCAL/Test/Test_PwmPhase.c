@@ -0,0 +1,147 @@
+/***************************************************************************
+ * @file    Test_PwmPhase.c
+ * @brief   Kênh PWM_FIXED_PERIOD_SHIFTED: pha, center-aligned và chuỗi ITR
+ * @details Ba timer center-aligned 10 kHz (ARR = 3600, chu kỳ 7200 tick):
+ *          TIM2 pha 0 (master), TIM3 pha 90.00 độ (centidegrees), TIM4 pha
+ *          5000 tick. Kiểm tra sau Pwm_Init:
+ *          - CMS = 01, CNT/DIR đặt trước theo pha (Pwm_PresetPhase),
+ *          - TIM2 là master (MMS = enable, MSM), TIM3/TIM4 ở trigger mode
+ *            với TS = ITR1 (TIM2, RM0008 bảng 86), chỉ TIM2 được bật CEN.
+ *          Sau đó mô phỏng ba counter tam giác từ lúc CEN của master cũng bật
+ *          các slave (cùng cạnh clock) và kiểm tra mỗi timer chạm đáy trễ
+ *          đúng số tick của pha so với master. Notification trên timer
+ *          center-aligned phải bị từ chối.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_ARR        3600u
+#define TEST_FULL       (2u * TEST_ARR)
+
+static void Test_Callback(void)
+{
+}
+
+#define TEST_SHIFTED(Tim, Phase, Unit) \
+    { .TIMx = (Tim), .CcrAddr = NULL_PTR, .channel = 1, .classType = PWM_FIXED_PERIOD_SHIFTED, \
+      .defaultFrequencyHz = 10000u, .defaultDutyCycle = 0x4000, .polarity = PWM_HIGH, .idleState = PWM_LOW, \
+      .phase = (Phase), .phaseUnit = (Unit), .notificationEnable = 1, .NotificationCb = Test_Callback }
+
+static const Pwm_ChannelConfigType Test_Channels[] = {
+    TEST_SHIFTED(TIM2, 0,    PWM_PHASE_TICKS),
+    TEST_SHIFTED(TIM3, 9000, PWM_PHASE_CENTIDEGREES),
+    TEST_SHIFTED(TIM4, 5000, PWM_PHASE_TICKS)
+};
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = sizeof(Test_Channels) / sizeof(Test_Channels[0])
+};
+
+/* Trễ kỳ vọng (tick) của từng timer so với master */
+static const uint32 Test_Delay[] = { 0u, 1800u, 5000u };
+
+/* Counter tam giác: 0 -> ARR đếm lên, ARR -> 0 đếm xuống */
+typedef struct
+{
+    uint32 cnt;
+    uint8 down;
+} Test_CounterType;
+
+static void Test_Tick(Test_CounterType *c)
+{
+    if (c->down)
+    {
+        if (--c->cnt == 0u) c->down = 0u;
+    }
+    else if (++c->cnt == TEST_ARR)
+    {
+        c->down = 1u;
+    }
+}
+
+static void Test_Registers(void)
+{
+    TIM_TypeDef* const tims[] = { TIM2, TIM3, TIM4 };
+
+    for (uint32 i = 0; i < 3u; i++)
+    {
+        HOST_CHECK_EQ(tims[i]->ARR, TEST_ARR);
+        HOST_CHECK_EQ(tims[i]->CR1 & TIM_CR1_CMS, TIM_CounterMode_CenterAligned1);
+        // CCR = duty * ARR (center-aligned: CCR = ARR là 100%)
+        HOST_CHECK_EQ(tims[i]->CCR1, TEST_ARR / 2u);
+        HOST_CHECK_EQ(Pwm_ChannelRt[i].period, TEST_ARR);
+    }
+
+    // TIM3: 90 độ = 9000 * ARR / 18000 = 1800 tick trễ, bắt đầu ở vị trí 5400 > ARR: đếm xuống từ 1800
+    HOST_CHECK_EQ(TIM3->CNT, 1800u);
+    HOST_CHECK(TIM3->CR1 & TIM_CR1_DIR);
+    // TIM4: 5000 tick trễ, vị trí 2200 <= ARR: đếm lên từ 2200
+    HOST_CHECK_EQ(TIM4->CNT, 2200u);
+    HOST_CHECK_EQ(TIM4->CR1 & TIM_CR1_DIR, 0u);
+    HOST_CHECK_EQ(TIM2->CNT, 0u);
+
+    // Master: TRGO = CEN, MSM; slave: SMS = trigger, TS = ITR1 (TIM2)
+    HOST_CHECK_EQ(TIM2->CR2 & TIM_CR2_MMS, TIM_TRGOSource_Enable);
+    HOST_CHECK(TIM2->SMCR & TIM_MasterSlaveMode_Enable);
+    HOST_CHECK_EQ(TIM3->SMCR & (TIM_SMCR_SMS | TIM_SMCR_TS), TIM_SlaveMode_Trigger | TIM_TS_ITR1);
+    HOST_CHECK_EQ(TIM4->SMCR & (TIM_SMCR_SMS | TIM_SMCR_TS), TIM_SlaveMode_Trigger | TIM_TS_ITR1);
+
+    // Chỉ master được CPU bật; slave chờ TRGO
+    HOST_CHECK(TIM2->CR1 & TIM_CR1_CEN);
+    HOST_CHECK_EQ(TIM3->CR1 & TIM_CR1_CEN, 0u);
+    HOST_CHECK_EQ(TIM4->CR1 & TIM_CR1_CEN, 0u);
+}
+
+static void Test_PhaseRelation(void)
+{
+    Test_CounterType c[3] = {
+        { TIM2->CNT, (uint8)((TIM2->CR1 & TIM_CR1_DIR) != 0u) },
+        { TIM3->CNT, (uint8)((TIM3->CR1 & TIM_CR1_DIR) != 0u) },
+        { TIM4->CNT, (uint8)((TIM4->CR1 & TIM_CR1_DIR) != 0u) }
+    };
+    uint32 bottom[3] = { 0u, 0xFFFFFFFFu, 0xFFFFFFFFu };
+
+    // Master chạm đáy ở tick 0; tìm lần chạm đáy đầu tiên của từng slave
+    for (uint32 tick = 1; tick <= TEST_FULL; tick++)
+    {
+        for (uint32 i = 0; i < 3u; i++)
+        {
+            Test_Tick(&c[i]);
+            if (c[i].cnt == 0u && bottom[i] == 0xFFFFFFFFu) bottom[i] = tick;
+        }
+    }
+
+    for (uint32 i = 1; i < 3u; i++)
+    {
+        HOST_CHECK_EQ(bottom[i], Test_Delay[i]);
+        printf("Timer %u: bottom %u ticks after master (%.2f deg)\n", (unsigned)(i + 2u), (unsigned)bottom[i],
+               360.0 * bottom[i] / TEST_FULL);
+    }
+}
+
+static void Test_NotificationRejected(void)
+{
+    uint32 dier = TIM3->DIER;
+    uint32 iser = HostReg_Peek(HOST_ADDR(NVIC->ISER[0]));
+
+    Pwm_EnableNotification(1, PWM_BOTH_EDGES);
+    HOST_CHECK_EQ(TIM3->DIER, dier);
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(NVIC->ISER[0])), iser);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Pwm_Init(&Test_Config);
+
+    Test_Registers();
+    Test_PhaseRelation();
+    Test_NotificationRejected();
+
+    return HOST_TEST_RESULT("Test_PwmPhase");
+}
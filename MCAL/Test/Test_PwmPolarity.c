@@ -0,0 +1,148 @@
+/***************************************************************************
+ * @file    Test_PwmPolarity.c
+ * @brief   polarity của kênh: CCxP, dừng khẩn cấp, idle và notification
+ * @details TIM2 có đủ bốn tổ hợp polarity/idleState, TIM1 CH1 active low
+ *          có CH1N. Output của kênh là OCref XOR CCxP, với OCref của PWM
+ *          mode 1 là CNT < CCR, hoặc mức force khi OCxM = force
+ *          active/inactive. Kiểm tra:
+ *          - CCxP = 1 đúng với các kênh polarity PWM_LOW,
+ *          - Pwm_SetOutputToIdle và Pwm_EmergencyStop đưa output về đúng
+ *            idleState với cả hai polarity,
+ *          - TIM1 dừng bằng MOE = 0, output về OIS1 = idleState,
+ *          - cạnh lên của kênh active low là sự kiện compare.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_NUM_TIM2   4u
+
+static void Test_Callback(void)
+{
+}
+
+#define TEST_CH(Ch, Pol, Idle) \
+    { .TIMx = TIM2, .CcrAddr = NULL_PTR, .channel = (Ch), .classType = PWM_VARIABLE_PERIOD, \
+      .defaultFrequencyHz = 1000u, .defaultDutyCycle = 0x4000, .polarity = (Pol), .idleState = (Idle), \
+      .notificationEnable = 1, .NotificationCb = Test_Callback }
+
+static const Pwm_ChannelConfigType Test_Channels[] = {
+    TEST_CH(1, PWM_LOW,  PWM_HIGH),
+    TEST_CH(2, PWM_HIGH, PWM_HIGH),
+    TEST_CH(3, PWM_LOW,  PWM_LOW),
+    TEST_CH(4, PWM_HIGH, PWM_LOW),
+    { .TIMx = TIM1, .CcrAddr = NULL_PTR, .channel = 1, .classType = PWM_VARIABLE_PERIOD,
+      .defaultFrequencyHz = 20000u, .defaultDutyCycle = 0x4000, .polarity = PWM_LOW, .idleState = PWM_LOW,
+      .complementary = 1, .nPolarity = PWM_HIGH }
+};
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = sizeof(Test_Channels) / sizeof(Test_Channels[0])
+};
+
+/* CCxP của kênh ch (1..4) */
+static uint32 Test_Ccp(TIM_TypeDef* TIMx, uint8 ch)
+{
+    return (TIMx->CCER >> ((ch - 1u) * 4u + 1u)) & 1u;
+}
+
+/* OCxM của kênh ch (1..4) */
+static uint32 Test_OcMode(TIM_TypeDef* TIMx, uint8 ch)
+{
+    uint32 ccmr = (ch <= 2u) ? TIMx->CCMR1 : TIMx->CCMR2;
+
+    return (ccmr >> (((ch - 1u) & 1u) * 8u)) & 0x70u;
+}
+
+/* Mức output của kênh khi CNT = cnt (1 = cao) */
+static uint32 Test_Output(TIM_TypeDef* TIMx, uint8 ch, uint32 cnt)
+{
+    uint32 mode = Test_OcMode(TIMx, ch);
+    uint32 ccr = (&TIMx->CCR1)[(ch - 1u) * 2u];
+    uint32 ref;
+
+    if (mode == TIM_ForcedAction_Active)        ref = 1u;
+    else if (mode == TIM_ForcedAction_InActive) ref = 0u;
+    else                                        ref = (cnt < ccr) ? 1u : 0u;
+    return ref ^ Test_Ccp(TIMx, ch);
+}
+
+/* Output đứng yên ở idleState trên cả chu kỳ */
+static void Test_AtIdle(void)
+{
+    for (Pwm_ChannelType i = 0; i < TEST_NUM_TIM2; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &Test_Channels[i];
+
+        for (uint32 cnt = 0; cnt <= TIM2->ARR; cnt += TIM2->ARR / 8u)
+        {
+            HOST_CHECK_EQ(Test_Output(TIM2, ch->channel, cnt), ch->idleState == PWM_HIGH);
+        }
+    }
+}
+
+static void Test_Ccer(void)
+{
+    for (Pwm_ChannelType i = 0; i < TEST_NUM_TIM2; i++)
+    {
+        HOST_CHECK_EQ(Test_Ccp(TIM2, Test_Channels[i].channel), Test_Channels[i].polarity == PWM_LOW);
+    }
+    HOST_CHECK(TIM1->CCER & TIM_CCER_CC1P);
+    HOST_CHECK_EQ(TIM1->CCER & TIM_CCER_CC1NP, 0u);
+
+    // Duty 25% của kênh active low: output thấp trong 25% chu kỳ
+    HOST_CHECK_EQ(Test_Output(TIM2, 1, 0u), 0u);
+    HOST_CHECK_EQ(Test_Output(TIM2, 1, TIM2->ARR), 1u);
+}
+
+static void Test_SetOutputToIdle(void)
+{
+    for (Pwm_ChannelType i = 0; i < TEST_NUM_TIM2; i++) Pwm_SetOutputToIdle(i);
+    Test_AtIdle();
+    for (Pwm_ChannelType i = 0; i < TEST_NUM_TIM2; i++) Pwm_SetDutyCycle(i, 0x4000);
+}
+
+static void Test_EmergencyStop(void)
+{
+    Pwm_EmergencyStop();
+    Test_AtIdle();
+
+    // TIM1: MOE = 0, OIS1 = idleState thấp
+    HOST_CHECK_EQ(TIM1->BDTR & TIM_BDTR_MOE, 0u);
+    HOST_CHECK_EQ(TIM1->CR2 & TIM_OCIdleState_Set, 0u);
+
+    HOST_CHECK_EQ(Pwm_EmergencyRearm(), E_OK);
+    HOST_CHECK_EQ(Test_OcMode(TIM2, 1), TIM_OCMode_PWM1);
+}
+
+static void Test_Notification(void)
+{
+    // Kênh 1 active low: cạnh lên khi CNT = CCR (compare), không cần UIE
+    Pwm_EnableNotification(0, PWM_RISING_EDGE);
+    HOST_CHECK(TIM2->DIER & TIM_IT_CC1);
+    HOST_CHECK_EQ(TIM2->DIER & TIM_DIER_UIE, 0u);
+    Pwm_DisableNotification(0);
+
+    // Kênh 2 active high: cạnh lên ở update
+    Pwm_EnableNotification(1, PWM_RISING_EDGE);
+    HOST_CHECK(TIM2->DIER & TIM_DIER_UIE);
+    HOST_CHECK_EQ(TIM2->DIER & TIM_IT_CC2, 0u);
+    Pwm_DisableNotification(1);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Pwm_Init(&Test_Config);
+
+    Test_Ccer();
+    Test_SetOutputToIdle();
+    Test_EmergencyStop();
+    Test_Notification();
+
+    return HOST_TEST_RESULT("Test_PwmPolarity");
+}
@@ -0,0 +1,203 @@
+/***************************************************************************
+ * @file    Test_PwmRamp.c
+ * @brief   Ramp PWM trong ngắt update: so khớp từng bit với bảng kỳ vọng
+ * @details TIM2 1 kHz (ARR + 1 = 36000), ramp 10 ms = 10 sự kiện update.
+ *          Mỗi bước test đặt UIF rồi gọi TIM2_IRQHandler và đọc CCR1.
+ *          Bảng kỳ vọng là giá trị CCR chính xác của Pwm_RampStep /
+ *          Pwm_LutInterp; ngoài ra mỗi bảng được so với đường cong lý
+ *          thuyết (tuyến tính, x^2.2, smoothstep) trong sai số của LUT 33
+ *          điểm để bảng không tự khớp với một lỗi của driver.
+ *          Thêm: hai kênh chạy cùng lúc cho đúng dãy như khi chạy riêng,
+ *          UIE tắt ở bước cuối, và kênh không có CCR (period = 0) bị từ
+ *          chối thay vì chia cho 0. Pwm_SetPeriodAndDuty giữ tỷ lệ duty
+ *          của kênh khác cùng timer và ghi ARR, CCR trong một giao dịch
+ *          (UDIS bật trước lệnh ghi đầu tiên, xóa sau lệnh ghi cuối).
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include <math.h>
+
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_PERIOD         36000u
+#define TEST_STEPS          10u
+
+/* Vector ngắt trong Pwm.c */
+void TIM2_IRQHandler(void);
+
+#define TEST_CH(Ch) \
+    { .TIMx = TIM2, .CcrAddr = NULL_PTR, .channel = (Ch), .classType = PWM_VARIABLE_PERIOD, \
+      .defaultFrequencyHz = 1000u, .defaultDutyCycle = 0, .polarity = PWM_HIGH, .idleState = PWM_LOW }
+
+/* Kênh 2 không có số kênh timer: không có CCR, period = 0 */
+static const Pwm_ChannelConfigType Test_Channels[] = { TEST_CH(1), TEST_CH(2), TEST_CH(0) };
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = sizeof(Test_Channels) / sizeof(Test_Channels[0])
+};
+
+/* CCR sau mỗi sự kiện update, 0 -> 0x8000 trong 10 ms */
+static const uint16 Test_LinearUp[TEST_STEPS] = {
+     3599,  7199, 10799, 14399, 18000, 21599, 25199, 28799, 32399, 36000
+};
+static const uint16 Test_GammaUp[TEST_STEPS] = {
+      230,  1051,  2554,  4801,  7835, 11705, 16434, 22044, 28557, 36000
+};
+static const uint16 Test_EaseUp[TEST_STEPS] = {
+     1020,  3758,  7784, 12674, 18000, 23322, 28212, 32240, 34978, 36000
+};
+
+/* Gamma 0x8000 -> 0x1000 trong 8 ms */
+static const uint16 Test_GammaDown[8] = {
+    30229, 24990, 20299, 16130, 12479,  9332,  6673,  4500
+};
+
+static void Test_Update(void)
+{
+    HostReg_Poke(HOST_ADDR(TIM2->SR), TIM_SR_UIF);
+    TIM2_IRQHandler();
+}
+
+/* Chạy ramp trên kênh ch và so từng bước với bảng */
+static void Test_Ramp(Pwm_ChannelType ch, uint16 from, uint16 to, uint16 ms, Pwm_RampCurveType curve,
+                      const uint16 *expected, uint32 steps)
+{
+    volatile uint16 *ccr = Pwm_ChannelRt[ch].ccr;
+
+    Pwm_SetDutyCycleFast(ch, from);
+    HOST_CHECK_EQ(Pwm_StartRamp(ch, to, ms, curve), E_OK);
+    for (uint32 k = 0; k < steps; k++)
+    {
+        HOST_CHECK_EQ(Pwm_IsRampActive(ch), 1u);
+        Test_Update();
+        HOST_CHECK_EQ(*ccr, expected[k]);
+    }
+    HOST_CHECK_EQ(Pwm_IsRampActive(ch), 0u);
+}
+
+/* Bảng so với đường cong lý thuyết f(k / steps), sai số tối đa tol (phần của period) */
+static void Test_Shape(const uint16 *table, uint32 steps, double (*f)(double), double tol)
+{
+    for (uint32 k = 1; k <= steps; k++)
+    {
+        double ideal = f((double)k / steps) * TEST_PERIOD;
+
+        HOST_CHECK(fabs((double)table[k - 1u] - ideal) <= tol * TEST_PERIOD);
+    }
+}
+
+static double Test_Linear(double x) { return x; }
+static double Test_Gamma(double x)  { return pow(x, 2.2); }
+static double Test_Ease(double x)   { return x * x * (3.0 - 2.0 * x); }
+
+static void Test_Curves(void)
+{
+    Test_Shape(Test_LinearUp, TEST_STEPS, Test_Linear, 0.0005);
+    Test_Shape(Test_GammaUp, TEST_STEPS, Test_Gamma, 0.005);
+    Test_Shape(Test_EaseUp, TEST_STEPS, Test_Ease, 0.005);
+
+    Test_Ramp(0, 0, 0x8000, 10, PWM_RAMP_LINEAR, Test_LinearUp, TEST_STEPS);
+    Test_Ramp(0, 0, 0x8000, 10, PWM_RAMP_GAMMA, Test_GammaUp, TEST_STEPS);
+    Test_Ramp(0, 0, 0x8000, 10, PWM_RAMP_EASE_IN_OUT, Test_EaseUp, TEST_STEPS);
+    Test_Ramp(0, 0x8000, 0x1000, 8, PWM_RAMP_GAMMA, Test_GammaDown, 8u);
+
+    // Bước cuối tắt UIE luôn vì timer không còn kênh nào cần
+    HOST_CHECK_EQ(TIM2->DIER & TIM_DIER_UIE, 0u);
+
+    // Thời gian 0: đặt ngay, không ramp
+    HOST_CHECK_EQ(Pwm_StartRamp(0, 0x4000, 0, PWM_RAMP_GAMMA), E_OK);
+    HOST_CHECK_EQ(Pwm_IsRampActive(0), 0u);
+    HOST_CHECK_EQ(TIM2->CCR1, TEST_PERIOD / 2u);
+}
+
+static void Test_TwoChannels(void)
+{
+    Pwm_SetDutyCycleFast(0, 0);
+    Pwm_SetDutyCycleFast(1, 0);
+    HOST_CHECK_EQ(Pwm_StartRamp(0, 0x8000, 10, PWM_RAMP_LINEAR), E_OK);
+    HOST_CHECK_EQ(Pwm_StartRamp(1, 0x8000, 10, PWM_RAMP_GAMMA), E_OK);
+    for (uint32 k = 0; k < TEST_STEPS; k++)
+    {
+        Test_Update();
+        HOST_CHECK_EQ(TIM2->CCR1, Test_LinearUp[k]);
+        HOST_CHECK_EQ(TIM2->CCR2, Test_GammaUp[k]);
+    }
+    HOST_CHECK_EQ(Pwm_IsRampActive(0) | Pwm_IsRampActive(1), 0u);
+}
+
+static void Test_NoCcr(void)
+{
+    HOST_CHECK_EQ(Pwm_ChannelRt[2].period, 0u);
+    HOST_CHECK_EQ(Pwm_StartRamp(2, 0x4000, 10, PWM_RAMP_LINEAR), E_NOT_OK);
+
+    // Đổi tần số TIM2 sang 500 Hz (PSC = 2, ARR + 1 = 48000): kênh không có CCR
+    // bị bỏ qua, kênh 0 giữ tỷ lệ duty
+    Pwm_SetDutyCycleFast(0, 0x4000);
+    HOST_CHECK_EQ(Pwm_SetFrequency(0, 500u), E_OK);
+    HOST_CHECK_EQ(Pwm_ChannelRt[0].period, 48000u);
+    HOST_CHECK_EQ(Pwm_ChannelRt[2].period, 0u);
+    HOST_CHECK_EQ(TIM2->CCR1, 24000u);
+}
+
+/* Vị trí lệnh ghi đầu tiên (First = 1) hoặc cuối cùng vào [addr, addr + size) */
+static uint32 Test_WriteAt(uint32 addr, uint32 size, uint8 First)
+{
+    uint32 at = 0xFFFFFFFFu;
+
+    for (uint32 i = 0; i < HostReg_LogLength(); i++)
+    {
+        const HostReg_AccessType* a = HostReg_LogAt(i);
+
+        if (!a->write || a->addr < addr || a->addr >= addr + size) continue;
+        at = i;
+        if (First) break;
+    }
+    return at;
+}
+
+static void Test_PeriodAndDuty(void)
+{
+    uint32 begin, commit;
+
+    // TIM2 đang 500 Hz, ARR + 1 = 48000: kênh 0 duty 50%, kênh 1 duty 25%
+    Pwm_SetDutyCycleFast(0, 0x4000);
+    Pwm_SetDutyCycleFast(1, 0x2000);
+    HOST_CHECK_EQ(TIM2->CCR2, 12000u);
+
+    HostReg_ClearLog();
+    HostReg_Start();
+    Pwm_SetPeriodAndDuty(0, 40000u, 0x6000);
+    HostReg_Stop();
+
+    HOST_CHECK_EQ(TIM2->ARR, 39999u);
+    HOST_CHECK_EQ(TIM2->CCR1, 30000u);
+    HOST_CHECK_EQ(TIM2->CCR2, 10000u);
+    HOST_CHECK_EQ(Pwm_ChannelRt[1].period, 40000u);
+    HOST_CHECK_EQ(Pwm_ChannelRt[2].period, 0u);
+
+    // ARR, CCR1..CCR4 (0x2C .. 0x40) nằm giữa lệnh bật và lệnh xóa UDIS
+    begin = Test_WriteAt(HOST_ADDR(TIM2->CR1), 4u, 1u);
+    commit = Test_WriteAt(HOST_ADDR(TIM2->CR1), 4u, 0u);
+    HOST_CHECK(HostReg_LogAt(begin)->value & TIM_CR1_UDIS);
+    HOST_CHECK_EQ(HostReg_LogAt(commit)->value & TIM_CR1_UDIS, 0u);
+    HOST_CHECK(begin < Test_WriteAt(HOST_ADDR(TIM2->ARR), 0x18u, 1u));
+    HOST_CHECK(commit > Test_WriteAt(HOST_ADDR(TIM2->ARR), 0x18u, 0u));
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Pwm_Init(&Test_Config);
+    HOST_CHECK_EQ(Pwm_ChannelRt[0].period, TEST_PERIOD);
+
+    Test_Curves();
+    Test_TwoChannels();
+    Test_NoCcr();
+    Test_PeriodAndDuty();
+
+    return HOST_TEST_RESULT("Test_PwmRamp");
+}
@@ -0,0 +1,140 @@
+/***************************************************************************
+ * @file    Test_PwmSolver.c
+ * @brief   Bộ giải PSC/ARR Pwm_SolveTimeBase: sai số và độ phân giải
+ * @details Quét tần số 1 Hz .. clock/2 trên clock timer 72 MHz, 36 MHz và
+ *          8 MHz. Với mỗi nghiệm: period trong 2 .. 65535, errorPpm đúng
+ *          bằng sai số tính lại từ PSC/period và không vượt
+ *          PWM_FREQ_MAX_ERROR_PPM, và không có PSC nhỏ hơn nào cho period
+ *          hợp lệ trong sai số (độ phân giải lớn nhất). Không có nghiệm thì
+ *          phải thật sự không có PSC nào đạt sai số. Period lớn nhất cho duty
+ *          0x8000 một giá trị CCR khác 0 (không tràn 16 bit).
+ *          Mọi tần số tới clock / 500 (period >= 500 tick) đều có nghiệm;
+ *          phía trên chỉ các tần số gần clock / n, ví dụ 990 kHz ở 72 MHz
+ *          không có nghiệm trong PWM_FREQ_MAX_ERROR_PPM.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostTest.h"
+
+/* Period (tick) từ đó trở lên mọi tần số đều có nghiệm: sai số làm tròn
+ * period tối đa 1 / (2 * period) */
+#define TEST_ALWAYS_TICKS   (1000000u / (2u * PWM_FREQ_MAX_ERROR_PPM))
+
+/* Sai số (ppm) của PSC + 1 = div, period tick; 0xFFFFFFFF nếu period ngoài 2 .. 65535 */
+static uint32 Test_ErrorPpm(uint32 clk, uint32 hz, uint32 div, uint32 *period)
+{
+    uint64_t den = (uint64_t)div * hz;
+    uint64_t actual, diff;
+
+    *period = (uint32)((clk + den / 2u) / den);
+    if (*period < 2u || *period > 65535u) return 0xFFFFFFFFu;
+    actual = (uint64_t)*period * den;
+    diff = (actual > clk) ? actual - clk : clk - actual;
+    return (uint32)((diff * 1000000u) / actual);
+}
+
+/* Kiểm tra một tần số; trả về 1 nếu có nghiệm */
+static uint8 Test_Solve(uint32 clk, uint32 hz, uint32 *worstPpm, uint32 *minPeriod)
+{
+    Pwm_TimeBaseType tb;
+    Std_ReturnType ret = Pwm_SolveTimeBase(clk, hz, &tb);
+    uint32 period;
+
+    if (ret != E_OK)
+    {
+        // Không nghiệm: mọi PSC đều cho period ngoài khoảng hoặc sai số quá lớn
+        for (uint32 div = 1; div <= 65536u; div++)
+        {
+            if (Test_ErrorPpm(clk, hz, div, &period) <= PWM_FREQ_MAX_ERROR_PPM)
+            {
+                printf("  %u Hz @ %u Hz: solver failed but PSC %u works\n", (unsigned)hz, (unsigned)clk,
+                       (unsigned)(div - 1u));
+                HostTest_Failures++;
+                break;
+            }
+            if (period < 2u) break;
+        }
+        return 0u;
+    }
+
+    HOST_CHECK(tb.period >= 2u && tb.period <= 65535u);
+    HOST_CHECK_EQ(tb.errorPpm, Test_ErrorPpm(clk, hz, tb.prescaler + 1u, &period));
+    HOST_CHECK_EQ(period, tb.period);
+    HOST_CHECK(tb.errorPpm <= PWM_FREQ_MAX_ERROR_PPM);
+
+    // PSC nhỏ hơn: period vượt 65535 hoặc sai số vượt giới hạn
+    for (uint32 div = 1; div <= tb.prescaler; div++)
+    {
+        HOST_CHECK(Test_ErrorPpm(clk, hz, div, &period) > PWM_FREQ_MAX_ERROR_PPM);
+    }
+
+    if (tb.errorPpm > *worstPpm) *worstPpm = tb.errorPpm;
+    if (tb.period < *minPeriod) *minPeriod = tb.period;
+    return 1u;
+}
+
+static void Test_Sweep(uint32 clk)
+{
+    uint32 solved = 0u, tried = 0u, worst = 0u, minPeriod = 0xFFFFFFFFu, firstUnsolved = 0u;
+
+    // 1 .. 2000 Hz từng 1 Hz, sau đó bước tăng ~0.1 % tới clock/2
+    for (uint32 hz = 1u; hz <= clk / 2u; hz = (hz < 2000u) ? hz + 1u : hz + hz / 997u)
+    {
+        uint8 ok = Test_Solve(clk, hz, &worst, &minPeriod);
+
+        if (!ok && firstUnsolved == 0u) firstUnsolved = hz;
+        solved += ok;
+        tried++;
+    }
+    HOST_CHECK(solved > 0u);
+    // Period >= TEST_ALWAYS_TICKS: sai số làm tròn <= 1 / (2 * period) luôn trong giới hạn
+    HOST_CHECK(firstUnsolved > clk / TEST_ALWAYS_TICKS);
+
+    printf("Timer clock %8u Hz: %u/%u frequencies solved, worst error %u ppm, smallest period %u, "
+           "first unsolved %u Hz\n", (unsigned)clk, (unsigned)solved, (unsigned)tried, (unsigned)worst,
+           (unsigned)minPeriod, (unsigned)firstUnsolved);
+}
+
+static void Test_Edges(void)
+{
+    Pwm_TimeBaseType tb;
+    volatile uint16 ccr = 0u;
+
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(72000000u, 0u, &tb), E_NOT_OK);
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(72000000u, 36000001u, &tb), E_NOT_OK);
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(72000000u, 1000u, NULL_PTR), E_NOT_OK);
+    // 72 MHz / 990 kHz = 72.7 tick: period 73 sai 3.7 %, không PSC nào đạt 1000 ppm
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(72000000u, 990000u, &tb), E_NOT_OK);
+
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(72000000u, 36000000u, &tb), E_OK);
+    HOST_CHECK_EQ(tb.prescaler, 0u);
+    HOST_CHECK_EQ(tb.period, 2u);
+
+    // 65.536 MHz / 1 kHz = 65536 tick: phải chia PSC 2 thay vì lấy period 65536
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(65536000u, 1000u, &tb), E_OK);
+    HOST_CHECK_EQ(tb.prescaler, 1u);
+    HOST_CHECK_EQ(tb.period, 32768u);
+    HOST_CHECK_EQ(tb.errorPpm, 0u);
+
+    // Period lớn nhất: duty 100% ghi CCR = period, không tràn về 0
+    HOST_CHECK_EQ(Pwm_SolveTimeBase(65535000u, 1000u, &tb), E_OK);
+    HOST_CHECK_EQ(tb.period, 65535u);
+    Pwm_ChannelRt[0].ccr = &ccr;
+    Pwm_ChannelRt[0].period = tb.period;
+    Pwm_SetDutyCycleFast(0, 0x8000);
+    HOST_CHECK_EQ(ccr, 65535u);
+    Pwm_SetDutyCycleFast(0, 0x4000);
+    HOST_CHECK_EQ(ccr, 32767u);
+}
+
+int main(void)
+{
+    Test_Edges();
+    Test_Sweep(72000000u);
+    Test_Sweep(36000000u);
+    Test_Sweep(8000000u);
+
+    return HOST_TEST_RESULT("Test_PwmSolver");
+}
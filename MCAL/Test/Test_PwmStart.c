@@ -0,0 +1,178 @@
+/***************************************************************************
+ * @file    Test_PwmStart.c
+ * @brief   Pwm_Init: khởi tạo theo timer, thời gian khởi động và độ lệch pha
+ * @details Bốn kênh trên TIM2 và hai kênh trên TIM3. Một hook của mô hình
+ *          thanh ghi cho mỗi timer đang chạy (CEN = 1) đếm thêm một tick
+ *          sau mỗi truy cập bus, xóa CNT khi ghi UG vào EGR, và tăng DWT
+ *          CYCCNT một đơn vị mỗi truy cập. Vì vậy:
+ *          - Pwm_GetInitCycles trả về số truy cập bus của Pwm_Init,
+ *          - hiệu CNT giữa hai timer sau khi khởi động là độ lệch pha tính
+ *            bằng số truy cập bus giữa hai lần bật counter.
+ *          Đơn vị là truy cập bus của mô hình, không phải chu kỳ Cortex-M3.
+ *          Bản tham chiếu làm theo cách cũ (time base và TIM_Cmd cho từng
+ *          kênh) chạy trên cùng mô hình để so sánh.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_CH(Tim, Ch) \
+    { .TIMx = (Tim), .CcrAddr = NULL_PTR, .channel = (Ch), .classType = PWM_VARIABLE_PERIOD, \
+      .defaultFrequencyHz = 1000u, .defaultDutyCycle = 0x4000, .polarity = PWM_HIGH, .idleState = PWM_LOW }
+
+static const Pwm_ChannelConfigType Test_Channels[] = {
+    TEST_CH(TIM2, 1), TEST_CH(TIM2, 2), TEST_CH(TIM3, 1), TEST_CH(TIM2, 3), TEST_CH(TIM2, 4), TEST_CH(TIM3, 2)
+};
+#define TEST_NUM_CHANNELS   (sizeof(Test_Channels) / sizeof(Test_Channels[0]))
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = TEST_NUM_CHANNELS
+};
+
+static TIM_TypeDef* const Test_Timers[] = { TIM1, TIM2, TIM3, TIM4 };
+
+/* Mỗi truy cập bus: các timer đang chạy đếm một tick, CYCCNT tăng một */
+static void Test_TickHook(uint32 addr, uint8 write, uint32 old, uint32 value)
+{
+    (void)old;
+    for (uint32 t = 0; t < sizeof(Test_Timers) / sizeof(Test_Timers[0]); t++)
+    {
+        TIM_TypeDef* TIMx = Test_Timers[t];
+        uint32 arr = HostReg_Peek(HOST_ADDR(TIMx->ARR)) & 0xFFFFu;
+
+        if (write && addr == HOST_ADDR(TIMx->EGR) && (value & TIM_EGR_UG))
+        {
+            HostReg_Poke(HOST_ADDR(TIMx->CNT), 0u);
+        }
+        else if (HostReg_Peek(HOST_ADDR(TIMx->CR1)) & TIM_CR1_CEN)
+        {
+            uint32 cnt = HostReg_Peek(HOST_ADDR(TIMx->CNT)) & 0xFFFFu;
+
+            HostReg_Poke(HOST_ADDR(TIMx->CNT), (cnt >= arr) ? 0u : cnt + 1u);
+        }
+    }
+    HostReg_TickCycleCounter();
+}
+
+/* Số lần CEN của timer chuyển 0 -> 1 trong log */
+static uint32 Test_CounterStarts(TIM_TypeDef* TIMx)
+{
+    uint32 starts = 0u;
+    uint32 cen = 0u;
+
+    for (uint32 i = 0; i < HostReg_LogLength(); i++)
+    {
+        const HostReg_AccessType* a = HostReg_LogAt(i);
+
+        if (!a->write || a->addr != HOST_ADDR(TIMx->CR1)) continue;
+        if ((a->value & TIM_CR1_CEN) && !cen) starts++;
+        cen = a->value & TIM_CR1_CEN;
+    }
+    return starts;
+}
+
+static sint32 Test_Skew(void)
+{
+    return (sint32)(HostReg_Peek(HOST_ADDR(TIM2->CNT)) & 0xFFFFu) -
+           (sint32)(HostReg_Peek(HOST_ADDR(TIM3->CNT)) & 0xFFFFu);
+}
+
+/* Cách cũ: mỗi kênh một lần time base (UG xóa CNT) và một lần TIM_Cmd */
+static void Test_PerChannelInit(void)
+{
+    for (uint32 i = 0; i < TEST_NUM_CHANNELS; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &Test_Channels[i];
+        TIM_TimeBaseInitTypeDef tim = { .TIM_Prescaler = 1, .TIM_CounterMode = TIM_CounterMode_Up,
+                                        .TIM_Period = 35999, .TIM_ClockDivision = TIM_CKD_DIV1 };
+        TIM_OCInitTypeDef oc;
+
+        TIM_TimeBaseInit(ch->TIMx, &tim);
+        TIM_OCStructInit(&oc);
+        oc.TIM_OCMode = TIM_OCMode_PWM1;
+        oc.TIM_OutputState = TIM_OutputState_Enable;
+        oc.TIM_Pulse = 18000;
+        switch (ch->channel)
+        {
+            case 1: TIM_OC1Init(ch->TIMx, &oc); break;
+            case 2: TIM_OC2Init(ch->TIMx, &oc); break;
+            case 3: TIM_OC3Init(ch->TIMx, &oc); break;
+            default: TIM_OC4Init(ch->TIMx, &oc); break;
+        }
+        TIM_Cmd(ch->TIMx, ENABLE);
+    }
+}
+
+static void Test_PerTimerInit(void)
+{
+    uint32 accesses, cycles;
+    sint32 skew;
+
+    HostReg_Reset();
+    HostReg_SetHook(Test_TickHook);
+    HostReg_Start();
+    Pwm_Init(&Test_Config);
+    HostReg_Stop();
+    accesses = HostReg_LogLength();
+    cycles = Pwm_GetInitCycles();
+    skew = Test_Skew();
+
+    // Một time base (PSC, ARR, UG) và một lần bật counter cho mỗi timer
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM2->PSC), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM3->PSC), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM2->EGR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM3->EGR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(Test_CounterStarts(TIM2), 1u);
+    HOST_CHECK_EQ(Test_CounterStarts(TIM3), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*TIM4), (uint32)sizeof(TIM_TypeDef), 2u), 0u);
+
+    // Mọi kênh PWM1, output bật, CCR = 50% của ARR + 1 = 36000
+    HOST_CHECK_EQ(TIM2->CCMR1, 0x6868u);
+    HOST_CHECK_EQ(TIM2->CCMR2, 0x6868u);
+    HOST_CHECK_EQ(TIM3->CCMR1, 0x6868u);
+    HOST_CHECK_EQ(TIM2->CCER & 0x1111u, 0x1111u);
+    HOST_CHECK_EQ(TIM3->CCER & 0x0011u, 0x0011u);
+    HOST_CHECK_EQ(TIM2->ARR, 35999u);
+    HOST_CHECK_EQ(TIM2->CCR3, 18000u);
+    HOST_CHECK_EQ(TIM3->CCR2, 18000u);
+
+    // Hai counter bật bằng hai đọc-sửa-ghi CR1 liền nhau: lệch đúng hai truy cập
+    HOST_CHECK_EQ(skew, 2);
+    // Chỉ kiểm tra phần đo có chạy: CYCCNT do hook tăng nên không đo tốc độ
+    HOST_CHECK(cycles > 0u);
+
+    printf("Pwm_Init (6 channels, 2 timers): %u bus accesses, Pwm_GetInitCycles %u (model: 1 per access), "
+           "TIM2-TIM3 phase skew %d accesses\n", (unsigned)accesses, (unsigned)cycles, (int)skew);
+    Pwm_DeInit();
+}
+
+static void Test_PerChannelReference(void)
+{
+    sint32 skew;
+
+    HostReg_Reset();
+    HostReg_SetHook(Test_TickHook);
+    HostReg_Start();
+    Test_PerChannelInit();
+    HostReg_Stop();
+    skew = Test_Skew();
+
+    HOST_CHECK_EQ(Test_CounterStarts(TIM2), 1u);
+    HOST_CHECK(skew > 2);
+    printf("Per-channel reference: %u bus accesses, %u TIM2 time-base resets, TIM2-TIM3 phase skew %d accesses\n",
+           (unsigned)HostReg_LogLength(), (unsigned)HostReg_Count(HOST_ADDR(TIM2->EGR), 4u, 1u), (int)skew);
+}
+
+int main(void)
+{
+    HostReg_Init();
+
+    Test_PerTimerInit();
+    Test_PerChannelReference();
+
+    return HOST_TEST_RESULT("Test_PwmStart");
+}
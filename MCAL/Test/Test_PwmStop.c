@@ -0,0 +1,208 @@
+/***************************************************************************
+ * @file    Test_PwmStop.c
+ * @brief   Độ trễ dừng khẩn cấp: Pwm_EmergencyStop và break BKIN của TIM1
+ * @details Bốn timer đều có kênh (TIM1 CH1 + CH1N, TIM2..TIM4), build -O2.
+ *          Đường phần mềm Pwm_EmergencyStop đo bằng:
+ *          - số truy cập bus trên mô hình thanh ghi, và vị trí lệnh ghi làm
+ *            output cuối cùng về idle (độ trễ tính bằng truy cập bus),
+ *          - Pwm_GetEmergencyStopCycles với hook tăng DWT CYCCNT một đơn vị
+ *            mỗi truy cập bus,
+ *          - số lệnh máy x86-64 đếm bằng single-step.
+ *          So với đường cũ Pwm_SetOutputToIdle: CCR qua preload nên output
+ *          chỉ đổi ở sự kiện update kế tiếp, trễ tới một chu kỳ PWM.
+ *          Đường BKIN: build với PWM_BREAK_INPUT = STD_ON và polarity
+ *          cao, BDTR phải có BKE và BKP sau Pwm_Init, sau
+ *          Pwm_EmergencyStop và sau Pwm_EmergencyRearm. Test giả lập phần
+ *          cứng xóa MOE khi chân tích cực, rồi đo Pwm_EmergencyRearm khi
+ *          chân còn và hết tích cực. Không có số đo trên Cortex-M3: độ trễ
+ *          thật của BKIN là độ trễ lan truyền trong timer (RM0008: bất đồng
+ *          bộ, không cần clock), của Pwm_EmergencyStop là
+ *          Pwm_GetEmergencyStopCycles chạy trên chip.
+ * @version 1.0
+ * @date    2025-06-18
+ ***************************************************************************/
+#include "Pwm.h"
+#include "Pwm_cfg.h"
+#include "HostReg.h"
+#include "HostTest.h"
+
+#define TEST_CH(Tim, Ch, Idle) \
+    { .TIMx = (Tim), .CcrAddr = NULL_PTR, .channel = (Ch), .classType = PWM_VARIABLE_PERIOD, \
+      .defaultFrequencyHz = 1000u, .defaultDutyCycle = 0x4000, .polarity = PWM_HIGH, .idleState = (Idle) }
+
+static const Pwm_ChannelConfigType Test_Channels[] = {
+    { .TIMx = TIM1, .CcrAddr = NULL_PTR, .channel = 1, .classType = PWM_VARIABLE_PERIOD,
+      .defaultFrequencyHz = 1000u, .defaultDutyCycle = 0x4000, .polarity = PWM_HIGH, .idleState = PWM_LOW,
+      .complementary = 1, .nPolarity = PWM_HIGH },
+    TEST_CH(TIM2, 1, PWM_LOW),
+    TEST_CH(TIM2, 2, PWM_HIGH),
+    TEST_CH(TIM3, 3, PWM_LOW),
+    TEST_CH(TIM4, 4, PWM_HIGH)
+};
+#define TEST_NUM_CHANNELS   (sizeof(Test_Channels) / sizeof(Test_Channels[0]))
+
+static const Pwm_ConfigType Test_Config = {
+    .Channels    = Test_Channels,
+    .NumChannels = TEST_NUM_CHANNELS
+};
+
+/* Chân BKIN đang tích cực: phần cứng giữ MOE = 0 */
+static uint8 Test_BreakActive = 0u;
+
+static void Test_Hook(uint32 addr, uint8 write, uint32 old, uint32 value)
+{
+    (void)old;
+    if (write && addr == HOST_ADDR(TIM1->BDTR) && Test_BreakActive)
+    {
+        HostReg_Poke(HOST_ADDR(TIM1->BDTR), value & ~TIM_BDTR_MOE);
+    }
+    HostReg_TickCycleCounter();
+}
+
+/* OCxM của kênh ch (1..4) */
+static uint32 Test_OcMode(TIM_TypeDef* TIMx, uint8 ch)
+{
+    uint32 ccmr = HostReg_Peek((ch <= 2u) ? HOST_ADDR(TIMx->CCMR1) : HOST_ADDR(TIMx->CCMR2));
+
+    return (ccmr >> (((ch - 1u) & 1u) * 8u)) & 0x70u;
+}
+
+/* Mọi output đứng yên ở idleState (CCxP = 0 nên mức output = OCref) */
+static void Test_AllIdle(void)
+{
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(TIM1->BDTR)) & TIM_BDTR_MOE, 0u);
+    for (uint32 i = 1; i < TEST_NUM_CHANNELS; i++)
+    {
+        const Pwm_ChannelConfigType* ch = &Test_Channels[i];
+
+        HOST_CHECK_EQ(Test_OcMode(ch->TIMx, ch->channel),
+                      (ch->idleState == PWM_HIGH) ? TIM_ForcedAction_Active : TIM_ForcedAction_InActive);
+    }
+}
+
+/* Vị trí (1..) của lệnh ghi thanh ghi timer cuối cùng trong log */
+static uint32 Test_LastTimerWrite(void)
+{
+    uint32 last = 0u;
+
+    for (uint32 i = 0; i < HostReg_LogLength(); i++)
+    {
+        const HostReg_AccessType* a = HostReg_LogAt(i);
+
+        if (a->write && a->addr >= HOST_ADDR(*TIM2) && a->addr < HOST_ADDR(*TIM1) + sizeof(TIM_TypeDef)) last = i + 1u;
+    }
+    return last;
+}
+
+static void Test_SoftwareStop(void)
+{
+    uint32 accesses, last, cycles, insn;
+
+    HostReg_ClearLog();
+    HostReg_SetHook(Test_Hook);
+    HostReg_Start();
+    Pwm_EmergencyStop();
+    HostReg_Stop();
+    HostReg_SetHook(NULL_PTR);
+    accesses = HostReg_LogLength();
+    last = Test_LastTimerWrite();
+    cycles = Pwm_GetEmergencyStopCycles();
+    Test_AllIdle();
+
+    // 1 BDTR + 3 x (CCMR1, CCMR2), không đọc thanh ghi timer nào
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(TIM1->BDTR), 4u, 1u), 1u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*TIM2), 3u * 0x400u, 1u), 6u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*TIM2), 3u * 0x400u, 0u), 0u);
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*TIM1), (uint32)sizeof(TIM_TypeDef), 0u), 0u);
+    // TIM1 dừng ở lệnh ghi đầu tiên sau lần đọc CYCCNT
+    HOST_CHECK_EQ(HostReg_LogAt(1)->addr, HOST_ADDR(TIM1->BDTR));
+    // Chỉ kiểm tra phần đo có chạy: CYCCNT do hook tăng nên không đo tốc độ
+    HOST_CHECK(cycles > 0u);
+
+    HOST_CHECK_EQ(Pwm_EmergencyRearm(), E_OK);
+    insn = HostReg_CountInstructions(Pwm_EmergencyStop);
+    HOST_CHECK_EQ(Pwm_EmergencyRearm(), E_OK);
+
+    printf("Pwm_EmergencyStop (4 timers): %u bus accesses (7 register stores), TIM1 idle after access 2, "
+           "last output idle after access %u, Pwm_GetEmergencyStopCycles %u (model: 1 per access), "
+           "%u host x86-64 instructions\n", (unsigned)accesses, (unsigned)last, (unsigned)cycles, (unsigned)insn);
+}
+
+/* Đường cũ: CCR về 0%/100% qua preload, chỉ có hiệu lực ở update kế tiếp */
+static void Test_SetOutputToIdleReference(void)
+{
+    uint32 period = Pwm_ChannelRt[1].period;
+
+    HostReg_ClearLog();
+    HostReg_Start();
+    for (Pwm_ChannelType ch = 0; ch < TEST_NUM_CHANNELS; ch++) Pwm_SetOutputToIdle(ch);
+    HostReg_Stop();
+
+    // Output vẫn chạy PWM cho tới update: trễ tới ARR + 1 tick timer
+    HOST_CHECK_EQ(Test_OcMode(TIM2, 1), TIM_OCMode_PWM1);
+    HOST_CHECK(TIM2->CCMR1 & 0x0008u);
+    printf("Pwm_SetOutputToIdle x %u: %u bus accesses, outputs idle only at the next update: up to %u timer "
+           "ticks (%u us at %u Hz)\n", (unsigned)TEST_NUM_CHANNELS, (unsigned)HostReg_LogLength(), (unsigned)period,
+           (unsigned)(1000000u / Test_Channels[1].defaultFrequencyHz), (unsigned)Test_Channels[1].defaultFrequencyHz);
+    for (Pwm_ChannelType ch = 0; ch < TEST_NUM_CHANNELS; ch++) Pwm_SetDutyCycle(ch, 0x4000);
+}
+
+/* Break bật với polarity của cấu hình: BKE và BKP có trong BDTR */
+static void Test_BreakEnabled(void)
+{
+    HOST_CHECK_EQ(HostReg_Peek(HOST_ADDR(TIM1->BDTR)) & (TIM_BDTR_BKE | TIM_BDTR_BKP),
+                  TIM_BDTR_BKE | PWM_BREAK_POLARITY);
+}
+
+static void Test_BreakInput(void)
+{
+    uint32 rearm;
+
+    HOST_CHECK_EQ(PWM_BREAK_INPUT, STD_ON);
+    HOST_CHECK_EQ(PWM_BREAK_POLARITY, TIM_BDTR_BKP);
+    Test_BreakEnabled();
+
+    // Giả lập phần cứng: BKIN tích cực xóa MOE và đặt BIF
+    Test_BreakActive = 1u;
+    HostReg_Poke(HOST_ADDR(TIM1->BDTR), HostReg_Peek(HOST_ADDR(TIM1->BDTR)) & ~TIM_BDTR_MOE);
+    HostReg_Poke(HOST_ADDR(TIM1->SR), HostReg_Peek(HOST_ADDR(TIM1->SR)) | TIM_SR_BIF);
+
+    // Chân còn tích cực: không chạy lại được, break vẫn bật, TIM2..TIM4 không bị động tới
+    HostReg_ClearLog();
+    HostReg_SetHook(Test_Hook);
+    HostReg_Start();
+    HOST_CHECK_EQ(Pwm_EmergencyRearm(), E_NOT_OK);
+    HostReg_Stop();
+    HOST_CHECK_EQ(TIM1->BDTR & TIM_BDTR_MOE, 0u);
+    Test_BreakEnabled();
+    HOST_CHECK_EQ(HostReg_Count(HOST_ADDR(*TIM2), 3u * 0x400u, 1u), 0u);
+
+    // Hết break: dừng phần mềm vẫn giữ break, một lần Rearm chạy lại mọi output
+    Test_BreakActive = 0u;
+    Pwm_EmergencyStop();
+    Test_BreakEnabled();
+    HostReg_ClearLog();
+    HostReg_Start();
+    HOST_CHECK_EQ(Pwm_EmergencyRearm(), E_OK);
+    HostReg_Stop();
+    HostReg_SetHook(NULL_PTR);
+    rearm = HostReg_LogLength();
+    HOST_CHECK(TIM1->BDTR & TIM_BDTR_MOE);
+    Test_BreakEnabled();
+    HOST_CHECK_EQ(Test_OcMode(TIM4, 4), TIM_OCMode_PWM1);
+
+    printf("BKIN break (BKE, BKP high): Pwm_EmergencyRearm %u bus accesses\n", (unsigned)rearm);
+}
+
+int main(void)
+{
+    HostReg_Init();
+    Pwm_Init(&Test_Config);
+    Test_BreakEnabled();
+
+    Test_SoftwareStop();
+    Test_SetOutputToIdleReference();
+    Test_BreakInput();
+
+    return HOST_TEST_RESULT("Test_PwmStop");
+}
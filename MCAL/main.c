@@ -2,14 +2,9 @@
 #include "Port.h"
 #include "Det.h"
 #include "Port_Cfg.h"
-#include "timer.h"
 #include "Pwm.h"
 #include "Pwm_cfg.h"
-// Tạo cấu hình Port tổng thể
-const Port_ConfigType Port_Config = {
-    .PinCfgType = PortCfg_Pins,
-    .PortCfg_PinsCount = sizeof(PortCfg_Pins) / sizeof(PortCfg_Pins[0])
-};
+#include "Clock.h"
 
 const Pwm_ConfigType PwmDriverConfig  = {
     .Channels    = pwmChannelscfg,
@@ -17,32 +12,19 @@ const Pwm_ConfigType PwmDriverConfig  = {
 };
 int main(void)
 {
-    Port_Init(&Port_Config);  // Khởi tạo tất cả chân theo cấu hình
+    Port_Init(&Port_ConfigSets[PORT_CONFIG_SET_DEFAULT]);  // Khởi tạo tất cả chân theo bộ cấu hình mặc định
     Pwm_Init(&PwmDriverConfig);
-    Delay_Init();        // Khởi tạo timer delay
-    uint16_t dutyQ15 = 0;    // Bắt đầu từ 0% duty
-    uint8_t dir = 1;         // Hướng tăng duty
-    Pwm_SetDutyCycle(1,dutyQ15);
-    // Pwm_SetDutyCycle(0, dutyQ15);
+    Clock_GateUnused(CLOCK_MASK_GPIO);  // Tắt clock các port GPIO không driver nào dùng
+    uint8_t dir = 0;         // Hướng fade: 1 = sáng dần
+    Pwm_SetDutyCycle(1, 0);  // Bắt đầu từ 0% duty
+    // Pwm_SetDutyCycle(0, 0);
     while (1)
     {
-        Delay_ms(10);  // Delay mượt sáng/tối
-
-        if (dir)
-        {
-            dutyQ15 += 512;  // Tăng dần (~1.5%)
-            if (dutyQ15 >= 32767) {
-                dutyQ15 = 32767;
-                dir = 0;
-            }
-        }
-        else
+        // Fade chạy trong ngắt update của timer, CPU rảnh cho việc khác
+        if (!Pwm_IsRampActive(1))
         {
-            if (dutyQ15 >= 512) dutyQ15 -= 512;
-            else {
-                dutyQ15 = 0;
-                dir = 1;
-            }
+            dir ^= 1;
+            Pwm_StartRamp(1, dir ? 0x8000 : 0, 640, PWM_RAMP_GAMMA);  // ~640 ms mỗi chiều
         }
     }
 